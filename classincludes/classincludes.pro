@@ -97,6 +97,7 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtLegend \
         QwtLegendData \
         QwtLegendLabel \
+        QwtVirtualLegend \
         QwtPointMapper \
         QwtMatrixRasterData \
         QwtOHLCSample \
@@ -108,6 +109,7 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotCurve \
         QwtPlotDict \
         QwtPlotDirectPainter \
+        QwtPlotEventMarker \
         QwtPlotGraphicItem \
         QwtPlotGrid \
         QwtPlotHistogram \
@@ -122,7 +124,9 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotPicker \
         QwtPlotRasterItem \
         QwtPlotRenderer \
+        QwtPlotSnapshot \
         QwtPlotRescaler \
+        QwtReplotScheduler \
         QwtPlotScaleItem \
         QwtPlotSeriesItem \
         QwtPlotShapeItem \
@@ -147,12 +151,26 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtSyntheticPointData \
         QwtPointArrayData \
         QwtTradingChartData \
+        QwtIntervalArrayData \
+        QwtOHLCArrayData \
         QwtVectorFieldSymbol \
         QwtVectorFieldArrow \
         QwtVectorFieldThinArrow \
         QwtVectorFieldData \
         QwtVectorFieldSample \
-        QwtCPointerData
+        QwtCPointerData \
+        QwtMappedFile \
+        QwtMappedPointData \
+        QwtMappedRasterData \
+        QwtHistogramData
+
+        greaterThan(QT_MAJOR_VERSION, 4) {
+
+            CLASSHEADERS += \
+                QwtSharedRingBuffer \
+                QwtSharedPointData \
+                QwtSharedRasterData
+        }
 
         contains(QWT_CONFIG, QwtPolar) {
 
@@ -217,6 +217,167 @@ class QwtPolygonClipper
     const Rect m_clipRect;
 };
 
+class QwtPolylineClipper
+{
+  public:
+    explicit QwtPolylineClipper( const QRectF& clipRect )
+        : m_xMin( clipRect.x() )
+        , m_xMax( clipRect.x() + clipRect.width() )
+        , m_yMin( clipRect.y() )
+        , m_yMax( clipRect.y() + clipRect.height() )
+    {
+    }
+
+    void clipPolyline( const QPointF* points, int pointCount,
+        QPolygonF& clippedPoints, QVector< int >& runSizes ) const
+    {
+        clippedPoints.clear();
+        runSizes.clear();
+
+        if ( pointCount <= 0 )
+            return;
+
+        if ( pointCount == 1 )
+        {
+            if ( isInside( points[0] ) )
+            {
+                clippedPoints += points[0];
+                runSizes += 1;
+            }
+
+            return;
+        }
+
+        int runStart = -1;
+        bool isInside1 = isInside( points[0] );
+
+        for ( int i = 1; i < pointCount; i++ )
+        {
+            const QPointF& p1 = points[i - 1];
+            const QPointF& p2 = points[i];
+
+            const bool isInside2 = isInside( p2 );
+
+            if ( isInside1 && isInside2 )
+            {
+                if ( runStart < 0 )
+                {
+                    runStart = clippedPoints.size();
+                    clippedPoints += p1;
+                }
+
+                clippedPoints += p2;
+            }
+            else
+            {
+                double t1, t2;
+                if ( clipLine( p1, p2, t1, t2 ) )
+                {
+                    // points inside are passed unmodified
+
+                    if ( runStart < 0 || t1 > 0.0 )
+                    {
+                        closeRun( runStart, clippedPoints, runSizes );
+
+                        runStart = clippedPoints.size();
+                        clippedPoints += ( t1 > 0.0 ) ? pointAt( p1, p2, t1 ) : p1;
+                    }
+
+                    if ( t2 < 1.0 )
+                    {
+                        clippedPoints += pointAt( p1, p2, t2 );
+                        closeRun( runStart, clippedPoints, runSizes );
+                    }
+                    else
+                    {
+                        clippedPoints += p2;
+                    }
+                }
+                else
+                {
+                    closeRun( runStart, clippedPoints, runSizes );
+                }
+            }
+
+            isInside1 = isInside2;
+        }
+
+        closeRun( runStart, clippedPoints, runSizes );
+    }
+
+  private:
+    inline bool isInside( const QPointF& pos ) const
+    {
+        return pos.x() >= m_xMin && pos.x() <= m_xMax
+            && pos.y() >= m_yMin && pos.y() <= m_yMax;
+    }
+
+    static inline QPointF pointAt(
+        const QPointF& p1, const QPointF& p2, double t )
+    {
+        return QPointF( p1.x() + t * ( p2.x() - p1.x() ),
+            p1.y() + t * ( p2.y() - p1.y() ) );
+    }
+
+    static inline void closeRun( int& runStart,
+        const QPolygonF& clippedPoints, QVector< int >& runSizes )
+    {
+        if ( runStart >= 0 )
+        {
+            runSizes += clippedPoints.size() - runStart;
+            runStart = -1;
+        }
+    }
+
+    // Liang-Barsky: the visible part of the line is [t1, t2]
+    inline bool clipLine( const QPointF& p1, const QPointF& p2,
+        double& t1, double& t2 ) const
+    {
+        const double dx = p2.x() - p1.x();
+        const double dy = p2.y() - p1.y();
+
+        t1 = 0.0;
+        t2 = 1.0;
+
+        return clipT( -dx, p1.x() - m_xMin, t1, t2 )
+            && clipT( dx, m_xMax - p1.x(), t1, t2 )
+            && clipT( -dy, p1.y() - m_yMin, t1, t2 )
+            && clipT( dy, m_yMax - p1.y(), t1, t2 );
+    }
+
+    static inline bool clipT( double p, double q, double& t1, double& t2 )
+    {
+        if ( p == 0.0 )
+            return q >= 0.0;
+
+        const double r = q / p;
+
+        if ( p < 0.0 )
+        {
+            if ( r > t2 )
+                return false;
+
+            if ( r > t1 )
+                t1 = r;
+        }
+        else
+        {
+            if ( r < t1 )
+                return false;
+
+            if ( r < t2 )
+                t2 = r;
+        }
+
+        return true;
+    }
+
+    const double m_xMin;
+    const double m_xMax;
+    const double m_yMin;
+    const double m_yMax;
+};
+
 class QwtCircleClipper
 {
   public:
@@ -461,6 +622,36 @@ QPolygonF QwtClipper::clippedPolygonF(
     return points;
 }
 
+/*!
+   \brief Clip an open polyline
+
+   In opposite to clipPolygonF() the parts outside of the clip rectangle
+   are not replaced by lines along its border. Instead the polyline is
+   split into runs of visible points, that need to be painted
+   as separate polylines.
+
+   The points are iterated only once, clipping each line with
+   the Liang-Barsky algorithm. Points inside of the clip rectangle
+   are passed unmodified.
+
+   \param clipRect Clip rectangle
+   \param points Points of the polyline
+   \param pointCount Number of points
+   \param clippedPoints Points of all runs
+   \param runSizes Number of points of each run
+
+   \note clippedPoints and runSizes are cleared before. When being reused
+         for clipping several polylines, they keep their capacity
+         with Qt >= 5.7.
+ */
+void QwtClipper::clipPolylineF( const QRectF& clipRect,
+    const QPointF* points, int pointCount,
+    QPolygonF& clippedPoints, QVector< int >& runSizes )
+{
+    QwtPolylineClipper clipper( clipRect );
+    clipper.clipPolyline( points, pointCount, clippedPoints, runSizes );
+}
+
 /*!
    Circle clipping
 
@@ -47,6 +47,10 @@ namespace QwtClipper
     QWT_EXPORT QPolygonF clippedPolygonF( const QRectF&,
         const QPolygonF&, bool closePolygon = false );
 
+    QWT_EXPORT void clipPolylineF( const QRectF&,
+        const QPointF* points, int pointCount,
+        QPolygonF& clippedPoints, QVector< int >& runSizes );
+
     QWT_EXPORT QVector< QwtInterval > clipCircle(
         const QRectF&, const QPointF&, double radius );
 };
@@ -13,6 +13,7 @@
 
 #include <qpainter.h>
 #include <qpalette.h>
+#include <qvector.h>
 
 static void qwtDrawBox( QPainter* p, const QRectF& rect,
     const QPalette& pal, double lw )
@@ -108,6 +109,78 @@ static void qwtDrawPanel( QPainter* painter, const QRectF& rect,
     painter->fillRect( rect.adjusted( lw, lw, -lw + 1, -lw + 1 ), pal.window() );
 }
 
+namespace
+{
+    /*
+        Rectangles of the columns, that can be painted
+        by one QPainter::drawRects() for each brush
+     */
+    class ColumnBatch
+    {
+      public:
+        void appendFrame( const QRectF& rect )
+        {
+            frameRects += rect;
+        }
+
+        void appendWindow( const QRectF& rect, bool merge )
+        {
+            append( windowRects, rect, merge );
+        }
+
+        void appendLine( const QRectF& rect )
+        {
+            append( lineRects, rect, true );
+        }
+
+        void draw( QPainter* painter, const QBrush& frameBrush,
+            const QBrush& windowBrush, const QBrush& lineBrush ) const
+        {
+            painter->setPen( Qt::NoPen );
+
+            drawRects( painter, frameRects, frameBrush );
+            drawRects( painter, windowRects, windowBrush );
+            drawRects( painter, lineRects, lineBrush );
+        }
+
+      private:
+        static inline void append( QVector< QRectF >& rects,
+            const QRectF& rect, bool merge )
+        {
+            if ( merge && !rects.isEmpty() )
+            {
+                // columns of the same pixel row/column, that overlap
+                QRectF& last = rects.last();
+
+                if ( ( last.left() == rect.left() && last.right() == rect.right()
+                        && rect.top() <= last.bottom() && rect.bottom() >= last.top() )
+                    || ( last.top() == rect.top() && last.bottom() == rect.bottom()
+                        && rect.left() <= last.right() && rect.right() >= last.left() ) )
+                {
+                    last = last.united( rect );
+                    return;
+                }
+            }
+
+            rects += rect;
+        }
+
+        static inline void drawRects( QPainter* painter,
+            const QVector< QRectF >& rects, const QBrush& brush )
+        {
+            if ( !rects.isEmpty() )
+            {
+                painter->setBrush( brush );
+                painter->drawRects( rects );
+            }
+        }
+
+        QVector< QRectF > frameRects;
+        QVector< QRectF > windowRects;
+        QVector< QRectF > lineRects;
+    };
+}
+
 class QwtColumnSymbol::PrivateData
 {
   public:
@@ -144,6 +217,22 @@ QwtColumnSymbol::~QwtColumnSymbol()
     delete m_data;
 }
 
+/*!
+   \brief Create a copy of the symbol, that can be used in another thread
+
+   \return Copy of the symbol, that has to be deleted by the caller
+   \note Subclasses, that reimplement draw(), need to reimplement
+         snapshot() as well.
+   \sa QwtPlotItem::snapshot()
+ */
+QwtColumnSymbol* QwtColumnSymbol::snapshot() const
+{
+    QwtColumnSymbol* symbol = new QwtColumnSymbol();
+    *symbol->m_data = *m_data;
+
+    return symbol;
+}
+
 /*!
    Specify the symbol style
 
@@ -253,6 +342,112 @@ void QwtColumnSymbol::draw( QPainter* painter,
     painter->restore();
 }
 
+/*!
+   \brief Draw a series of columns
+
+   Styles >= UserStyle are painted by calling draw() for each column.
+
+   On paint devices with integer coordinates the columns of the Box style
+   are collected and painted by one QPainter::drawRects() for each brush.
+   Columns, that are reduced to a line, because they are less than
+   a pixel wide, are merged with the overlapping lines of the previous
+   columns. This makes a difference for bar charts with many samples, where
+   most of the bars are painted on top of each other.
+
+   The batched columns are painted in a different order: first the frames,
+   then the contents. For columns, that overlap partially, the result might
+   differ from calling draw() for each column. Raised frames with
+   a lineWidth() > 0 are painted one by one.
+
+   \param painter Painter
+   \param columns Array of columns
+   \param numColumns Number of columns
+
+   \sa draw(), QwtPlotAbstractBarChart::BatchBars
+ */
+void QwtColumnSymbol::drawColumns( QPainter* painter,
+    const QwtColumnRect* columns, int numColumns ) const
+{
+    if ( numColumns <= 0 || m_data->style == QwtColumnSymbol::NoStyle )
+        return;
+
+    if ( m_data->style != QwtColumnSymbol::Box
+        || !QwtPainter::roundingAlignment( painter ) )
+    {
+        for ( int i = 0; i < numColumns; i++ )
+            draw( painter, columns[i] );
+
+        return;
+    }
+
+    const QPalette& pal = m_data->palette;
+
+    const int lw = ( m_data->frameStyle == QwtColumnSymbol::NoFrame )
+        ? 0 : m_data->lineWidth;
+
+    /*
+        A plain frame can be painted as rectangle below the contents,
+        when the contents are not transparent.
+     */
+    const bool batchFrame = ( m_data->frameStyle == QwtColumnSymbol::Plain )
+        && pal.window().isOpaque();
+
+    // the line of a collapsed column, see qwtDrawBox/qwtDrawPanel
+    QBrush lineBrush = pal.window();
+    if ( lw > 0 )
+    {
+        lineBrush = ( m_data->frameStyle == QwtColumnSymbol::Plain )
+            ? QBrush( pal.dark().color() ) : QBrush( pal.window().color() );
+    }
+
+    painter->save();
+
+    ColumnBatch batch;
+
+    for ( int i = 0; i < numColumns; i++ )
+    {
+        const QRectF rect = columns[i].toRect();
+
+        QRectF r;
+        r.setLeft( qRound( rect.left() ) );
+        r.setRight( qRound( rect.right() ) );
+        r.setTop( qRound( rect.top() ) );
+        r.setBottom( qRound( rect.bottom() ) );
+
+        if ( r.width() == 0.0 || r.height() == 0.0 )
+        {
+            batch.appendLine( r.adjusted( 0, 0, 1, 1 ) );
+            continue;
+        }
+
+        if ( lw == 0 )
+        {
+            batch.appendWindow( r.adjusted( 0, 0, 1, 1 ), true );
+            continue;
+        }
+
+        double w = lw;
+        w = qwtMinF( w, r.height() / 2.0 - 1.0 );
+        w = qwtMinF( w, r.width() / 2.0 - 1.0 );
+
+        if ( batchFrame && w >= 0.0 && w == std::floor( w ) )
+        {
+            if ( w > 0.0 )
+                batch.appendFrame( r.adjusted( 0, 0, 1, 1 ) );
+
+            batch.appendWindow( r.adjusted( w, w, -w + 1, -w + 1 ), false );
+        }
+        else
+        {
+            drawBox( painter, columns[i] );
+        }
+    }
+
+    batch.draw( painter, pal.dark(), pal.window(), lineBrush );
+
+    painter->restore();
+}
+
 /*!
    Draw the symbol when it is in Box style.
 
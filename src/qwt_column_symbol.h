@@ -131,6 +131,11 @@ class QWT_EXPORT QwtColumnSymbol
 
     virtual void draw( QPainter*, const QwtColumnRect& ) const;
 
+    void drawColumns( QPainter*,
+        const QwtColumnRect*, int numColumns ) const;
+
+    virtual QwtColumnSymbol* snapshot() const;
+
   protected:
     void drawBox( QPainter*, const QwtColumnRect& ) const;
 
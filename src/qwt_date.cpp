@@ -197,7 +197,7 @@ static inline double qwtToJulianDay( int year, int month, int day )
            - std::floor( ( 3 * y1 ) / 4 ) + day - 32075;
 }
 
-static inline qint64 qwtFloorDiv64( qint64 a, int b )
+static inline qint64 qwtFloorDiv( int a, int b )
 {
     if ( a < 0 )
         a -= b - 1;
@@ -205,7 +205,9 @@ static inline qint64 qwtFloorDiv64( qint64 a, int b )
     return a / b;
 }
 
-static inline qint64 qwtFloorDiv( int a, int b )
+#endif
+
+static inline qint64 qwtFloorDiv64( qint64 a, int b )
 {
     if ( a < 0 )
         a -= b - 1;
@@ -213,7 +215,69 @@ static inline qint64 qwtFloorDiv( int a, int b )
     return a / b;
 }
 
-#endif
+namespace QwtDateCalendar
+{
+    /*
+       Conversions between days since the epoch and the
+       proleptic Gregorian calendar, see:
+       http://howardhinnant.github.io/date_algorithms.html
+     */
+
+    static const double msecsPerDay = 86400000.0;
+
+    // 1583-01-01: below QDate of Qt4 uses the Julian calendar
+    static const qint64 minDay = Q_INT64_C( -141349 );
+
+    static inline qint64 daysFromCivil( qint64 year, int month, int day )
+    {
+        year -= ( month <= 2 ) ? 1 : 0;
+
+        const qint64 era = qwtFloorDiv64( year, 400 );
+        const qint64 yoe = year - era * 400;
+        const qint64 doy = ( 153 * ( month > 2 ? month - 3 : month + 9 ) + 2 ) / 5 + day - 1;
+        const qint64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+        return era * 146097 + doe - 719468;
+    }
+
+    static inline void civilFromDays( qint64 days,
+        qint64& year, int& month, int& day )
+    {
+        days += 719468;
+
+        const qint64 era = qwtFloorDiv64( days, 146097 );
+        const qint64 doe = days - era * 146097;
+        const qint64 yoe = ( doe - doe / 1460 + doe / 36524 - doe / 146096 ) / 365;
+        const qint64 doy = doe - ( 365 * yoe + yoe / 4 - yoe / 100 );
+        const qint64 mp = ( 5 * doy + 2 ) / 153;
+
+        day = static_cast< int >( doy - ( 153 * mp + 2 ) / 5 + 1 );
+        month = static_cast< int >( mp < 10 ? mp + 3 : mp - 9 );
+        year = yoe + era * 400 + ( ( month <= 2 ) ? 1 : 0 );
+    }
+
+    static inline int daysInMonth( qint64 year, int month )
+    {
+        static const int numDays[] =
+            { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+        if ( month == 2 )
+        {
+            const bool isLeap = ( year % 4 == 0 )
+                && ( year % 100 != 0 || year % 400 == 0 );
+
+            return isLeap ? 29 : 28;
+        }
+
+        return numDays[ month - 1 ];
+    }
+
+    // Qt::Monday = 1, ... Qt::Sunday = 7, 1970-01-01 is a Thursday
+    static inline int dayOfWeek( qint64 days )
+    {
+        return static_cast< int >( days + 3 - qwtFloorDiv64( days + 3, 7 ) * 7 ) + 1;
+    }
+}
 
 static inline QDate qwtToDate( int year, int month = 1, int day = 1 )
 {
@@ -484,6 +548,154 @@ QDateTime QwtDate::floor( const QDateTime& dateTime,
     return dt;
 }
 
+/*!
+   Floor a datetime value according the interval type
+
+   The value is floored like floor( const QDateTime&, IntervalType ),
+   but the calculation is done with integer arithmetic on the
+   number of milliseconds - without creating any QDateTime objects.
+
+   \param value Number of milliseconds since the epoch,
+               1970-01-01T00:00:00 UTC
+   \param intervalType Interval type, how to floor
+   \param utcOffset Fixed offset in seconds from UTC, that is applied
+                    before flooring
+
+   \return Floored value in milliseconds since the epoch
+   \sa floor(), addMonths(), toDateTime()
+
+   \note Time specifications with daylight saving time ( Qt::LocalTime )
+         are not supported. Values before 1583 are calculated
+         using QDateTime.
+ */
+double QwtDate::floor( double value,
+    IntervalType intervalType, int utcOffset )
+{
+    using namespace QwtDateCalendar;
+
+    if ( intervalType == QwtDate::Millisecond )
+        return value;
+
+    const double offset = utcOffset * 1000.0;
+    const double v = value + offset;
+
+    const double days = std::floor( v / msecsPerDay );
+    if ( days < minDay )
+    {
+        // QDateTime aligned to the wall clock time
+        const QDateTime dt = QwtDate::floor(
+            toDateTime( v, Qt::UTC ), intervalType );
+
+        return toDouble( dt ) - offset;
+    }
+
+    const double msecs = v - days * msecsPerDay;
+
+    double floored = v;
+
+    switch( intervalType )
+    {
+        case QwtDate::Millisecond:
+        {
+            break;
+        }
+        case QwtDate::Second:
+        {
+            floored = days * msecsPerDay + std::floor( msecs / 1000.0 ) * 1000.0;
+            break;
+        }
+        case QwtDate::Minute:
+        {
+            floored = days * msecsPerDay + std::floor( msecs / 60000.0 ) * 60000.0;
+            break;
+        }
+        case QwtDate::Hour:
+        {
+            floored = days * msecsPerDay + std::floor( msecs / 3600000.0 ) * 3600000.0;
+            break;
+        }
+        case QwtDate::Day:
+        {
+            floored = days * msecsPerDay;
+            break;
+        }
+        case QwtDate::Week:
+        {
+            const qint64 d = static_cast< qint64 >( days );
+
+            int numDays = dayOfWeek( d ) - qwtFirstDayOfWeek();
+            if ( numDays < 0 )
+                numDays += 7;
+
+            floored = ( d - numDays ) * msecsPerDay;
+            break;
+        }
+        case QwtDate::Month:
+        case QwtDate::Year:
+        {
+            qint64 year;
+            int month, day;
+            civilFromDays( static_cast< qint64 >( days ), year, month, day );
+
+            if ( intervalType == QwtDate::Year )
+                month = 1;
+
+            floored = daysFromCivil( year, month, 1 ) * msecsPerDay;
+            break;
+        }
+    }
+
+    return floored - offset;
+}
+
+/*!
+   Add months to a datetime value
+
+   Like QDateTime::addMonths() the day is clipped to the
+   last day of the resulting month.
+
+   \param value Number of milliseconds since the epoch,
+               1970-01-01T00:00:00 UTC
+   \param months Number of months to add, might be negative
+   \param utcOffset Fixed offset in seconds from UTC
+
+   \return value + months in milliseconds since the epoch
+   \sa floor(), QDateTime::addMonths()
+
+   \note Time specifications with daylight saving time ( Qt::LocalTime )
+         are not supported. Values before 1583 are calculated
+         using QDateTime.
+ */
+double QwtDate::addMonths( double value, int months, int utcOffset )
+{
+    using namespace QwtDateCalendar;
+
+    const double offset = utcOffset * 1000.0;
+    const double v = value + offset;
+
+    const double days = std::floor( v / msecsPerDay );
+    const double msecs = v - days * msecsPerDay;
+
+    qint64 year;
+    int month, day;
+    civilFromDays( static_cast< qint64 >( days ), year, month, day );
+
+    const qint64 m = year * 12 + ( month - 1 ) + months;
+
+    year = qwtFloorDiv64( m, 12 );
+    month = static_cast< int >( m - year * 12 ) + 1;
+    day = qMin( day, daysInMonth( year, month ) );
+
+    const qint64 d = daysFromCivil( year, month, day );
+    if ( days < minDay || d < minDay )
+    {
+        const QDateTime dt = toDateTime( v, Qt::UTC ).addMonths( months );
+        return toDouble( dt ) - offset;
+    }
+
+    return d * msecsPerDay + msecs - offset;
+}
+
 /*!
    Minimum for the supported date range
 
@@ -37,6 +37,11 @@
    QwtDate offers several algorithms that are needed to
    calculate these axes.
 
+   For time specifications with a fixed offset from UTC
+   ( Qt::UTC, Qt::OffsetFromUTC ) some of them are also available
+   for double values. Those are implemented with integer arithmetic
+   and avoid the overhead of creating QDateTime objects.
+
    \sa QwtDateScaleEngine, QwtDateScaleDraw, QDate, QTime
  */
 class QWT_EXPORT QwtDate
@@ -116,6 +121,9 @@ class QWT_EXPORT QwtDate
     static QDateTime ceil( const QDateTime&, IntervalType );
     static QDateTime floor( const QDateTime&, IntervalType );
 
+    static double floor( double value, IntervalType, int utcOffset = 0 );
+    static double addMonths( double value, int months, int utcOffset = 0 );
+
     static QDate dateOfWeek0( int year, Week0Type );
     static int weekNumber( const QDate&, Week0Type );
 
@@ -9,6 +9,14 @@
 
 #include "qwt_date_scale_draw.h"
 #include "qwt_text.h"
+#include "qwt_scale_div.h"
+
+#include <qcache.h>
+#include <qpair.h>
+
+#include <cmath>
+
+typedef QPair< QString, qint64 > QwtDateLabelKey;
 
 class QwtDateScaleDraw::PrivateData
 {
@@ -17,6 +25,9 @@ class QwtDateScaleDraw::PrivateData
         : timeSpec( spec )
         , utcOffset( 0 )
         , week0Type( QwtDate::FirstThursday )
+        , hasIntervalType( false )
+        , intervalType( QwtDate::Second )
+        , labelCache( 1000 )
     {
         dateFormats[ QwtDate::Millisecond ] = "hh:mm:ss:zzz\nddd dd MMM yyyy";
         dateFormats[ QwtDate::Second ] = "hh:mm:ss\nddd dd MMM yyyy";
@@ -28,10 +39,28 @@ class QwtDateScaleDraw::PrivateData
         dateFormats[ QwtDate::Year ] = "yyyy";
     }
 
+    void invalidate()
+    {
+        hasIntervalType = false;
+        labelCache.clear();
+    }
+
     Qt::TimeSpec timeSpec;
     int utcOffset;
     QwtDate::Week0Type week0Type;
     QString dateFormats[ QwtDate::Year + 1 ];
+
+    // intervalType() of the last scale division
+    bool hasIntervalType;
+    QwtDate::IntervalType intervalType;
+    QwtScaleDiv intervalTypeDiv;
+
+    /*
+       Labels for a format string and a value in msecs. As the
+       values of the ticks don't change, when scrolling a scale,
+       the cache is not invalidated for new scale divisions.
+     */
+    QCache< QwtDateLabelKey, QString > labelCache;
 };
 
 /*!
@@ -65,6 +94,7 @@ QwtDateScaleDraw::~QwtDateScaleDraw()
 void QwtDateScaleDraw::setTimeSpec( Qt::TimeSpec timeSpec )
 {
     m_data->timeSpec = timeSpec;
+    m_data->invalidate();
 }
 
 /*!
@@ -89,6 +119,7 @@ Qt::TimeSpec QwtDateScaleDraw::timeSpec() const
 void QwtDateScaleDraw::setUtcOffset( int seconds )
 {
     m_data->utcOffset = seconds;
+    m_data->invalidate();
 }
 
 /*!
@@ -115,6 +146,7 @@ int QwtDateScaleDraw::utcOffset() const
 void QwtDateScaleDraw::setWeek0Type( QwtDate::Week0Type week0Type )
 {
     m_data->week0Type = week0Type;
+    m_data->invalidate();
 }
 
 /*!
@@ -141,6 +173,7 @@ void QwtDateScaleDraw::setDateFormat(
         intervalType <= QwtDate::Year )
     {
         m_data->dateFormats[ intervalType ] = format;
+        m_data->invalidate();
     }
 }
 
@@ -197,6 +230,10 @@ QString QwtDateScaleDraw::dateFormatOfDate( const QDateTime& dateTime,
    The value is converted to a datetime value using toDateTime()
    and converted to a plain text using QwtDate::toString().
 
+   The labels are cached for each format string, so that
+   scrolling a scale does not need to format the same
+   values again.
+
    \param value Value
    \return Label string.
 
@@ -204,17 +241,42 @@ QString QwtDateScaleDraw::dateFormatOfDate( const QDateTime& dateTime,
  */
 QwtText QwtDateScaleDraw::label( double value ) const
 {
+    const QwtScaleDiv& div = scaleDiv();
+
+    if ( !m_data->hasIntervalType || !( m_data->intervalTypeDiv == div ) )
+    {
+        // intervalType() iterates over all ticks, but we need
+        // it for each label
+
+        m_data->intervalType = intervalType( div );
+        m_data->intervalTypeDiv = div;
+        m_data->hasIntervalType = true;
+    }
+
     const QDateTime dt = toDateTime( value );
-    const QString fmt = dateFormatOfDate(
-        dt, intervalType( scaleDiv() ) );
+    const QString fmt = dateFormatOfDate( dt, m_data->intervalType );
+
+    // the labels don't show fractions of milliseconds
+    const QwtDateLabelKey key( fmt, static_cast< qint64 >( std::floor( value ) ) );
+
+    const QString* cachedLabel = m_data->labelCache.object( key );
+    if ( cachedLabel )
+        return *cachedLabel;
+
+    const QString text = QwtDate::toString( dt, fmt, m_data->week0Type );
+    m_data->labelCache.insert( key, new QString( text ) );
 
-    return QwtDate::toString( dt, fmt, m_data->week0Type );
+    return text;
 }
 
 /*!
    Find the less detailed datetime unit, where no rounding
    errors happen.
 
+   For Qt::UTC and Qt::OffsetFromUTC the ticks are checked
+   with QwtDate::floor() on the values without creating
+   QDateTime objects.
+
    \param scaleDiv Scale division
    \return Interval type
 
@@ -227,16 +289,32 @@ QwtDate::IntervalType QwtDateScaleDraw::intervalType(
 
     bool alignedToWeeks = true;
 
+    const bool isFixedOffset = ( m_data->timeSpec == Qt::UTC )
+        || ( m_data->timeSpec == Qt::OffsetFromUTC );
+    const int utcOffset = ( m_data->timeSpec == Qt::OffsetFromUTC )
+        ? m_data->utcOffset : 0;
+
     const QList< double > ticks = scaleDiv.ticks( QwtScaleDiv::MajorTick );
     for ( int i = 0; i < ticks.size(); i++ )
     {
-        const QDateTime dt = toDateTime( ticks[i] );
+        const double value = std::floor( ticks[i] );
+
+        QDateTime dt;
+        if ( !isFixedOffset )
+            dt = toDateTime( ticks[i] );
+
         for ( int j = QwtDate::Second; j <= intvType; j++ )
         {
-            const QDateTime dt0 = QwtDate::floor( dt,
-                static_cast< QwtDate::IntervalType >( j ) );
+            const QwtDate::IntervalType type =
+                static_cast< QwtDate::IntervalType >( j );
+
+            bool isAligned;
+            if ( isFixedOffset )
+                isAligned = QwtDate::floor( value, type, utcOffset ) == value;
+            else
+                isAligned = QwtDate::floor( dt, type ) == dt;
 
-            if ( dt0 != dt )
+            if ( !isAligned )
             {
                 if ( j == QwtDate::Week )
                 {
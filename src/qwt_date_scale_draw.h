@@ -43,6 +43,10 @@
    The format strings can be modified using setDateFormat()
    or individually for each tick label by overloading dateFormatOfDate(),
 
+   The formatted labels are cached for each format string. In opposite
+   to the tick label cache of QwtAbstractScaleDraw this cache is not
+   invalidated, when the scale division changes.
+
    Usually QwtDateScaleDraw is used in combination with
    QwtDateScaleEngine, that calculates scales for datetime
    intervals.
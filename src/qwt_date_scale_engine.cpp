@@ -35,6 +35,14 @@ static inline double qwtMsecsForType( int type )
     return msecs[ type ];
 }
 
+static inline bool qwtHasFixedOffset( const QDateTime& dateTime )
+{
+    // Qt::LocalTime and Qt::TimeZone might have daylight saving time
+
+    const Qt::TimeSpec timeSpec = dateTime.timeSpec();
+    return ( timeSpec == Qt::UTC ) || ( timeSpec == Qt::OffsetFromUTC );
+}
+
 static inline int qwtAlignValue(
     double value, double stepSize, bool up )
 {
@@ -483,58 +491,95 @@ static QwtScaleDiv qwtDivideToSeconds(
     QList< double > mediumTicks;
     QList< double > minorTicks;
 
-    for ( QDateTime dt = minDate; dt <= maxDate;
-        dt = dt.addSecs( secondsMajor ) )
+    if ( qwtHasFixedOffset( minDate ) && secondsMajor > 0 )
     {
-        if ( !dt.isValid() )
-            break;
+        // without daylight saving the steps are equidistant:
+        // no need to create QDateTime objects for each tick
+
+        const double min = QwtDate::toDouble( minDate );
+        const double max = QwtDate::toDouble( maxDate );
 
-        double majorValue = QwtDate::toDouble( dt );
+        const int numMinorSteps = ( secondsMinor > 0.0 )
+            ? qwtFloor( secondsMajor / secondsMinor ) : 0;
 
-        if ( daylightSaving )
+        for ( int n = 0; ; n++ )
         {
-            const double offset = utcOffset - QwtDate::utcOffset( dt );
-            majorValue += offset * 1000.0;
+            const double majorValue = min + n * ( secondsMajor * 1000.0 );
+            if ( majorValue > max )
+                break;
 
-            if ( offset > dstOff )
-            {
-                // we add some minor ticks for the DST hour,
-                // otherwise the ticks will be unaligned: 0, 2, 3, 5 ...
-                minorTicks += qwtDstTicks(
-                    dt, secondsMajor, qRound( secondsMinor ) );
-            }
+            majorTicks += majorValue;
 
-            dstOff = offset;
-        }
+            for ( int i = 1; i < numMinorSteps; i++ )
+            {
+                const double minorValue =
+                    majorValue + qRound64( i * secondsMinor * 1000 );
 
-        if ( majorTicks.isEmpty() || majorTicks.last() != majorValue )
-            majorTicks += majorValue;
+                const bool isMedium = ( numMinorSteps % 2 == 0 )
+                    && ( i != 1 ) && ( i == numMinorSteps / 2 );
 
-        if ( secondsMinor > 0.0 )
+                if ( isMedium )
+                    mediumTicks += minorValue;
+                else
+                    minorTicks += minorValue;
+            }
+        }
+    }
+    else
+    {
+        for ( QDateTime dt = minDate; dt <= maxDate;
+            dt = dt.addSecs( secondsMajor ) )
         {
-            const int numMinorSteps = qwtFloor( secondsMajor / secondsMinor );
+            if ( !dt.isValid() )
+                break;
 
-            for ( int i = 1; i < numMinorSteps; i++ )
+            double majorValue = QwtDate::toDouble( dt );
+
+            if ( daylightSaving )
             {
-                const QDateTime mt = dt.addMSecs(
-                    qRound64( i * secondsMinor * 1000 ) );
+                const double offset = utcOffset - QwtDate::utcOffset( dt );
+                majorValue += offset * 1000.0;
 
-                double minorValue = QwtDate::toDouble( mt );
-                if ( daylightSaving )
+                if ( offset > dstOff )
                 {
-                    const double offset = utcOffset - QwtDate::utcOffset( mt );
-                    minorValue += offset * 1000.0;
+                    // we add some minor ticks for the DST hour,
+                    // otherwise the ticks will be unaligned: 0, 2, 3, 5 ...
+                    minorTicks += qwtDstTicks(
+                        dt, secondsMajor, qRound( secondsMinor ) );
                 }
 
-                if ( minorTicks.isEmpty() || minorTicks.last() != minorValue )
-                {
-                    const bool isMedium = ( numMinorSteps % 2 == 0 )
-                        && ( i != 1 ) && ( i == numMinorSteps / 2 );
+                dstOff = offset;
+            }
 
-                    if ( isMedium )
-                        mediumTicks += minorValue;
-                    else
-                        minorTicks += minorValue;
+            if ( majorTicks.isEmpty() || majorTicks.last() != majorValue )
+                majorTicks += majorValue;
+
+            if ( secondsMinor > 0.0 )
+            {
+                const int numMinorSteps = qwtFloor( secondsMajor / secondsMinor );
+
+                for ( int i = 1; i < numMinorSteps; i++ )
+                {
+                    const QDateTime mt = dt.addMSecs(
+                        qRound64( i * secondsMinor * 1000 ) );
+
+                    double minorValue = QwtDate::toDouble( mt );
+                    if ( daylightSaving )
+                    {
+                        const double offset = utcOffset - QwtDate::utcOffset( mt );
+                        minorValue += offset * 1000.0;
+                    }
+
+                    if ( minorTicks.isEmpty() || minorTicks.last() != minorValue )
+                    {
+                        const bool isMedium = ( numMinorSteps % 2 == 0 )
+                            && ( i != 1 ) && ( i == numMinorSteps / 2 );
+
+                        if ( isMedium )
+                            mediumTicks += minorValue;
+                        else
+                            minorTicks += minorValue;
+                    }
                 }
             }
         }
@@ -587,40 +632,93 @@ static QwtScaleDiv qwtDivideToMonths(
     QList< double > mediumTicks;
     QList< double > minorTicks;
 
-    for ( QDateTime dt = minDate;
-        dt <= maxDate; dt = dt.addMonths( stepSize ) )
+    if ( qwtHasFixedOffset( minDate ) )
     {
-        if ( !dt.isValid() )
-            break;
+        // calendar arithmetic on msecs without creating QDateTime objects
+
+        const int utcOffset = QwtDate::utcOffset( minDate );
+        const int monthsMajor = static_cast< int >( stepSize );
 
-        majorTicks += QwtDate::toDouble( dt );
+        const double min = QwtDate::toDouble( minDate );
+        const double max = QwtDate::toDouble( maxDate );
 
-        if ( minStepDays > 0 )
+        for ( int n = 0; monthsMajor > 0; n++ )
         {
-            for ( int days = minStepDays;
-                days < 30; days += minStepDays )
+            const double majorValue =
+                QwtDate::addMonths( min, n * monthsMajor, utcOffset );
+
+            if ( majorValue > max )
+                break;
+
+            majorTicks += majorValue;
+
+            if ( minStepDays > 0 )
             {
-                const double tick = QwtDate::toDouble( dt.addDays( days ) );
+                for ( int days = minStepDays;
+                    days < 30; days += minStepDays )
+                {
+                    const double tick = majorValue + days * 86400000.0;
 
-                if ( days == 15 && minStepDays != 15 )
-                    mediumTicks += tick;
-                else
-                    minorTicks += tick;
+                    if ( days == 15 && minStepDays != 15 )
+                        mediumTicks += tick;
+                    else
+                        minorTicks += tick;
+                }
+            }
+            else if ( minStepSize > 0.0 )
+            {
+                const int numMinorSteps = qRound( stepSize / (double) minStepSize );
+
+                for ( int i = 1; i < numMinorSteps; i++ )
+                {
+                    const double minorValue = QwtDate::addMonths(
+                        majorValue, i * minStepSize, utcOffset );
+
+                    if ( ( numMinorSteps % 2 == 0 ) && ( i == numMinorSteps / 2 ) )
+                        mediumTicks += minorValue;
+                    else
+                        minorTicks += minorValue;
+                }
             }
         }
-        else if ( minStepSize > 0.0 )
+    }
+    else
+    {
+        for ( QDateTime dt = minDate;
+            dt <= maxDate; dt = dt.addMonths( stepSize ) )
         {
-            const int numMinorSteps = qRound( stepSize / (double) minStepSize );
+            if ( !dt.isValid() )
+                break;
 
-            for ( int i = 1; i < numMinorSteps; i++ )
+            majorTicks += QwtDate::toDouble( dt );
+
+            if ( minStepDays > 0 )
             {
-                const double minorValue =
-                    QwtDate::toDouble( dt.addMonths( i * minStepSize ) );
+                for ( int days = minStepDays;
+                    days < 30; days += minStepDays )
+                {
+                    const double tick = QwtDate::toDouble( dt.addDays( days ) );
 
-                if ( ( numMinorSteps % 2 == 0 ) && ( i == numMinorSteps / 2 ) )
-                    mediumTicks += minorValue;
-                else
-                    minorTicks += minorValue;
+                    if ( days == 15 && minStepDays != 15 )
+                        mediumTicks += tick;
+                    else
+                        minorTicks += tick;
+                }
+            }
+            else if ( minStepSize > 0.0 )
+            {
+                const int numMinorSteps = qRound( stepSize / (double) minStepSize );
+
+                for ( int i = 1; i < numMinorSteps; i++ )
+                {
+                    const double minorValue =
+                        QwtDate::toDouble( dt.addMonths( i * minStepSize ) );
+
+                    if ( ( numMinorSteps % 2 == 0 ) && ( i == numMinorSteps / 2 ) )
+                        mediumTicks += minorValue;
+                    else
+                        minorTicks += minorValue;
+                }
             }
         }
     }
@@ -658,48 +756,89 @@ static QwtScaleDiv qwtDivideToYears(
 
     bool dateBC = minDate.date().year() < -1;
 
-    for ( QDateTime dt = minDate; dt <= maxDate;
-        dt = dt.addYears( stepSize ) )
+    if ( qwtHasFixedOffset( minDate )
+        && minDate.date().year() > 0 && maxDate.date().year() < 1000000 )
     {
-        if ( dateBC && dt.date().year() > 1 )
-        {
-            // there is no year 0 in the Julian calendar
-            dt = dt.addYears( -1 );
-            dateBC = false;
-        }
+        // calendar arithmetic on msecs without creating QDateTime objects
 
-        if ( !dt.isValid() )
-            break;
+        const int utcOffset = QwtDate::utcOffset( minDate );
+        const int yearsMajor = static_cast< int >( stepSize );
 
-        majorTicks += QwtDate::toDouble( dt );
+        const double min = QwtDate::toDouble( minDate );
+        const double max = QwtDate::toDouble( maxDate );
 
-        for ( int i = 1; i < numMinorSteps; i++ )
+        for ( int n = 0; yearsMajor > 0; n++ )
         {
-            QDateTime tickDate;
+            const double majorValue =
+                QwtDate::addMonths( min, n * yearsMajor * 12, utcOffset );
+
+            if ( majorValue > max )
+                break;
 
-            const double years = qRound( i * minStepSize );
-            if ( years >= std::numeric_limits< int >::max() / 12 )
+            majorTicks += majorValue;
+
+            for ( int i = 1; i < numMinorSteps; i++ )
             {
-                tickDate = dt.addYears( years );
+                const int years = qRound( i * minStepSize );
+
+                const bool isMedium = ( numMinorSteps > 2 ) &&
+                    ( numMinorSteps % 2 == 0 ) && ( i == numMinorSteps / 2 );
+
+                const double minorValue =
+                    QwtDate::addMonths( majorValue, years * 12, utcOffset );
+
+                if ( isMedium )
+                    mediumTicks += minorValue;
+                else
+                    minorTicks += minorValue;
             }
-            else
+        }
+    }
+    else
+    {
+        for ( QDateTime dt = minDate; dt <= maxDate;
+            dt = dt.addYears( stepSize ) )
+        {
+            if ( dateBC && dt.date().year() > 1 )
             {
-                tickDate = dt.addMonths( qRound( years * 12 ) );
+                // there is no year 0 in the Julian calendar
+                dt = dt.addYears( -1 );
+                dateBC = false;
             }
 
-            const bool isMedium = ( numMinorSteps > 2 ) &&
-                ( numMinorSteps % 2 == 0 ) && ( i == numMinorSteps / 2 );
+            if ( !dt.isValid() )
+                break;
 
-            const double minorValue = QwtDate::toDouble( tickDate );
-            if ( isMedium )
-                mediumTicks += minorValue;
-            else
-                minorTicks += minorValue;
-        }
+            majorTicks += QwtDate::toDouble( dt );
 
-        if ( QwtDate::maxDate().addYears( -stepSize ) < dt.date() )
-        {
-            break;
+            for ( int i = 1; i < numMinorSteps; i++ )
+            {
+                QDateTime tickDate;
+
+                const double years = qRound( i * minStepSize );
+                if ( years >= std::numeric_limits< int >::max() / 12 )
+                {
+                    tickDate = dt.addYears( years );
+                }
+                else
+                {
+                    tickDate = dt.addMonths( qRound( years * 12 ) );
+                }
+
+                const bool isMedium = ( numMinorSteps > 2 ) &&
+                    ( numMinorSteps % 2 == 0 ) && ( i == numMinorSteps / 2 );
+
+                const double minorValue = QwtDate::toDouble( tickDate );
+                if ( isMedium )
+                    mediumTicks += minorValue;
+                else
+                    minorTicks += minorValue;
+            }
+
+            if ( QwtDate::maxDate().addYears( -stepSize ) < dt.date() )
+            {
+                break;
+            }
         }
     }
 
@@ -9,6 +9,7 @@
 
 #include "qwt_graphic.h"
 #include "qwt_painter_command.h"
+#include "qwt_painter.h"
 #include "qwt_math.h"
 
 #include <qvector.h>
@@ -17,6 +18,11 @@
 #include <qimage.h>
 #include <qpixmap.h>
 #include <qpainterpath.h>
+#include <qpen.h>
+#include <qbrush.h>
+#include <qfont.h>
+
+#include <cstring>
 
 #if QT_VERSION >= 0x050000
 
@@ -320,6 +326,21 @@ class QwtGraphic::PathInfo
         return sy;
     }
 
+    inline QRectF pointRect() const
+    {
+        return m_pointRect;
+    }
+
+    inline QRectF boundingRect() const
+    {
+        return m_boundingRect;
+    }
+
+    inline bool hasScalablePen() const
+    {
+        return m_scalablePen;
+    }
+
   private:
     QRectF m_pointRect;
     QRectF m_boundingRect;
@@ -333,6 +354,53 @@ class QwtGraphic::PrivateData
         : boundingRect( 0.0, 0.0, -1.0, -1.0 )
         , pointRect( 0.0, 0.0, -1.0, -1.0 )
     {
+        cache.policy = QwtGraphic::NoCache;
+        cache.isChecked = false;
+        cache.hasClipping = false;
+        cache.hasCompositionMode = false;
+    }
+
+    void invalidateCache()
+    {
+        cache.entries.clear();
+        cache.isChecked = false;
+    }
+
+    void checkCache()
+    {
+        if ( cache.isChecked )
+            return;
+
+        cache.hasClipping = false;
+        cache.hasCompositionMode = false;
+
+        for ( int i = 0; i < commands.size(); i++ )
+        {
+            if ( commands[i].type() != QwtPainterCommand::State )
+                continue;
+
+            const QwtPainterCommand::StateData* data = commands[i].stateData();
+
+            if ( data->flags & QPaintEngine::DirtyCompositionMode )
+            {
+                if ( data->compositionMode != QPainter::CompositionMode_SourceOver )
+                    cache.hasCompositionMode = true;
+            }
+
+            if ( data->flags & QPaintEngine::DirtyClipEnabled )
+            {
+                if ( data->isClipEnabled )
+                    cache.hasClipping = true;
+            }
+
+            if ( data->flags & ( QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath ) )
+            {
+                if ( data->clipOperation != Qt::NoClip )
+                    cache.hasClipping = true;
+            }
+        }
+
+        cache.isChecked = true;
     }
 
     QSizeF defaultSize;
@@ -344,6 +412,36 @@ class QwtGraphic::PrivateData
 
     QwtGraphic::CommandTypes commandTypes;
     QwtGraphic::RenderHints renderHints;
+
+    struct CacheEntry
+    {
+        bool scaled;
+        int aspectRatioMode;
+        QSizeF size;
+        qreal sx;
+        qreal sy;
+        qreal pixelRatio;
+        QPoint subPixelPos;
+
+        // initial state of the painter, the commands are replayed with
+        QPainter::RenderHints renderHints;
+        QPen pen;
+        QBrush brush;
+        QFont font;
+
+        QImage image;
+    };
+
+    struct RasterCache
+    {
+        QwtGraphic::CachePolicy policy;
+
+        bool isChecked;
+        bool hasClipping;
+        bool hasCompositionMode;
+
+        QList< CacheEntry > entries;
+    } cache;
 };
 
 /*!
@@ -404,6 +502,8 @@ void QwtGraphic::reset()
     m_data->boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
     m_data->pointRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
     m_data->defaultSize = QSizeF();
+
+    m_data->invalidateCache();
 }
 
 /*!
@@ -446,6 +546,8 @@ void QwtGraphic::setRenderHint( RenderHint hint, bool on )
         m_data->renderHints |= hint;
     else
         m_data->renderHints &= ~hint;
+
+    m_data->invalidateCache();
 }
 
 /*!
@@ -466,6 +568,45 @@ QwtGraphic::RenderHints QwtGraphic::renderHints() const
     return m_data->renderHints;
 }
 
+/*!
+   Change the cache policy
+
+   The default policy is NoCache
+
+   \param policy Cache policy
+   \sa CachePolicy, cachePolicy()
+ */
+void QwtGraphic::setCachePolicy( CachePolicy policy )
+{
+    if ( m_data->cache.policy != policy )
+    {
+        m_data->cache.policy = policy;
+        invalidateCache();
+    }
+}
+
+/*!
+   \return Cache policy
+   \sa CachePolicy, setCachePolicy()
+ */
+QwtGraphic::CachePolicy QwtGraphic::cachePolicy() const
+{
+    return m_data->cache.policy;
+}
+
+/*!
+   Invalidate the rasterized renderings of the graphic
+
+   The graphic invalidates its cache, whenever commands are
+   recorded or the render hints are changed.
+
+   \sa CachePolicy, setCachePolicy()
+ */
+void QwtGraphic::invalidateCache()
+{
+    m_data->invalidateCache();
+}
+
 /*!
    The bounding rectangle is the controlPointRect()
    extended by the areas needed for rendering the outlines
@@ -623,7 +764,11 @@ qreal QwtGraphic::widthForHeight( qreal height ) const
  */
 void QwtGraphic::render( QPainter* painter ) const
 {
-    renderGraphic( painter, NULL );
+    if ( isNull() )
+        return;
+
+    if ( !renderCached( painter, boundingRect(), Qt::IgnoreAspectRatio, false ) )
+        renderGraphic( painter, NULL );
 }
 
 void QwtGraphic::renderGraphic( QPainter* painter, QTransform* initialTransform ) const
@@ -679,6 +824,13 @@ void QwtGraphic::render( QPainter* painter, const QRectF& rect,
     if ( isEmpty() || rect.isEmpty() )
         return;
 
+    if ( !renderCached( painter, rect, aspectRatioMode, true ) )
+        renderScaled( painter, rect, aspectRatioMode );
+}
+
+void QwtGraphic::renderScaled( QPainter* painter, const QRectF& rect,
+    Qt::AspectRatioMode aspectRatioMode ) const
+{
     double sx = 1.0;
     double sy = 1.0;
 
@@ -749,6 +901,194 @@ void QwtGraphic::render( QPainter* painter, const QRectF& rect,
     painter->setTransform( transform );
 }
 
+bool QwtGraphic::renderCached( QPainter* painter, const QRectF& rect,
+    Qt::AspectRatioMode aspectRatioMode, bool scaled ) const
+{
+    if ( m_data->cache.policy == QwtGraphic::NoCache || rect.isEmpty() )
+        return false;
+
+    if ( painter == NULL || !painter->isActive() )
+        return false;
+
+    const QPaintEngine::Type engineType = painter->paintEngine()->type();
+
+    if ( m_data->cache.policy == QwtGraphic::AutoCache )
+    {
+        if ( engineType != QPaintEngine::Raster )
+            return false;
+    }
+    else
+    {
+        if ( engineType >= QPaintEngine::User )
+            return false;
+
+        switch( engineType )
+        {
+            case QPaintEngine::Pdf:
+            case QPaintEngine::SVG:
+            case QPaintEngine::Picture:
+                return false;
+
+            default:
+                break;
+        }
+    }
+
+    /*
+        The image is painted in device coordinates. We accept window/viewport
+        settings, that translate only, so that pens are scaled the same way
+        as without cache.
+     */
+    const QTransform transform = painter->combinedTransform();
+    if ( transform.type() > QTransform::TxScale )
+        return false;
+
+    if ( painter->viewTransformEnabled() )
+    {
+        const QTransform worldTransform = painter->worldTransform();
+        if ( transform.m11() != worldTransform.m11()
+            || transform.m22() != worldTransform.m22() )
+        {
+            return false;
+        }
+    }
+
+    if ( painter->opacity() < 1.0 ||
+        painter->compositionMode() != QPainter::CompositionMode_SourceOver )
+    {
+        return false;
+    }
+
+    m_data->checkCache();
+
+    if ( m_data->cache.hasCompositionMode )
+        return false;
+
+    if ( m_data->cache.hasClipping && painter->hasClipping() )
+        return false;
+
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+
+    /*
+        The image covers the target rectangle in device pixels with
+        a small margin for antialiased outlines. Its position is aligned
+        to the pixel grid, while the sub-pixel offset becomes part
+        of the key, so that the cached image is identical
+        to what would have been painted without cache.
+     */
+
+    QRectF deviceRect = transform.mapRect( rect );
+    deviceRect = QRectF( deviceRect.x() * pixelRatio, deviceRect.y() * pixelRatio,
+        deviceRect.width() * pixelRatio, deviceRect.height() * pixelRatio );
+
+    const int margin = 2;
+
+    const int left = qwtFloor( deviceRect.left() );
+    const int top = qwtFloor( deviceRect.top() );
+
+    const QRect pixelRect( left - margin, top - margin,
+        qwtCeil( deviceRect.right() ) - left + 2 * margin,
+        qwtCeil( deviceRect.bottom() ) - top + 2 * margin );
+
+    const int maxPixels = 1024 * 1024;
+    if ( qint64( pixelRect.width() ) * pixelRect.height() > maxPixels )
+        return false;
+
+    const QPoint subPixelPos(
+        qRound( ( deviceRect.left() - left ) * 64.0 ),
+        qRound( ( deviceRect.top() - top ) * 64.0 ) );
+
+    QList< PrivateData::CacheEntry >& entries = m_data->cache.entries;
+
+    int index = -1;
+    for ( int i = 0; i < entries.size(); i++ )
+    {
+        const PrivateData::CacheEntry& entry = entries[i];
+
+        if ( entry.scaled == scaled
+            && entry.aspectRatioMode == aspectRatioMode
+            && entry.size == rect.size()
+            && entry.sx == transform.m11() && entry.sy == transform.m22()
+            && entry.pixelRatio == pixelRatio
+            && entry.subPixelPos == subPixelPos
+            && entry.renderHints == painter->renderHints()
+            && entry.pen == painter->pen()
+            && entry.brush == painter->brush()
+            && entry.font == painter->font() )
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if ( index > 0 )
+    {
+        entries.move( index, 0 );
+    }
+    else if ( index < 0 )
+    {
+        PrivateData::CacheEntry entry;
+        entry.scaled = scaled;
+        entry.aspectRatioMode = aspectRatioMode;
+        entry.size = rect.size();
+        entry.sx = transform.m11();
+        entry.sy = transform.m22();
+        entry.pixelRatio = pixelRatio;
+        entry.subPixelPos = subPixelPos;
+        entry.renderHints = painter->renderHints();
+        entry.pen = painter->pen();
+        entry.brush = painter->brush();
+        entry.font = painter->font();
+
+        entry.image = QImage( pixelRect.size(), QImage::Format_ARGB32_Premultiplied );
+        entry.image.fill( 0 );
+
+#if QT_VERSION >= 0x050000
+        entry.image.setDevicePixelRatio( pixelRatio );
+#endif
+
+        QPainter p( &entry.image );
+        p.setRenderHints( painter->renderHints() );
+        p.setPen( painter->pen() );
+        p.setBrush( painter->brush() );
+        p.setBrushOrigin( painter->brushOrigin() );
+        p.setFont( painter->font() );
+        p.setBackground( painter->background() );
+        p.setBackgroundMode( painter->backgroundMode() );
+
+        QTransform tr;
+        tr.translate( -pixelRect.left() / pixelRatio, -pixelRect.top() / pixelRatio );
+
+        p.setTransform( transform * tr );
+
+        if ( scaled )
+            renderScaled( &p, rect, aspectRatioMode );
+        else
+            renderGraphic( &p, NULL );
+
+        p.end();
+
+        const int maxEntries = 4;
+        while ( entries.size() >= maxEntries )
+            entries.removeLast();
+
+        entries.prepend( entry );
+    }
+
+    painter->save();
+
+    // window/viewport are restored by restore()
+    painter->setWorldTransform( QTransform() );
+    painter->setViewTransformEnabled( false );
+    painter->setRenderHint( QPainter::SmoothPixmapTransform, false );
+    painter->drawImage( QPointF( pixelRect.left() / pixelRatio,
+        pixelRect.top() / pixelRatio ), entries.first().image );
+
+    painter->restore();
+
+    return true;
+}
+
 /*!
    \brief Replay all recorded painter commands
 
@@ -999,6 +1339,7 @@ void QwtGraphic::drawPath( const QPainterPath& path )
         return;
 
     m_data->commands += QwtPainterCommand( path );
+    m_data->invalidateCache();
     m_data->commandTypes |= QwtGraphic::VectorData;
 
     if ( !path.isEmpty() )
@@ -1039,6 +1380,7 @@ void QwtGraphic::drawPixmap( const QRectF& rect,
         return;
 
     m_data->commands += QwtPainterCommand( rect, pixmap, subRect );
+    m_data->invalidateCache();
     m_data->commandTypes |= QwtGraphic::RasterData;
 
     const QRectF r = painter->transform().mapRect( rect );
@@ -1064,6 +1406,7 @@ void QwtGraphic::drawImage( const QRectF& rect, const QImage& image,
         return;
 
     m_data->commands += QwtPainterCommand( rect, image, subRect, flags );
+    m_data->invalidateCache();
     m_data->commandTypes |= QwtGraphic::RasterData;
 
     const QRectF r = painter->transform().mapRect( rect );
@@ -1081,6 +1424,7 @@ void QwtGraphic::drawImage( const QRectF& rect, const QImage& image,
 void QwtGraphic::updateState( const QPaintEngineState& state )
 {
     m_data->commands += QwtPainterCommand( state );
+    m_data->invalidateCache();
 
     if ( state.state() & QPaintEngine::DirtyTransform )
     {
@@ -1161,3 +1505,637 @@ void QwtGraphic::setCommands( const QVector< QwtPainterCommand >& commands )
 
     painter.end();
 }
+
+#ifndef QT_NO_DATASTREAM
+
+#include <qdatastream.h>
+#include <qendian.h>
+#include <qiodevice.h>
+#include <limits>
+
+// "QwtG"
+static const quint32 qwtGraphicMagic = 0x51777447;
+static const quint16 qwtGraphicFormatVersion = 1;
+
+/*
+    Counts are read from the stream before the data they describe.
+    When the size of the device is known, a count, that needs more bytes
+    than available, is rejected. Otherwise the arrays grow in chunks
+    while reading, so that a corrupted count can't force huge allocations.
+ */
+static const int qwtChunkSize = 64 * 1024;
+
+static bool qwtIsCountAvailable( const QDataStream& stream,
+    quint32 count, int minBytesPerItem )
+{
+    const QIODevice* device = stream.device();
+    if ( device == NULL || device->isSequential() )
+        return true;
+
+    return qint64( count ) * minBytesPerItem <= device->bytesAvailable();
+}
+
+static inline bool qwtIsHostByteOrder( const QDataStream& stream )
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    return stream.byteOrder() == QDataStream::BigEndian;
+#else
+    return stream.byteOrder() == QDataStream::LittleEndian;
+#endif
+}
+
+static void qwtWriteDoubles( QDataStream& stream,
+    const double* values, int count )
+{
+    const int numBytes = count * int( sizeof( double ) );
+
+    if ( qwtIsHostByteOrder( stream ) )
+    {
+        stream.writeRawData(
+            reinterpret_cast< const char* >( values ), numBytes );
+    }
+    else
+    {
+        QVector< quint64 > swapped( count );
+        quint64* s = swapped.data();
+
+        std::memcpy( s, values, numBytes );
+        for ( int i = 0; i < count; i++ )
+            s[i] = qbswap( s[i] );
+
+        stream.writeRawData(
+            reinterpret_cast< const char* >( s ), numBytes );
+    }
+}
+
+static bool qwtReadDoubles( QDataStream& stream,
+    double* values, int count )
+{
+    const int numBytes = count * int( sizeof( double ) );
+
+    if ( stream.readRawData(
+        reinterpret_cast< char* >( values ), numBytes ) != numBytes )
+    {
+        return false;
+    }
+
+    if ( !qwtIsHostByteOrder( stream ) )
+    {
+        quint64* v = reinterpret_cast< quint64* >( values );
+        for ( int i = 0; i < count; i++ )
+            v[i] = qbswap( v[i] );
+    }
+
+    return true;
+}
+
+/*
+    The elements of a path are stored as one block of element types
+    followed by one block of raw coordinates, so that loading a path
+    needs 2 reads only - regardless of the number of elements.
+ */
+static void qwtWritePath( QDataStream& stream, const QPainterPath& path )
+{
+    const int count = path.elementCount();
+
+    stream << static_cast< quint8 >( path.fillRule() );
+    stream << static_cast< quint32 >( count );
+
+    if ( count <= 0 )
+        return;
+
+    QByteArray types;
+    types.resize( count );
+
+    QVector< double > coordinates( 2 * count );
+    double* c = coordinates.data();
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const QPainterPath::Element& element = path.elementAt( i );
+
+        types[i] = static_cast< char >( element.type );
+        c[2 * i] = element.x;
+        c[2 * i + 1] = element.y;
+    }
+
+    stream.writeRawData( types.constData(), count );
+    qwtWriteDoubles( stream, coordinates.constData(), coordinates.size() );
+}
+
+static bool qwtReadPath( QDataStream& stream, QPainterPath& path )
+{
+    quint8 fillRule;
+    quint32 count;
+
+    stream >> fillRule >> count;
+
+    if ( stream.status() != QDataStream::Ok )
+        return false;
+
+    // an element: 1 byte for the type, 2 doubles for the coordinates
+    const int elementSize = 1 + 2 * int( sizeof( double ) );
+
+    if ( count > quint32( std::numeric_limits< int >::max() / elementSize )
+        || !qwtIsCountAvailable( stream, count, elementSize ) )
+    {
+        stream.setStatus( QDataStream::ReadCorruptData );
+        return false;
+    }
+
+    path = QPainterPath();
+    path.setFillRule( static_cast< Qt::FillRule >( fillRule ) );
+
+    const int numElements = static_cast< int >( count );
+    if ( numElements == 0 )
+        return true;
+
+    QByteArray types;
+    for ( int i = 0; i < numElements; i += qwtChunkSize )
+    {
+        const int n = qMin( qwtChunkSize, numElements - i );
+
+        types.resize( i + n );
+        if ( stream.readRawData( types.data() + i, n ) != n )
+            return false;
+    }
+
+    QVector< double > coordinates;
+    for ( int i = 0; i < 2 * numElements; i += qwtChunkSize )
+    {
+        const int n = qMin( qwtChunkSize, 2 * numElements - i );
+
+        coordinates.resize( i + n );
+        if ( !qwtReadDoubles( stream, coordinates.data() + i, n ) )
+            return false;
+    }
+
+#if QT_VERSION >= 0x050d00
+    path.reserve( numElements );
+#endif
+
+    const char* t = types.constData();
+    const double* c = coordinates.constData();
+
+    /*
+        QPainterPath doesn't check the sequence of the elements, so
+        we need to reject malformed input before building the path:
+        it has to start with a MoveTo and each CurveTo has to be
+        followed by 2 CurveToData elements.
+     */
+    if ( t[0] != QPainterPath::MoveToElement )
+    {
+        stream.setStatus( QDataStream::ReadCorruptData );
+        return false;
+    }
+
+    for ( int i = 0; i < numElements; i++ )
+    {
+        if ( t[i] == QPainterPath::CurveToElement )
+        {
+            if ( i + 2 >= numElements
+                || t[i + 1] != QPainterPath::CurveToDataElement
+                || t[i + 2] != QPainterPath::CurveToDataElement )
+            {
+                stream.setStatus( QDataStream::ReadCorruptData );
+                return false;
+            }
+
+            i += 2;
+        }
+        else if ( t[i] != QPainterPath::MoveToElement
+            && t[i] != QPainterPath::LineToElement )
+        {
+            stream.setStatus( QDataStream::ReadCorruptData );
+            return false;
+        }
+    }
+
+    for ( int i = 0; i < numElements; i++ )
+    {
+        const QPointF pos( c[2 * i], c[2 * i + 1] );
+
+        switch( t[i] )
+        {
+            case QPainterPath::MoveToElement:
+            {
+                path.moveTo( pos );
+                break;
+            }
+            case QPainterPath::LineToElement:
+            {
+                path.lineTo( pos );
+                break;
+            }
+            case QPainterPath::CurveToElement:
+            {
+                const QPointF c2( c[2 * i + 2], c[2 * i + 3] );
+                const QPointF endPoint( c[2 * i + 4], c[2 * i + 5] );
+
+                path.cubicTo( pos, c2, endPoint );
+                i += 2;
+
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+static void qwtWriteState( QDataStream& stream,
+    const QwtPainterCommand::StateData& data )
+{
+    const QPaintEngine::DirtyFlags flags = data.flags;
+
+    stream << static_cast< quint32 >( flags );
+
+    if ( flags & QPaintEngine::DirtyPen )
+        stream << data.pen;
+
+    if ( flags & QPaintEngine::DirtyBrush )
+        stream << data.brush;
+
+    if ( flags & QPaintEngine::DirtyBrushOrigin )
+        stream << data.brushOrigin;
+
+    if ( flags & QPaintEngine::DirtyFont )
+        stream << data.font;
+
+    if ( flags & QPaintEngine::DirtyBackground )
+    {
+        stream << static_cast< quint8 >( data.backgroundMode );
+        stream << data.backgroundBrush;
+    }
+
+    if ( flags & QPaintEngine::DirtyTransform )
+        stream << data.transform;
+
+    if ( flags & QPaintEngine::DirtyClipEnabled )
+        stream << data.isClipEnabled;
+
+    if ( flags & QPaintEngine::DirtyClipRegion )
+    {
+        stream << static_cast< quint8 >( data.clipOperation );
+        stream << data.clipRegion;
+    }
+
+    if ( flags & QPaintEngine::DirtyClipPath )
+    {
+        stream << static_cast< quint8 >( data.clipOperation );
+        qwtWritePath( stream, data.clipPath );
+    }
+
+    if ( flags & QPaintEngine::DirtyHints )
+        stream << static_cast< quint32 >( data.renderHints );
+
+    if ( flags & QPaintEngine::DirtyCompositionMode )
+        stream << static_cast< quint32 >( data.compositionMode );
+
+    if ( flags & QPaintEngine::DirtyOpacity )
+        stream << static_cast< double >( data.opacity );
+}
+
+static bool qwtReadState( QDataStream& stream,
+    QwtPainterCommand::StateData& data )
+{
+    quint32 flags;
+    stream >> flags;
+
+    data.flags = QPaintEngine::DirtyFlags( QFlag( int( flags ) ) );
+    data.backgroundMode = Qt::TransparentMode;
+    data.clipOperation = Qt::NoClip;
+    data.isClipEnabled = false;
+    data.compositionMode = QPainter::CompositionMode_SourceOver;
+    data.opacity = 1.0;
+
+    if ( data.flags & QPaintEngine::DirtyPen )
+        stream >> data.pen;
+
+    if ( data.flags & QPaintEngine::DirtyBrush )
+        stream >> data.brush;
+
+    if ( data.flags & QPaintEngine::DirtyBrushOrigin )
+        stream >> data.brushOrigin;
+
+    if ( data.flags & QPaintEngine::DirtyFont )
+        stream >> data.font;
+
+    if ( data.flags & QPaintEngine::DirtyBackground )
+    {
+        quint8 mode;
+        stream >> mode >> data.backgroundBrush;
+
+        data.backgroundMode = static_cast< Qt::BGMode >( mode );
+    }
+
+    if ( data.flags & QPaintEngine::DirtyTransform )
+        stream >> data.transform;
+
+    if ( data.flags & QPaintEngine::DirtyClipEnabled )
+        stream >> data.isClipEnabled;
+
+    if ( data.flags & QPaintEngine::DirtyClipRegion )
+    {
+        quint8 operation;
+        stream >> operation >> data.clipRegion;
+
+        data.clipOperation = static_cast< Qt::ClipOperation >( operation );
+    }
+
+    if ( data.flags & QPaintEngine::DirtyClipPath )
+    {
+        quint8 operation;
+        stream >> operation;
+
+        data.clipOperation = static_cast< Qt::ClipOperation >( operation );
+
+        if ( !qwtReadPath( stream, data.clipPath ) )
+            return false;
+    }
+
+    if ( data.flags & QPaintEngine::DirtyHints )
+    {
+        quint32 hints;
+        stream >> hints;
+
+        data.renderHints = QPainter::RenderHints( QFlag( int( hints ) ) );
+    }
+
+    if ( data.flags & QPaintEngine::DirtyCompositionMode )
+    {
+        quint32 mode;
+        stream >> mode;
+
+        data.compositionMode = static_cast< QPainter::CompositionMode >( mode );
+    }
+
+    if ( data.flags & QPaintEngine::DirtyOpacity )
+    {
+        double opacity;
+        stream >> opacity;
+
+        data.opacity = opacity;
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+static void qwtWriteCommand( QDataStream& stream, const QwtPainterCommand& cmd )
+{
+    stream << static_cast< qint8 >( cmd.type() );
+
+    switch( cmd.type() )
+    {
+        case QwtPainterCommand::Path:
+        {
+            qwtWritePath( stream, *cmd.path() );
+            break;
+        }
+        case QwtPainterCommand::Pixmap:
+        {
+            const QwtPainterCommand::PixmapData* data = cmd.pixmapData();
+            stream << data->rect << data->subRect << data->pixmap;
+            break;
+        }
+        case QwtPainterCommand::Image:
+        {
+            const QwtPainterCommand::ImageData* data = cmd.imageData();
+            stream << data->rect << data->subRect
+                   << static_cast< quint32 >( data->flags ) << data->image;
+            break;
+        }
+        case QwtPainterCommand::State:
+        {
+            qwtWriteState( stream, *cmd.stateData() );
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static bool qwtReadCommand( QDataStream& stream, QwtPainterCommand& cmd )
+{
+    qint8 type;
+    stream >> type;
+
+    switch( type )
+    {
+        case QwtPainterCommand::Path:
+        {
+            QPainterPath path;
+            if ( !qwtReadPath( stream, path ) )
+                return false;
+
+            cmd = QwtPainterCommand( path );
+            break;
+        }
+        case QwtPainterCommand::Pixmap:
+        {
+            QRectF rect, subRect;
+            QPixmap pixmap;
+
+            stream >> rect >> subRect >> pixmap;
+            cmd = QwtPainterCommand( rect, pixmap, subRect );
+
+            break;
+        }
+        case QwtPainterCommand::Image:
+        {
+            QRectF rect, subRect;
+            quint32 flags;
+            QImage image;
+
+            stream >> rect >> subRect >> flags >> image;
+            cmd = QwtPainterCommand( rect, image, subRect,
+                Qt::ImageConversionFlags( QFlag( int( flags ) ) ) );
+
+            break;
+        }
+        case QwtPainterCommand::State:
+        {
+            QwtPainterCommand::StateData data;
+            if ( !qwtReadState( stream, data ) )
+                return false;
+
+            cmd = QwtPainterCommand( data );
+            break;
+        }
+        case QwtPainterCommand::Invalid:
+        {
+            cmd = QwtPainterCommand();
+            break;
+        }
+        default:
+            return false;
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+/*!
+   \brief Write a graphic to a stream
+
+   Beside the recorded painter commands the stream contains the
+   default size, the render hints and the precalculated geometries,
+   so that the graphic can be restored without replaying its commands.
+
+   The coordinates of the painter paths are always stored as
+   doubles - regardless of QDataStream::floatingPointPrecision().
+
+   \param stream Output stream
+   \param graphic Graphic to be written
+   \return Reference to the stream
+
+   \sa operator>>()
+ */
+QDataStream& operator<<( QDataStream& stream, const QwtGraphic& graphic )
+{
+    const QwtGraphic::PrivateData* d = graphic.m_data;
+
+    stream << qwtGraphicMagic << qwtGraphicFormatVersion;
+    stream << static_cast< qint32 >( stream.version() );
+
+    stream << d->defaultSize;
+    stream << static_cast< quint32 >( d->renderHints );
+    stream << static_cast< quint32 >( d->commandTypes );
+    stream << d->boundingRect << d->pointRect;
+
+    stream << static_cast< quint32 >( d->pathInfos.size() );
+    for ( int i = 0; i < d->pathInfos.size(); i++ )
+    {
+        const QwtGraphic::PathInfo& info = d->pathInfos[i];
+
+        stream << info.pointRect() << info.boundingRect()
+               << info.hasScalablePen();
+    }
+
+    stream << static_cast< quint32 >( d->commands.size() );
+    for ( int i = 0; i < d->commands.size(); i++ )
+        qwtWriteCommand( stream, d->commands[i] );
+
+    return stream;
+}
+
+/*!
+   \brief Read a graphic from a stream
+
+   When the stream doesn't contain a valid graphic the status of the
+   stream is set to QDataStream::ReadCorruptData and the graphic
+   is reset to a null graphic.
+
+   \param stream Input stream
+   \param graphic Graphic to be initialized from the stream
+   \return Reference to the stream
+
+   \sa operator<<()
+ */
+QDataStream& operator>>( QDataStream& stream, QwtGraphic& graphic )
+{
+    graphic.reset();
+
+    quint32 magic;
+    quint16 formatVersion;
+    qint32 streamVersion;
+
+    stream >> magic >> formatVersion >> streamVersion;
+
+    if ( stream.status() != QDataStream::Ok )
+        return stream;
+
+    if ( magic != qwtGraphicMagic || formatVersion > qwtGraphicFormatVersion
+        || streamVersion < QDataStream::Qt_1_0
+        || streamVersion > QDataStream().version() )
+    {
+        stream.setStatus( QDataStream::ReadCorruptData );
+        return stream;
+    }
+
+    const int version = stream.version();
+    stream.setVersion( streamVersion );
+
+    QwtGraphic::PrivateData d;
+    d.cache.policy = graphic.m_data->cache.policy;
+
+    quint32 renderHints, commandTypes;
+
+    stream >> d.defaultSize >> renderHints >> commandTypes;
+    stream >> d.boundingRect >> d.pointRect;
+
+    d.renderHints = QwtGraphic::RenderHints( QFlag( int( renderHints ) ) );
+    d.commandTypes = QwtGraphic::CommandTypes( QFlag( int( commandTypes ) ) );
+
+    bool ok = ( stream.status() == QDataStream::Ok );
+
+    quint32 numInfos = 0;
+    if ( ok )
+    {
+        stream >> numInfos;
+
+        // 2 rectangles of 4 values and a bool - at least 4 bytes each
+        ok = ( stream.status() == QDataStream::Ok )
+            && ( numInfos <= quint32( std::numeric_limits< int >::max() / 64 ) )
+            && qwtIsCountAvailable( stream, numInfos, 33 );
+    }
+
+    if ( ok )
+    {
+        d.pathInfos.reserve( qMin( int( numInfos ), qwtChunkSize ) );
+
+        for ( quint32 i = 0; ok && i < numInfos; i++ )
+        {
+            QRectF pointRect, boundingRect;
+            bool scalablePen;
+
+            stream >> pointRect >> boundingRect >> scalablePen;
+            d.pathInfos += QwtGraphic::PathInfo(
+                pointRect, boundingRect, scalablePen );
+
+            ok = ( stream.status() == QDataStream::Ok );
+        }
+    }
+
+    quint32 numCommands = 0;
+    if ( ok )
+    {
+        stream >> numCommands;
+
+        // each command starts with its type
+        ok = ( stream.status() == QDataStream::Ok )
+            && ( numCommands <= quint32( std::numeric_limits< int >::max() / 64 ) )
+            && qwtIsCountAvailable( stream, numCommands, 1 );
+    }
+
+    if ( ok )
+    {
+        d.commands.reserve( qMin( int( numCommands ), qwtChunkSize ) );
+
+        for ( quint32 i = 0; ok && i < numCommands; i++ )
+        {
+            QwtPainterCommand command;
+
+            ok = qwtReadCommand( stream, command );
+            if ( ok )
+                d.commands += command;
+        }
+    }
+
+    stream.setVersion( version );
+
+    if ( ok )
+    {
+        *graphic.m_data = d;
+    }
+    else
+    {
+        if ( stream.status() == QDataStream::Ok )
+            stream.setStatus( QDataStream::ReadCorruptData );
+    }
+
+    return stream;
+}
+
+#endif
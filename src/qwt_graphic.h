@@ -16,8 +16,15 @@
 #include <qmetatype.h>
 
 class QwtPainterCommand;
+class QwtGraphic;
 class QPixmap;
 class QImage;
+class QDataStream;
+
+#ifndef QT_NO_DATASTREAM
+QWT_EXPORT QDataStream& operator<<( QDataStream&, const QwtGraphic& );
+QWT_EXPORT QDataStream& operator>>( QDataStream&, QwtGraphic& );
+#endif
 
 /*!
     \brief A paint device for scalable graphics
@@ -70,6 +77,12 @@ class QImage;
     scaling with a fixed aspect ratio always needs to be calculated from the
     control point rectangle.
 
+    A graphic can be written to and read from a QDataStream. The format
+    is versioned and stores the recorded commands together with the
+    precalculated geometry, so that loading a graphic does not need to
+    replay its commands like setCommands() does. This allows to cache
+    expensive graphics ( f.e. converted from SVG documents ) on disk.
+
     \sa QwtPainterCommand
  */
 class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
@@ -116,6 +129,51 @@ class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
 
     Q_DECLARE_FLAGS( CommandTypes, CommandType )
 
+    /*!
+       Replaying complex graphics might be expensive. For software
+       renderers it is usually faster to rasterize the graphic once
+       and to copy the image to the target, when the graphic is
+       painted again with the same size and transformation.
+
+       The graphic keeps a small number of rasterized renderings
+       keyed by the target size, the device pixel ratio, the scaling
+       of the painter transformation, the sub-pixel position and
+       the render hints, pen, brush and font of the painter, so that
+       the cached image is pixel identical to replaying the commands.
+
+       The cache holds up to 4 images with at most 1M pixels each.
+       As it is keyed by the sub-pixel position it is only useful, when
+       the graphic is painted at aligned positions. The default setting
+       is NoCache.
+
+       \note With Cache or AutoCache the const render() methods modify
+             the internal cache of the graphic object.
+
+       \sa setCachePolicy(), cachePolicy()
+       \note The cache is never used for transformations beyond
+             translations and scaling, window/viewport settings, that
+             scale, for a painter opacity < 1.0
+             or a composition mode different from
+             QPainter::CompositionMode_SourceOver.
+
+       \warning Rendering the same graphic object from different threads
+                needs to be done with NoCache.
+     */
+    enum CachePolicy
+    {
+        //! Always replay the recorded commands
+        NoCache,
+
+        //! Use the cache for all paint engines beside vector graphics
+        Cache,
+
+        /*!
+           Use the cache when the graphic is rendered with
+           the software renderer ( QPaintEngine::Raster )
+         */
+        AutoCache
+    };
+
     QwtGraphic();
     QwtGraphic( const QwtGraphic& );
 
@@ -172,6 +230,11 @@ class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
 
     RenderHints renderHints() const;
 
+    void setCachePolicy( CachePolicy );
+    CachePolicy cachePolicy() const;
+
+    void invalidateCache();
+
   protected:
     virtual QSize sizeMetrics() const QWT_OVERRIDE;
 
@@ -187,6 +250,10 @@ class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
 
   private:
     void renderGraphic( QPainter*, QTransform* ) const;
+    void renderScaled( QPainter*, const QRectF&, Qt::AspectRatioMode ) const;
+
+    bool renderCached( QPainter*, const QRectF&,
+        Qt::AspectRatioMode, bool scaled ) const;
 
     void updateBoundingRect( const QRectF& );
     void updateControlPointRect( const QRectF& );
@@ -195,6 +262,11 @@ class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
 
     class PrivateData;
     PrivateData* m_data;
+
+#ifndef QT_NO_DATASTREAM
+    friend QDataStream& operator<<( QDataStream&, const QwtGraphic& );
+    friend QDataStream& operator>>( QDataStream&, QwtGraphic& );
+#endif
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtGraphic::RenderHints )
@@ -0,0 +1,519 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_histogram_data.h"
+#include "qwt_math.h"
+
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+// minimum number of values, that is worth to be binned in a thread
+static const size_t qwtMinValuesPerThread = 100000;
+
+namespace
+{
+    class BinCommand
+    {
+      public:
+        const double* values;
+
+        double min;
+        double max;
+        double scale;
+
+        int numBins;
+    };
+
+    /*
+        counts[0] - counts[numBins - 1]: bins
+        counts[numBins]: values < min
+        counts[numBins + 1]: values > max
+     */
+    void binValues( const BinCommand& command,
+        size_t from, size_t to, quint64* counts )
+    {
+        const int lastBin = command.numBins - 1;
+
+        for ( size_t i = from; i < to; i++ )
+        {
+            const double value = command.values[i];
+
+            if ( value < command.min )
+            {
+                counts[ command.numBins ]++;
+            }
+            else if ( value > command.max )
+            {
+                counts[ command.numBins + 1 ]++;
+            }
+            else if ( value >= command.min ) // not for NaN
+            {
+                // the upper bound is included in the last bin
+                const int index = static_cast< int >(
+                    ( value - command.min ) * command.scale );
+
+                counts[ qMin( index, lastBin ) ]++;
+            }
+        }
+    }
+}
+
+class QwtHistogramData::PrivateData
+{
+  public:
+    PrivateData()
+        : maxBinCount( 100 )
+        , numThreads( 0 )
+        , rectOfInterest( 0.0, 0.0, -1.0, -1.0 )
+        , isDirty( true )
+    {
+    }
+
+    void reset( int numBins )
+    {
+        counts.fill( 0, qMax( numBins, 0 ) + 2 );
+        isDirty = true;
+    }
+
+    inline int numBins() const
+    {
+        return counts.size() - 2;
+    }
+
+    QwtInterval interval;
+
+    // base bins + underflow + overflow
+    QVector< quint64 > counts;
+
+    int maxBinCount;
+    uint numThreads;
+
+    QRectF rectOfInterest;
+
+    // samples of the merged bins for the rect of interest
+    mutable bool isDirty;
+    mutable QVector< QwtIntervalSample > samples;
+    mutable QRectF boundingRect;
+};
+
+/*!
+   \brief Constructor
+
+   Creates an empty histogram without any bins
+   \sa setInterval()
+ */
+QwtHistogramData::QwtHistogramData()
+{
+    m_data = new PrivateData();
+    m_data->reset( 0 );
+}
+
+/*!
+   \brief Constructor
+
+   \param interval Interval of the values, that are binned
+   \param numBaseBins Number of equidistant base bins
+ */
+QwtHistogramData::QwtHistogramData(
+    const QwtInterval& interval, int numBaseBins )
+{
+    m_data = new PrivateData();
+    setInterval( interval, numBaseBins );
+}
+
+//! Destructor
+QwtHistogramData::~QwtHistogramData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the interval and the number of base bins
+
+   All counts are reset to 0.
+
+   \param interval Interval of the values, that are binned.
+                   Values outside of the interval are counted
+                   in underflowCount() or overflowCount().
+   \param numBaseBins Number of equidistant base bins
+
+   \sa interval(), baseBinCount(), clear()
+ */
+void QwtHistogramData::setInterval(
+    const QwtInterval& interval, int numBaseBins )
+{
+    m_data->interval = interval.normalized();
+
+    if ( !m_data->interval.isValid() || m_data->interval.width() <= 0.0 )
+        numBaseBins = 0;
+
+    m_data->reset( numBaseBins );
+}
+
+/*!
+   \return Interval of the values, that are binned
+   \sa setInterval()
+ */
+QwtInterval QwtHistogramData::interval() const
+{
+    return m_data->interval;
+}
+
+/*!
+   \return Number of equidistant base bins
+   \sa setInterval(), baseCount()
+ */
+int QwtHistogramData::baseBinCount() const
+{
+    return m_data->numBins();
+}
+
+/*!
+   \param index Index of a base bin
+   \return Number of values in a base bin
+   \sa baseBinCount()
+ */
+quint64 QwtHistogramData::baseCount( int index ) const
+{
+    if ( index < 0 || index >= m_data->numBins() )
+        return 0;
+
+    return m_data->counts[ index ];
+}
+
+/*!
+   \brief Set the maximum for the number of displayed bins
+
+   Neighboured base bins are merged, so that the number of bins
+   inside of the rectangle of interest does not exceed numBins.
+   The default setting is 100.
+
+   \param numBins Maximum for the number of bins
+   \sa maxBinCount(), setRectOfInterest()
+ */
+void QwtHistogramData::setMaxBinCount( int numBins )
+{
+    numBins = qMax( numBins, 1 );
+
+    if ( numBins != m_data->maxBinCount )
+    {
+        m_data->maxBinCount = numBins;
+        m_data->isDirty = true;
+    }
+}
+
+/*!
+   \return Maximum for the number of displayed bins
+   \sa setMaxBinCount()
+ */
+int QwtHistogramData::maxBinCount() const
+{
+    return m_data->maxBinCount;
+}
+
+/*!
+   \brief Set the number of threads for binning values
+
+   Values are binned concurrently only, when there are enough
+   of them, that it is worth the overhead of starting threads.
+
+   \param numThreads Number of threads, 0 means QThread::idealThreadCount()
+   \sa threadCount(), addValues()
+ */
+void QwtHistogramData::setThreadCount( uint numThreads )
+{
+    m_data->numThreads = numThreads;
+}
+
+/*!
+   \return Number of threads for binning values
+   \sa setThreadCount()
+ */
+uint QwtHistogramData::threadCount() const
+{
+    return m_data->numThreads;
+}
+
+/*!
+   \brief Add a value
+
+   \param value Value
+   \sa addValues()
+ */
+void QwtHistogramData::addValue( double value )
+{
+    addValues( &value, 1 );
+}
+
+/*!
+   \brief Add values
+
+   \param values Array of values
+   \sa addValue()
+ */
+void QwtHistogramData::addValues( const QVector< double >& values )
+{
+    addValues( values.constData(), values.size() );
+}
+
+/*!
+   \brief Add values
+
+   Large arrays are split into chunks, that are binned in
+   concurrent threads.
+
+   \param values Array of values
+   \param count Number of values
+   \sa addValue(), setThreadCount()
+ */
+void QwtHistogramData::addValues( const double* values, size_t count )
+{
+    const int numBins = m_data->numBins();
+    if ( numBins <= 0 || values == NULL || count == 0 )
+        return;
+
+    BinCommand command;
+    command.values = values;
+    command.min = m_data->interval.minValue();
+    command.max = m_data->interval.maxValue();
+    command.scale = numBins / m_data->interval.width();
+    command.numBins = numBins;
+
+    quint64* counts = m_data->counts.data();
+
+#if QWT_USE_THREADS
+    size_t numThreads = m_data->numThreads;
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    numThreads = qMin( numThreads, count / qwtMinValuesPerThread );
+
+    if ( numThreads > 1 )
+    {
+        const size_t chunkSize = count / numThreads;
+
+        // each thread counts into its own bins
+
+        QVector< QVector< quint64 > > localCounts( int( numThreads ) - 1 );
+
+        QList< QFuture< void > > futures;
+        for ( size_t i = 0; i < numThreads; i++ )
+        {
+            const size_t from = i * chunkSize;
+
+            if ( i == numThreads - 1 )
+            {
+                binValues( command, from, count, counts );
+            }
+            else
+            {
+                QVector< quint64 >& local = localCounts[ int( i ) ];
+                local.fill( 0, numBins + 2 );
+
+                futures += QtConcurrent::run( &binValues,
+                    command, from, from + chunkSize, local.data() );
+            }
+        }
+
+        for ( int i = 0; i < futures.size(); i++ )
+        {
+            futures[i].waitForFinished();
+
+            const quint64* local = localCounts[i].constData();
+            for ( int j = 0; j < numBins + 2; j++ )
+                counts[j] += local[j];
+        }
+    }
+    else
+    {
+        binValues( command, 0, count, counts );
+    }
+#else
+    binValues( command, 0, count, counts );
+#endif
+
+    m_data->isDirty = true;
+}
+
+/*!
+   Reset all counts to 0
+   \sa addValues()
+ */
+void QwtHistogramData::clear()
+{
+    m_data->reset( m_data->numBins() );
+}
+
+/*!
+   \return Number of values, that have been added, including
+          the values outside of interval()
+   \sa underflowCount(), overflowCount()
+ */
+quint64 QwtHistogramData::totalCount() const
+{
+    quint64 count = 0;
+    for ( int i = 0; i < m_data->counts.size(); i++ )
+        count += m_data->counts[i];
+
+    return count;
+}
+
+/*!
+   \return Number of values below interval()
+   \sa overflowCount(), totalCount()
+ */
+quint64 QwtHistogramData::underflowCount() const
+{
+    return m_data->counts[ m_data->numBins() ];
+}
+
+/*!
+   \return Number of values above interval()
+   \sa underflowCount(), totalCount()
+ */
+quint64 QwtHistogramData::overflowCount() const
+{
+    return m_data->counts[ m_data->numBins() + 1 ];
+}
+
+/*!
+   \brief Set the rectangle of interest
+
+   QwtPlotSeriesItem passes the scales of the plot to its data.
+   The base bins inside the horizontal range of rect are merged,
+   so that the number of samples does not exceed maxBinCount().
+
+   \param rect Rectangle of interest
+   \sa rectOfInterest(), setMaxBinCount(), QwtPlotSeriesItem::updateScaleDiv()
+ */
+void QwtHistogramData::setRectOfInterest( const QRectF& rect )
+{
+    if ( rect.left() != m_data->rectOfInterest.left()
+        || rect.right() != m_data->rectOfInterest.right() )
+    {
+        m_data->isDirty = true;
+    }
+
+    m_data->rectOfInterest = rect;
+}
+
+/*!
+   \return Rectangle of interest
+   \sa setRectOfInterest()
+ */
+QRectF QwtHistogramData::rectOfInterest() const
+{
+    return m_data->rectOfInterest;
+}
+
+/*!
+   \return Bounding rectangle of the samples
+
+   The horizontal range is always interval(), so that
+   autoscaling does not depend on the rectangle of interest.
+ */
+QRectF QwtHistogramData::boundingRect() const
+{
+    updateSamples();
+    return m_data->boundingRect;
+}
+
+/*!
+   \return Number of samples for the current rectangle of interest
+   \sa sample()
+ */
+size_t QwtHistogramData::size() const
+{
+    updateSamples();
+    return m_data->samples.size();
+}
+
+/*!
+   \param index Index
+   \return Merged bin, with the number of values as value()
+ */
+QwtIntervalSample QwtHistogramData::sample( size_t index ) const
+{
+    updateSamples();
+    return m_data->samples[ int( index ) ];
+}
+
+void QwtHistogramData::updateSamples() const
+{
+    if ( !m_data->isDirty )
+        return;
+
+    m_data->isDirty = false;
+    m_data->samples.clear();
+    m_data->boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+
+    const int numBins = m_data->numBins();
+    if ( numBins <= 0 )
+        return;
+
+    const double min = m_data->interval.minValue();
+    const double binWidth = m_data->interval.width() / numBins;
+
+    // the base bins inside the rect of interest
+
+    int bin1 = 0;
+    int bin2 = numBins - 1;
+
+    const QRectF& roi = m_data->rectOfInterest;
+    if ( roi.width() > 0.0 )
+    {
+        const double b1 = std::floor( ( roi.left() - min ) / binWidth );
+        const double b2 = std::floor( ( roi.right() - min ) / binWidth );
+
+        bin1 = static_cast< int >( qBound( 0.0, b1, numBins - 1.0 ) );
+        bin2 = static_cast< int >( qBound( 0.0, b2, numBins - 1.0 ) );
+    }
+
+    /*
+        The merged bins are aligned to multiples of the merge factor,
+        so that they don't change, when panning
+     */
+
+    const int numVisible = bin2 - bin1 + 1;
+    const int factor = qMax( 1, qwtCeil( double( numVisible ) / m_data->maxBinCount ) );
+
+    const int first = ( bin1 / factor ) * factor;
+
+    m_data->samples.reserve( ( bin2 - first ) / factor + 1 );
+
+    const quint64* counts = m_data->counts.constData();
+
+    double maxValue = 0.0;
+
+    for ( int from = first; from <= bin2; from += factor )
+    {
+        const int to = qMin( from + factor, numBins );
+
+        quint64 count = 0;
+        for ( int i = from; i < to; i++ )
+            count += counts[i];
+
+        const double value = static_cast< double >( count );
+        maxValue = qMax( maxValue, value );
+
+        const double x1 = min + from * binWidth;
+        const double x2 = ( to == numBins )
+            ? m_data->interval.maxValue() : min + to * binWidth;
+
+        m_data->samples += QwtIntervalSample( value, x1, x2 );
+    }
+
+    m_data->boundingRect = QRectF( min, 0.0,
+        m_data->interval.width(), maxValue );
+}
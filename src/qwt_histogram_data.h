@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_HISTOGRAM_DATA_H
+#define QWT_HISTOGRAM_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_samples.h"
+
+#include <qvector.h>
+
+/*!
+   \brief Interval samples, that are calculated by binning raw values
+
+   QwtHistogramData counts raw values in a fixed number of equidistant
+   base bins. Values can be added at any time - f.e. while they are
+   streaming in - without having to recalculate the counts of the
+   values, that have been added before. Large sets of values are
+   binned in concurrent threads, where each thread counts
+   into its own bins, that are summed up afterwards.
+
+   The samples, that are displayed, are calculated from the base bins:
+   when the plot passes its scales ( setRectOfInterest() ), neighboured
+   base bins are merged, so that there are not more than maxBinCount()
+   bins inside the visible interval. So zooming in shows
+   more details without having to iterate over the raw values again.
+
+   \code
+ QwtHistogramData* data = new QwtHistogramData( QwtInterval( 0.0, 10.0 ), 4096 );
+ data->addValues( values );
+
+ QwtPlotHistogram* histogram = new QwtPlotHistogram();
+ histogram->setData( data );
+   \endcode
+
+   \sa QwtPlotHistogram, QwtIntervalSample
+ */
+class QWT_EXPORT QwtHistogramData : public QwtSeriesData< QwtIntervalSample >
+{
+  public:
+    QwtHistogramData();
+    QwtHistogramData( const QwtInterval&, int numBaseBins );
+
+    virtual ~QwtHistogramData();
+
+    void setInterval( const QwtInterval&, int numBaseBins );
+    QwtInterval interval() const;
+
+    int baseBinCount() const;
+    quint64 baseCount( int index ) const;
+
+    void setMaxBinCount( int );
+    int maxBinCount() const;
+
+    void setThreadCount( uint numThreads );
+    uint threadCount() const;
+
+    void addValue( double );
+    void addValues( const double* values, size_t count );
+    void addValues( const QVector< double >& );
+
+    void clear();
+
+    quint64 totalCount() const;
+    quint64 underflowCount() const;
+    quint64 overflowCount() const;
+
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+    QRectF rectOfInterest() const;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QwtIntervalSample sample( size_t index ) const QWT_OVERRIDE;
+
+  private:
+    void updateSamples() const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -21,6 +21,7 @@
 #include <qevent.h>
 #include <qmargins.h>
 #include <qmath.h>
+#include <qpixmap.h>
 
 static QSize qwtKnobSizeHint( const QwtKnob* knob, int min )
 {
@@ -87,6 +88,9 @@ class QwtKnob::PrivateData
     double totalAngle;
 
     double mouseOffset;
+
+    // background, scale and knob without the marker
+    QPixmap pixmapCache;
 };
 
 /*!
@@ -133,6 +137,7 @@ void QwtKnob::setKnobStyle( KnobStyle knobStyle )
     if ( m_data->knobStyle != knobStyle )
     {
         m_data->knobStyle = knobStyle;
+        invalidateCache();
         update();
     }
 }
@@ -194,6 +199,7 @@ void QwtKnob::setTotalAngle ( double angle )
             0.5 * m_data->totalAngle );
 
         updateGeometry();
+        invalidateCache();
         update();
     }
 }
@@ -232,6 +238,7 @@ void QwtKnob::setNumTurns( int numTurns )
             0.5 * m_data->totalAngle );
 
         updateGeometry();
+        invalidateCache();
         update();
     }
 }
@@ -262,6 +269,7 @@ void QwtKnob::setScaleDraw( QwtRoundScaleDraw* scaleDraw )
     setTotalAngle( m_data->totalAngle );
 
     updateGeometry();
+    invalidateCache();
     update();
 }
 
@@ -435,13 +443,53 @@ void QwtKnob::changeEvent( QEvent* event )
         case QEvent::StyleChange:
         case QEvent::FontChange:
         {
+            invalidateCache();
+
             updateGeometry();
             update();
             break;
         }
+        case QEvent::PaletteChange:
+        case QEvent::EnabledChange:
+        case QEvent::LocaleChange:
+        {
+            invalidateCache();
+            update();
+            break;
+        }
         default:
             break;
     }
+
+    QwtAbstractSlider::changeEvent( event );
+}
+
+/*!
+   Invalidate the cache on resize
+   \param event Resize event
+ */
+void QwtKnob::resizeEvent( QResizeEvent* event )
+{
+    invalidateCache();
+    QwtAbstractSlider::resizeEvent( event );
+}
+
+//! Invalidate the cache, when the scale has changed
+void QwtKnob::scaleChange()
+{
+    invalidateCache();
+    QwtAbstractSlider::scaleChange();
+}
+
+/*!
+   Invalidate the cache for the parts of the knob, that don't
+   depend on the value: background, scale and knob without marker.
+
+   \sa drawKnob()
+ */
+void QwtKnob::invalidateCache()
+{
+    m_data->pixmapCache = QPixmap();
 }
 
 /*!
@@ -455,21 +503,31 @@ void QwtKnob::paintEvent( QPaintEvent* event )
     QPainter painter( this );
     painter.setClipRegion( event->region() );
 
-    QStyleOption opt;
-    opt.initFrom(this);
-    style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
+    if ( m_data->pixmapCache.isNull() )
+    {
+        m_data->pixmapCache = QwtPainter::backingStore( this, size() );
+        m_data->pixmapCache.fill( Qt::transparent );
 
-    painter.setRenderHint( QPainter::Antialiasing, true );
+        QPainter p( &m_data->pixmapCache );
+        p.setFont( font() );
+
+        QStyleOption opt;
+        opt.initFrom(this);
+        style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
+
+        p.setRenderHint( QPainter::Antialiasing, true );
 
-    if ( !knobRect.contains( event->region().boundingRect() ) )
-    {
         scaleDraw()->setRadius( 0.5 * knobRect.width() + m_data->scaleDist );
         scaleDraw()->moveCenter( knobRect.center() );
 
-        scaleDraw()->draw( &painter, palette() );
+        scaleDraw()->draw( &p, palette() );
+
+        drawKnob( &p, knobRect );
     }
 
-    drawKnob( &painter, knobRect );
+    painter.drawPixmap( 0, 0, m_data->pixmapCache );
+
+    painter.setRenderHint( QPainter::Antialiasing, true );
 
     drawMarker( &painter, knobRect,
         qwtNormalizeDegrees( scaleMap().transform( value() ) ) );
@@ -485,6 +543,10 @@ void QwtKnob::paintEvent( QPaintEvent* event )
 
    \param painter painter
    \param knobRect Bounding rectangle of the knob (without scale)
+
+   \note The knob is painted to a cache, that is reused for all values.
+         invalidateCache() has to be called, when an implementation
+         of drawKnob() changes its appearance.
  */
 void QwtKnob::drawKnob( QPainter* painter, const QRectF& knobRect ) const
 {
@@ -732,6 +794,7 @@ void QwtKnob::setAlignment( Qt::Alignment alignment )
     if ( m_data->alignment != alignment )
     {
         m_data->alignment = alignment;
+        invalidateCache();
         update();
     }
 }
@@ -773,6 +836,7 @@ void QwtKnob::setKnobWidth( int width )
         m_data->knobWidth = width;
 
         updateGeometry();
+        invalidateCache();
         update();
     }
 }
@@ -792,6 +856,7 @@ void QwtKnob::setBorderWidth( int borderWidth )
     m_data->borderWidth = qMax( borderWidth, 0 );
 
     updateGeometry();
+    invalidateCache();
     update();
 }
 
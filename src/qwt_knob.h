@@ -158,8 +158,13 @@ class QWT_EXPORT QwtKnob : public QwtAbstractSlider
 
   protected:
     virtual void paintEvent( QPaintEvent* ) QWT_OVERRIDE;
+    virtual void resizeEvent( QResizeEvent* ) QWT_OVERRIDE;
     virtual void changeEvent( QEvent* ) QWT_OVERRIDE;
 
+    virtual void scaleChange() QWT_OVERRIDE;
+
+    void invalidateCache();
+
     virtual void drawKnob( QPainter*, const QRectF& ) const;
 
     virtual void drawFocusIndicator( QPainter* ) const;
@@ -25,7 +25,7 @@ class QScrollBar;
    items might be any type of widget, but in general they will be
    a QwtLegendLabel.
 
-   \sa QwtLegendLabel, QwtPlotItem, QwtPlot
+   \sa QwtLegendLabel, QwtVirtualLegend, QwtPlotItem, QwtPlot
  */
 
 class QWT_EXPORT QwtLegend : public QwtAbstractLegend
@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_mapped_file.h"
+
+#include <qfile.h>
+#include <qnumeric.h>
+#include <qstring.h>
+
+class QwtMappedFile::PrivateData
+{
+  public:
+    QFile file;
+};
+
+/*!
+   \brief Constructor
+   \param fileName Name of the file, that is opened
+   \sa open()
+ */
+QwtMappedFile::QwtMappedFile( const QString& fileName )
+{
+    m_data = new PrivateData;
+    open( fileName );
+}
+
+//! Constructor
+QwtMappedFile::QwtMappedFile()
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor, unmapping all windows
+QwtMappedFile::~QwtMappedFile()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Open a file for reading
+
+   \param fileName File name
+   \return true, when the file could be opened
+   \sa close(), errorString()
+ */
+bool QwtMappedFile::open( const QString& fileName )
+{
+    close();
+
+    m_data->file.setFileName( fileName );
+    return m_data->file.open( QIODevice::ReadOnly );
+}
+
+/*!
+   \brief Close the file
+
+   All windows, that have been mapped, become invalid.
+ */
+void QwtMappedFile::close()
+{
+    if ( m_data->file.isOpen() )
+        m_data->file.close();
+}
+
+//! \return True, when the file is open
+bool QwtMappedFile::isOpen() const
+{
+    return m_data->file.isOpen();
+}
+
+//! \return Name of the file
+QString QwtMappedFile::fileName() const
+{
+    return m_data->file.fileName();
+}
+
+//! \return Description of the last error
+QString QwtMappedFile::errorString() const
+{
+    return m_data->file.errorString();
+}
+
+//! \return Size of the file in bytes
+qint64 QwtMappedFile::size() const
+{
+    return m_data->file.size();
+}
+
+/*!
+   \brief Map a window of the file into memory
+
+   \param offset Offset of the window in bytes
+   \param size Size of the window in bytes
+
+   \return Pointer to the window, or NULL if mapping failed
+   \sa unmap()
+ */
+const uchar* QwtMappedFile::map( qint64 offset, qint64 size )
+{
+    if ( !m_data->file.isOpen() || offset < 0 || size <= 0 )
+        return NULL;
+
+    if ( offset + size > m_data->file.size() )
+        return NULL;
+
+    return m_data->file.map( offset, size );
+}
+
+/*!
+   \brief Unmap a window, that has been mapped by map()
+   \param window Pointer to the window
+ */
+void QwtMappedFile::unmap( const uchar* window )
+{
+    if ( window && m_data->file.isOpen() )
+        m_data->file.unmap( const_cast< uchar* >( window ) );
+}
+
+/*!
+   \brief Read a single value without mapping it
+
+   This is the preferred method for accessing a couple of values
+   spread over the file - f.e when doing a binary search.
+
+   \param offset Offset of the value in bytes
+   \param type Value type
+
+   \return Value converted to double, or NaN if reading failed
+ */
+double QwtMappedFile::readValue( qint64 offset, ValueType type )
+{
+    uchar buffer[8];
+
+    const int n = valueSize( type );
+
+    QFile& file = m_data->file;
+    if ( !file.seek( offset ) ||
+        file.read( reinterpret_cast< char* >( buffer ), n ) != n )
+    {
+        return qQNaN();
+    }
+
+    return value( buffer, type );
+}
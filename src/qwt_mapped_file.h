@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_MAPPED_FILE_H
+#define QWT_MAPPED_FILE_H
+
+#include "qwt_global.h"
+
+#include <cstring>
+
+class QString;
+
+/*!
+   \brief A read only binary file, that is mapped into memory in windows
+
+   QwtMappedFile is the base for series and raster data, that are too large
+   for being loaded into memory. Instead of mapping the complete file only
+   the regions, that are needed for the current view are mapped - what keeps
+   the virtual and resident memory footprint small.
+
+   The values are expected in native byte order.
+
+   \sa QwtMappedPointData, QwtMappedRasterData
+ */
+class QWT_EXPORT QwtMappedFile
+{
+  public:
+    //! Type of the values in the file
+    enum ValueType
+    {
+        //! 16 bit signed integers
+        Int16,
+
+        //! 32 bit signed integers
+        Int32,
+
+        //! 32 bit floating point values
+        Float32,
+
+        //! 64 bit floating point values
+        Float64
+    };
+
+    explicit QwtMappedFile( const QString& fileName );
+    QwtMappedFile();
+
+    ~QwtMappedFile();
+
+    bool open( const QString& fileName );
+    void close();
+
+    bool isOpen() const;
+
+    QString fileName() const;
+    QString errorString() const;
+
+    qint64 size() const;
+
+    const uchar* map( qint64 offset, qint64 size );
+    void unmap( const uchar* );
+
+    double readValue( qint64 offset, ValueType );
+
+    static int valueSize( ValueType );
+    static double value( const uchar*, ValueType );
+
+  private:
+    Q_DISABLE_COPY( QwtMappedFile )
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+/*!
+   \brief Size of a value in bytes
+   \param type Value type
+   \return Number of bytes
+ */
+inline int QwtMappedFile::valueSize( ValueType type )
+{
+    switch( type )
+    {
+        case Int16:
+            return 2;
+
+        case Int32:
+        case Float32:
+            return 4;
+
+        default:
+            return 8;
+    }
+}
+
+/*!
+   \brief Convert a value from memory
+
+   \param data Memory of the value, that doesn't need to be aligned
+   \param type Value type
+   \return Value converted to double
+ */
+inline double QwtMappedFile::value( const uchar* data, ValueType type )
+{
+    switch( type )
+    {
+        case Int16:
+        {
+            qint16 v;
+            std::memcpy( &v, data, sizeof( v ) );
+            return v;
+        }
+        case Int32:
+        {
+            qint32 v;
+            std::memcpy( &v, data, sizeof( v ) );
+            return v;
+        }
+        case Float32:
+        {
+            float v;
+            std::memcpy( &v, data, sizeof( v ) );
+            return v;
+        }
+        default:
+        {
+            double v;
+            std::memcpy( &v, data, sizeof( v ) );
+            return v;
+        }
+    }
+}
+
+#endif
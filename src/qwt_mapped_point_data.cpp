@@ -0,0 +1,583 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_mapped_point_data.h"
+
+#include <qstring.h>
+#include <qnumeric.h>
+
+#include <limits>
+
+namespace
+{
+    class Column
+    {
+      public:
+        Column()
+            : isValid( false )
+            , type( QwtMappedFile::Float64 )
+            , offset( 0 )
+            , stride( 8 )
+            , factor( 1.0 )
+            , valueOffset( 0.0 )
+            , window( NULL )
+        {
+        }
+
+        inline double value( const uchar* data ) const
+        {
+            return factor * QwtMappedFile::value( data, type ) + valueOffset;
+        }
+
+        inline double valueAt( size_t index ) const
+        {
+            return value( window + index * stride );
+        }
+
+        quint64 available( qint64 fileSize ) const
+        {
+            const qint64 bytes = fileSize - offset;
+            if ( !isValid || bytes < QwtMappedFile::valueSize( type ) )
+                return 0;
+
+            return quint64( bytes - QwtMappedFile::valueSize( type ) ) / stride + 1;
+        }
+
+        bool isValid;
+
+        QwtMappedFile::ValueType type;
+        qint64 offset;
+        qint64 stride;
+
+        double factor;
+        double valueOffset;
+
+        const uchar* window;
+    };
+}
+
+// number of samples, that are mapped at once, when scanning the file
+static const quint64 qwtScanChunkSize = 1 << 20;
+
+class QwtMappedPointData::PrivateData
+{
+  public:
+    PrivateData()
+        : xOrigin( 0.0 )
+        , xStep( 1.0 )
+        , isSortedX( true )
+        , sampleCount( 0 )
+        , rectOfInterest( 0.0, 0.0, -1.0, -1.0 )
+        , first( 0 )
+        , size( 0 )
+    {
+    }
+
+    quint64 count() const
+    {
+        quint64 n = yColumn.available( file.size() );
+
+        if ( xColumn.isValid )
+            n = qMin( n, xColumn.available( file.size() ) );
+
+        if ( sampleCount > 0 )
+            n = qMin( n, sampleCount );
+
+        return n;
+    }
+
+    inline double x( quint64 index )
+    {
+        if ( !xColumn.isValid )
+            return xOrigin + index * xStep;
+
+        return xColumn.factor * file.readValue(
+            xColumn.offset + qint64( index ) * xColumn.stride, xColumn.type )
+            + xColumn.valueOffset;
+    }
+
+    quint64 lowerBound( double value, quint64 count )
+    {
+        // index of the first sample with x >= value
+
+        quint64 from = 0;
+        quint64 to = count;
+
+        while ( from < to )
+        {
+            const quint64 mid = from + ( to - from ) / 2;
+            if ( x( mid ) < value )
+                from = mid + 1;
+            else
+                to = mid;
+        }
+
+        return from;
+    }
+
+    const uchar* map( const Column& column, quint64 from, quint64 count )
+    {
+        if ( !column.isValid || count == 0 )
+            return NULL;
+
+        const qint64 valueSize = QwtMappedFile::valueSize( column.type );
+
+        return file.map( column.offset + qint64( from ) * column.stride,
+            qint64( count - 1 ) * column.stride + valueSize );
+    }
+
+    void unmap()
+    {
+        file.unmap( xColumn.window );
+        file.unmap( yColumn.window );
+
+        xColumn.window = yColumn.window = NULL;
+
+        first = 0;
+        size = 0;
+    }
+
+    QwtMappedFile file;
+
+    Column xColumn;
+    Column yColumn;
+
+    double xOrigin;
+    double xStep;
+
+    bool isSortedX;
+    quint64 sampleCount;
+
+    QRectF rectOfInterest;
+
+    quint64 first;
+    size_t size;
+};
+
+/*!
+   \brief Constructor
+   \param fileName Name of the file
+   \sa open()
+ */
+QwtMappedPointData::QwtMappedPointData( const QString& fileName )
+{
+    m_data = new PrivateData;
+    open( fileName );
+}
+
+//! Constructor
+QwtMappedPointData::QwtMappedPointData()
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtMappedPointData::~QwtMappedPointData()
+{
+    m_data->unmap();
+    delete m_data;
+}
+
+/*!
+   \brief Open a file
+
+   The description of the columns is not affected.
+
+   \param fileName Name of the file
+   \return true, when the file could be opened
+   \sa isOpen(), errorString()
+ */
+bool QwtMappedPointData::open( const QString& fileName )
+{
+    m_data->unmap();
+
+    const bool ok = m_data->file.open( fileName );
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateWindow();
+
+    return ok;
+}
+
+//! \return True, when the file is open
+bool QwtMappedPointData::isOpen() const
+{
+    return m_data->file.isOpen();
+}
+
+//! \return Description of the last error of the file
+QString QwtMappedPointData::errorString() const
+{
+    return m_data->file.errorString();
+}
+
+/*!
+   \brief Specify the column of the x coordinates
+
+   \param type Type of the values
+   \param offset Offset of the first value in bytes
+   \param stride Distance between two values in bytes.
+                 0 means the size of a value.
+
+   \sa setXSampling(), setYColumn(), setXScaling()
+ */
+void QwtMappedPointData::setXColumn(
+    QwtMappedFile::ValueType type, qint64 offset, qint64 stride )
+{
+    Column& column = m_data->xColumn;
+
+    column.isValid = true;
+    column.type = type;
+    column.offset = qMax( offset, qint64( 0 ) );
+    column.stride = ( stride > 0 ) ? stride : QwtMappedFile::valueSize( type );
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateWindow();
+}
+
+/*!
+   \brief Specify the column of the y coordinates
+
+   \param type Type of the values
+   \param offset Offset of the first value in bytes
+   \param stride Distance between two values in bytes.
+                 0 means the size of a value.
+
+   \sa setXColumn(), setYScaling()
+ */
+void QwtMappedPointData::setYColumn(
+    QwtMappedFile::ValueType type, qint64 offset, qint64 stride )
+{
+    Column& column = m_data->yColumn;
+
+    column.isValid = true;
+    column.type = type;
+    column.offset = qMax( offset, qint64( 0 ) );
+    column.stride = ( stride > 0 ) ? stride : QwtMappedFile::valueSize( type );
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateWindow();
+}
+
+/*!
+   \return True, when the x coordinates are read from the file
+   \sa setXColumn(), setXSampling()
+ */
+bool QwtMappedPointData::hasXColumn() const
+{
+    return m_data->xColumn.isValid;
+}
+
+/*!
+   \brief Calculate the x coordinates from the index of the samples
+
+   The x coordinate of a sample is origin + index * step. A column
+   of x coordinates, that has been specified before, is ignored.
+
+   \param origin x coordinate of the first sample
+   \param step Distance between two samples, that needs to be > 0
+
+   \sa setXColumn()
+ */
+void QwtMappedPointData::setXSampling( double origin, double step )
+{
+    m_data->xColumn.isValid = false;
+    m_data->xOrigin = origin;
+    m_data->xStep = ( step > 0.0 ) ? step : 1.0;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateWindow();
+}
+
+/*!
+   \brief Map the values of the x column to coordinates
+
+   The x coordinate is factor * value + offset. The factor needs
+   to be positive, when the x coordinates are sorted.
+
+   \param factor Scale factor
+   \param offset Offset
+   \sa setYScaling(), setXColumn()
+ */
+void QwtMappedPointData::setXScaling( double factor, double offset )
+{
+    m_data->xColumn.factor = factor;
+    m_data->xColumn.valueOffset = offset;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateWindow();
+}
+
+/*!
+   \brief Map the values of the y column to coordinates
+
+   The y coordinate is factor * value + offset, what is useful
+   for converting integer values of an ADC to physical units.
+
+   \param factor Scale factor
+   \param offset Offset
+   \sa setXScaling(), setYColumn()
+ */
+void QwtMappedPointData::setYScaling( double factor, double offset )
+{
+    m_data->yColumn.factor = factor;
+    m_data->yColumn.valueOffset = offset;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+   \brief Specify if the x coordinates are in ascending order
+
+   Only for sorted x coordinates the samples can be restricted to
+   the rectangle of interest. The default setting is true.
+
+   \param on On/Off
+   \sa isSortedX(), setRectOfInterest()
+ */
+void QwtMappedPointData::setSortedX( bool on )
+{
+    if ( on != m_data->isSortedX )
+    {
+        m_data->isSortedX = on;
+        updateWindow();
+    }
+}
+
+/*!
+   \return True, when the x coordinates are in ascending order
+   \sa setSortedX()
+ */
+bool QwtMappedPointData::isSortedX() const
+{
+    return m_data->isSortedX;
+}
+
+/*!
+   \brief Limit the number of samples
+
+   The default setting is 0, what means, that the number of samples
+   is calculated from the size of the file.
+
+   \param count Number of samples
+   \sa sampleCount()
+ */
+void QwtMappedPointData::setSampleCount( quint64 count )
+{
+    m_data->sampleCount = count;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateWindow();
+}
+
+/*!
+   \return Number of samples of the file
+   \sa setSampleCount(), size()
+ */
+quint64 QwtMappedPointData::sampleCount() const
+{
+    return m_data->count();
+}
+
+/*!
+   \brief Set the bounding rectangle of all samples
+
+   Calculating the bounding rectangle requires a scan through
+   the complete file. Applications, that know the bounding rectangle
+   in advance - f.e from the header of the file - can avoid this scan.
+
+   \param rect Bounding rectangle
+   \sa boundingRect()
+ */
+void QwtMappedPointData::setBoundingRect( const QRectF& rect )
+{
+    cachedBoundingRect = rect;
+}
+
+/*!
+   \brief Calculate the bounding rectangle of all samples of the file
+
+   Unless the rectangle has been set by setBoundingRect() the file is
+   scanned once in chunks, so that only a small part of it is mapped
+   at the same time.
+
+   \return Bounding rectangle
+   \sa setBoundingRect()
+ */
+QRectF QwtMappedPointData::boundingRect() const
+{
+    if ( cachedBoundingRect.width() >= 0.0 )
+        return cachedBoundingRect;
+
+    const quint64 count = m_data->count();
+    if ( count == 0 )
+        return QRectF( 0.0, 0.0, -1.0, -1.0 );
+
+    double minX, maxX, minY, maxY;
+    minX = minY = std::numeric_limits< double >::max();
+    maxX = maxY = -std::numeric_limits< double >::max();
+
+    if ( !m_data->xColumn.isValid )
+    {
+        minX = m_data->xOrigin;
+        maxX = m_data->xOrigin + ( count - 1 ) * m_data->xStep;
+    }
+
+    Column xColumn = m_data->xColumn;
+    Column yColumn = m_data->yColumn;
+
+    for ( quint64 from = 0; from < count; from += qwtScanChunkSize )
+    {
+        const quint64 n = qMin( qwtScanChunkSize, count - from );
+
+        xColumn.window = m_data->map( xColumn, from, n );
+        yColumn.window = m_data->map( yColumn, from, n );
+
+        if ( yColumn.window )
+        {
+            for ( size_t i = 0; i < n; i++ )
+            {
+                const double y = yColumn.valueAt( i );
+                if ( qIsNaN( y ) )
+                    continue;
+
+                minY = qMin( minY, y );
+                maxY = qMax( maxY, y );
+            }
+        }
+
+        if ( xColumn.window )
+        {
+            for ( size_t i = 0; i < n; i++ )
+            {
+                const double x = xColumn.valueAt( i );
+                if ( qIsNaN( x ) )
+                    continue;
+
+                minX = qMin( minX, x );
+                maxX = qMax( maxX, x );
+            }
+        }
+
+        m_data->file.unmap( xColumn.window );
+        m_data->file.unmap( yColumn.window );
+    }
+
+    if ( minX > maxX || minY > maxY )
+        return QRectF( 0.0, 0.0, -1.0, -1.0 );
+
+    cachedBoundingRect.setCoords( minX, minY, maxX, maxY );
+    return cachedBoundingRect;
+}
+
+/*!
+   \brief Set the "rectangle of interest"
+
+   For sorted x coordinates only the samples inside the horizontal
+   interval of the rectangle - and one more sample on each side for
+   connecting lines to the border - are mapped into memory.
+
+   \param rect Rectangle of interest
+   \sa rectOfInterest(), QwtPlotSeriesItem::updateScaleDiv()
+ */
+void QwtMappedPointData::setRectOfInterest( const QRectF& rect )
+{
+    m_data->rectOfInterest = rect;
+    updateWindow();
+}
+
+/*!
+   \return Rectangle of interest
+   \sa setRectOfInterest()
+ */
+QRectF QwtMappedPointData::rectOfInterest() const
+{
+    return m_data->rectOfInterest;
+}
+
+/*!
+   \return Index of the first mapped sample in the file
+   \sa size(), setRectOfInterest()
+ */
+quint64 QwtMappedPointData::firstIndex() const
+{
+    return m_data->first;
+}
+
+/*!
+   \return Number of samples inside the rectangle of interest
+   \sa sampleCount(), firstIndex()
+ */
+size_t QwtMappedPointData::size() const
+{
+    return m_data->size;
+}
+
+/*!
+   \brief Return a sample
+
+   \param index Index relative to firstIndex()
+   \return Sample at position index
+ */
+QPointF QwtMappedPointData::sample( size_t index ) const
+{
+    const PrivateData* d = m_data;
+
+    const double x = d->xColumn.window ? d->xColumn.valueAt( index )
+        : d->xOrigin + ( d->first + index ) * d->xStep;
+
+    return QPointF( x, d->yColumn.valueAt( index ) );
+}
+
+void QwtMappedPointData::updateWindow()
+{
+    m_data->unmap();
+
+    const quint64 count = m_data->count();
+    if ( count == 0 )
+        return;
+
+    quint64 from = 0;
+    quint64 to = count;
+
+    const QRectF& rect = m_data->rectOfInterest;
+    if ( m_data->isSortedX && rect.width() >= 0.0 )
+    {
+        from = m_data->lowerBound( rect.left(), count );
+        to = m_data->lowerBound( rect.right(), count );
+
+        // including the neighbours outside the rectangle
+
+        if ( from > 0 )
+            from--;
+
+        to = qMin( to + 1, count );
+    }
+
+    if ( from >= to )
+        return;
+
+    const quint64 n = to - from;
+
+    Column& xColumn = m_data->xColumn;
+    Column& yColumn = m_data->yColumn;
+
+    yColumn.window = m_data->map( yColumn, from, n );
+    if ( xColumn.isValid )
+        xColumn.window = m_data->map( xColumn, from, n );
+
+    if ( yColumn.window == NULL || ( xColumn.isValid && xColumn.window == NULL ) )
+    {
+        m_data->unmap();
+        return;
+    }
+
+    m_data->first = from;
+    m_data->size = static_cast< size_t >( n );
+}
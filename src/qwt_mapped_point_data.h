@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_MAPPED_POINT_DATA_H
+#define QWT_MAPPED_POINT_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_mapped_file.h"
+
+class QString;
+
+/*!
+   \brief Point data, that is read from a binary file, that is mapped into memory
+
+   QwtMappedPointData displays recordings, that are too large for being
+   loaded into memory. The x and y coordinates are read from columns
+   of the file, where each column is described by the type of its values,
+   the offset of the first value and the distance between two values
+   ( stride ). Interleaved records as well as separate blocks of values
+   are supported. When no x column is specified the x coordinates are
+   calculated from the index of the sample.
+
+   When the x coordinates are in ascending order, setRectOfInterest() finds
+   the samples inside the visible interval by a binary search and maps
+   only this window of the file into memory. As QwtPlotSeriesItem passes the
+   scales of the plot to the data, QwtPlotCurve iterates over the visible
+   samples only. Combined with QwtPlotCurve::FilterPointsAggressive
+   the costs of a replot depend on the size of the canvas more than on the
+   size of the file.
+
+   \code
+ // interleaved records of 2 float32 channels, sampled with 1kHz
+ QwtMappedPointData* data = new QwtMappedPointData( "recording.bin" );
+ data->setXSampling( 0.0, 0.001 );
+ data->setYColumn( QwtMappedFile::Float32, 4, 8 );
+
+ curve->setData( data );
+   \endcode
+
+   \sa QwtMappedFile, QwtMappedRasterData
+ */
+class QWT_EXPORT QwtMappedPointData : public QwtSeriesData< QPointF >
+{
+  public:
+    explicit QwtMappedPointData( const QString& fileName );
+    QwtMappedPointData();
+
+    virtual ~QwtMappedPointData();
+
+    bool open( const QString& fileName );
+    bool isOpen() const;
+
+    QString errorString() const;
+
+    void setXColumn( QwtMappedFile::ValueType, qint64 offset, qint64 stride = 0 );
+    void setYColumn( QwtMappedFile::ValueType, qint64 offset, qint64 stride = 0 );
+
+    bool hasXColumn() const;
+
+    void setXSampling( double origin, double step );
+
+    void setXScaling( double factor, double offset = 0.0 );
+    void setYScaling( double factor, double offset = 0.0 );
+
+    void setSortedX( bool );
+    bool isSortedX() const;
+
+    void setSampleCount( quint64 );
+    quint64 sampleCount() const;
+
+    void setBoundingRect( const QRectF& );
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+    QRectF rectOfInterest() const;
+
+    quint64 firstIndex() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+  private:
+    void updateWindow();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,373 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_mapped_raster_data.h"
+#include "qwt_interval.h"
+
+#include <qnumeric.h>
+#include <qstring.h>
+#include <qrect.h>
+
+#include <cmath>
+#include <limits>
+
+class QwtMappedRasterData::PrivateData
+{
+  public:
+    PrivateData()
+        : type( QwtMappedFile::Float64 )
+        , offset( 0 )
+        , numColumns( 0 )
+        , numRows( 0 )
+        , rowCount( 0 )
+        , factor( 1.0 )
+        , valueOffset( 0.0 )
+        , window( NULL )
+        , firstRow( 0 )
+        , windowRows( 0 )
+    {
+    }
+
+    qint64 rowSize() const
+    {
+        return qint64( numColumns ) * QwtMappedFile::valueSize( type );
+    }
+
+    int effectiveRows() const
+    {
+        if ( numColumns <= 0 || !file.isOpen() )
+            return 0;
+
+        const qint64 available = ( file.size() - offset ) / rowSize();
+        if ( available <= 0 )
+            return 0;
+
+        if ( numRows > 0 )
+            return int( qMin( available, qint64( numRows ) ) );
+
+        return int( qMin( available, qint64( std::numeric_limits< int >::max() ) ) );
+    }
+
+    inline double rowPosition( double y ) const
+    {
+        const QwtInterval& yInterval = intervals[Qt::YAxis];
+        return ( y - yInterval.minValue() ) / yInterval.width() * rowCount;
+    }
+
+    bool mapRows( const QRectF& area )
+    {
+        // mapping the rows, that intersect the area
+
+        unmap();
+
+        if ( rowCount <= 0 || intervals[Qt::YAxis].width() <= 0.0 )
+            return false;
+
+        const double top = rowPosition( area.top() );
+        const double bottom = rowPosition( area.bottom() );
+
+        const int from = qBound( 0, int( std::floor( qMin( top, bottom ) ) ), rowCount - 1 );
+        const int to = qBound( 0, int( std::floor( qMax( top, bottom ) ) ), rowCount - 1 );
+
+        window = file.map( offset + from * rowSize(), ( to - from + 1 ) * rowSize() );
+        if ( window == NULL )
+            return false;
+
+        firstRow = from;
+        windowRows = to - from + 1;
+
+        return true;
+    }
+
+    void unmap()
+    {
+        file.unmap( window );
+
+        window = NULL;
+        firstRow = windowRows = 0;
+    }
+
+    QwtMappedFile file;
+
+    QwtMappedFile::ValueType type;
+    qint64 offset;
+    int numColumns;
+    int numRows;
+    int rowCount;
+
+    double factor;
+    double valueOffset;
+
+    QwtInterval intervals[3];
+
+    const uchar* window;
+    int firstRow;
+    int windowRows;
+};
+
+/*!
+   \brief Constructor
+   \param fileName Name of the file
+   \sa open(), setMatrix()
+ */
+QwtMappedRasterData::QwtMappedRasterData( const QString& fileName )
+{
+    m_data = new PrivateData;
+    open( fileName );
+}
+
+//! Constructor
+QwtMappedRasterData::QwtMappedRasterData()
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtMappedRasterData::~QwtMappedRasterData()
+{
+    m_data->unmap();
+    delete m_data;
+}
+
+/*!
+   \brief Open a file
+
+   The description of the matrix is not affected.
+
+   \param fileName Name of the file
+   \return true, when the file could be opened
+   \sa isOpen(), errorString()
+ */
+bool QwtMappedRasterData::open( const QString& fileName )
+{
+    m_data->unmap();
+
+    const bool ok = m_data->file.open( fileName );
+    m_data->rowCount = m_data->effectiveRows();
+
+    return ok;
+}
+
+//! \return True, when the file is open
+bool QwtMappedRasterData::isOpen() const
+{
+    return m_data->file.isOpen();
+}
+
+//! \return Description of the last error of the file
+QString QwtMappedRasterData::errorString() const
+{
+    return m_data->file.errorString();
+}
+
+/*!
+   \brief Describe the layout of the matrix in the file
+
+   The values are stored row by row without any gaps.
+
+   \param type Type of the values
+   \param offset Offset of the first value in bytes
+   \param numColumns Number of columns
+   \param numRows Number of rows. 0 means, that the number of rows
+                  is calculated from the size of the file.
+
+   \sa numColumns(), numRows(), setValueScaling()
+ */
+void QwtMappedRasterData::setMatrix( QwtMappedFile::ValueType type,
+    qint64 offset, int numColumns, int numRows )
+{
+    m_data->unmap();
+
+    m_data->type = type;
+    m_data->offset = qMax( offset, qint64( 0 ) );
+    m_data->numColumns = qMax( numColumns, 0 );
+    m_data->numRows = qMax( numRows, 0 );
+
+    m_data->rowCount = m_data->effectiveRows();
+}
+
+/*!
+   \return Type of the values
+   \sa setMatrix()
+ */
+QwtMappedFile::ValueType QwtMappedRasterData::valueType() const
+{
+    return m_data->type;
+}
+
+/*!
+   \return Number of columns of the matrix
+   \sa setMatrix(), numRows()
+ */
+int QwtMappedRasterData::numColumns() const
+{
+    return m_data->numColumns;
+}
+
+/*!
+   \return Number of rows of the matrix, that are available in the file
+   \sa setMatrix(), numColumns()
+ */
+int QwtMappedRasterData::numRows() const
+{
+    return m_data->rowCount;
+}
+
+/*!
+   \brief Map the values of the file to physical units
+
+   The value is factor * value + offset.
+
+   \param factor Scale factor
+   \param offset Offset
+ */
+void QwtMappedRasterData::setValueScaling( double factor, double offset )
+{
+    m_data->factor = factor;
+    m_data->valueOffset = offset;
+}
+
+/*!
+   \brief Assign the bounding interval for an axis
+
+   \param axis X, Y or Z axis
+   \param interval Interval
+
+   \sa interval()
+ */
+void QwtMappedRasterData::setInterval(
+    Qt::Axis axis, const QwtInterval& interval )
+{
+    if ( axis >= 0 && axis <= 2 )
+        m_data->intervals[axis] = interval;
+}
+
+/*!
+   \return Bounding interval for an axis
+   \sa setInterval()
+ */
+QwtInterval QwtMappedRasterData::interval( Qt::Axis axis ) const
+{
+    if ( axis >= 0 && axis <= 2 )
+        return m_data->intervals[axis];
+
+    return QwtInterval();
+}
+
+/*!
+   \brief Pixel hint
+
+   Returns the geometry of the cell of the matrix, that is
+   located at the center of the area.
+
+   \param area Requested area
+   \return Bounding rectangle of a cell
+ */
+QRectF QwtMappedRasterData::pixelHint( const QRectF& area ) const
+{
+    if ( m_data->numColumns <= 0 || m_data->rowCount <= 0 )
+        return QRectF();
+
+    const QwtInterval& xInterval = m_data->intervals[Qt::XAxis];
+    const QwtInterval& yInterval = m_data->intervals[Qt::YAxis];
+
+    const double dx = xInterval.width() / m_data->numColumns;
+    const double dy = yInterval.width() / m_data->rowCount;
+
+    if ( dx <= 0.0 || dy <= 0.0 )
+        return QRectF();
+
+    const double x = xInterval.minValue()
+        + std::floor( ( area.center().x() - xInterval.minValue() ) / dx ) * dx;
+
+    const double y = yInterval.minValue()
+        + std::floor( ( area.center().y() - yInterval.minValue() ) / dy ) * dy;
+
+    return QRectF( x, y, dx, dy );
+}
+
+/*!
+   \brief Map the rows, that intersect the area
+
+   \param area Area, that is rendered
+   \param raster Size of the image, ignored
+
+   \sa discardRaster()
+ */
+void QwtMappedRasterData::initRaster( const QRectF& area, const QSize& raster )
+{
+    Q_UNUSED( raster );
+    m_data->mapRows( area );
+}
+
+/*!
+   \brief Unmap the rows, that have been mapped by initRaster()
+   \sa initRaster()
+ */
+void QwtMappedRasterData::discardRaster()
+{
+    m_data->unmap();
+}
+
+/*!
+   \return the value at a raster position
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+
+   \note Outside of the rows, that have been mapped by
+         initRaster() NaN is returned.
+ */
+double QwtMappedRasterData::value( double x, double y ) const
+{
+    const PrivateData* d = m_data;
+
+    const QwtInterval& xInterval = d->intervals[Qt::XAxis];
+    if ( d->window == NULL || !xInterval.contains( x )
+        || xInterval.width() <= 0.0 || !d->intervals[Qt::YAxis].contains( y ) )
+    {
+        return qQNaN();
+    }
+
+    const int row = qMin( int( d->rowPosition( y ) ), d->rowCount - 1 ) - d->firstRow;
+    if ( row < 0 || row >= d->windowRows )
+        return qQNaN();
+
+    const int col = qMin( int( ( x - xInterval.minValue() )
+        / xInterval.width() * d->numColumns ), d->numColumns - 1 );
+
+    const uchar* value = d->window
+        + ( qint64( row ) * d->numColumns + col ) * QwtMappedFile::valueSize( d->type );
+
+    return d->factor * QwtMappedFile::value( value, d->type ) + d->valueOffset;
+}
+
+/*!
+   \brief Calculate contour lines
+
+   The rows, that intersect rect, are mapped temporarily, when they
+   have not been mapped by initRaster() before.
+
+   \sa QwtRasterData::contourLines()
+ */
+QwtRasterData::ContourLines QwtMappedRasterData::contourLines(
+    const QRectF& rect, const QSize& raster,
+    const QList< double >& levels, ConrecFlags flags ) const
+{
+    if ( m_data->window )
+        return QwtRasterData::contourLines( rect, raster, levels, flags );
+
+    m_data->mapRows( rect );
+
+    const ContourLines lines =
+        QwtRasterData::contourLines( rect, raster, levels, flags );
+
+    m_data->unmap();
+
+    return lines;
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_MAPPED_RASTER_DATA_H
+#define QWT_MAPPED_RASTER_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_raster_data.h"
+#include "qwt_mapped_file.h"
+
+class QString;
+
+/*!
+   \brief Raster data, that is read from a binary file, that is mapped into memory
+
+   QwtMappedRasterData displays a matrix of values, that is stored row by row
+   in a file, that is too large for being loaded into memory. Instead of
+   mapping the complete file only the rows, that intersect the area of
+   a raster, are mapped in initRaster() and released in discardRaster().
+   So the resident memory of a process displaying a zoomed in
+   area of the matrix depends on the size of this area only.
+
+   The values are looked up by nearest neighbour. The columns are spread
+   equidistantly over the interval of the x axis, the rows over the interval
+   of the y axis. Values can be converted to physical units by setValueScaling().
+
+   \sa QwtMappedFile, QwtMappedPointData, QwtMatrixRasterData
+ */
+class QWT_EXPORT QwtMappedRasterData : public QwtRasterData
+{
+  public:
+    explicit QwtMappedRasterData( const QString& fileName );
+    QwtMappedRasterData();
+
+    virtual ~QwtMappedRasterData();
+
+    bool open( const QString& fileName );
+    bool isOpen() const;
+
+    QString errorString() const;
+
+    void setMatrix( QwtMappedFile::ValueType, qint64 offset,
+        int numColumns, int numRows = 0 );
+
+    QwtMappedFile::ValueType valueType() const;
+    int numColumns() const;
+    int numRows() const;
+
+    void setValueScaling( double factor, double offset = 0.0 );
+
+    void setInterval( Qt::Axis, const QwtInterval& );
+    virtual QwtInterval interval( Qt::Axis ) const QWT_OVERRIDE;
+
+    virtual QRectF pixelHint( const QRectF& ) const QWT_OVERRIDE;
+
+    virtual void initRaster( const QRectF&, const QSize& raster ) QWT_OVERRIDE;
+    virtual void discardRaster() QWT_OVERRIDE;
+
+    virtual double value( double x, double y ) const QWT_OVERRIDE;
+
+    virtual ContourLines contourLines( const QRectF& rect,
+        const QSize& raster, const QList< double >& levels,
+        ConrecFlags ) const QWT_OVERRIDE;
+
+  private:
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -14,6 +14,8 @@
 #include <qnumeric.h>
 #include <qrect.h>
 
+#include <limits>
+
 static inline double qwtHermiteInterpolate(
     double A, double B, double C, double D, double t )
 {
@@ -43,24 +45,238 @@ static inline double qwtBicubicInterpolate(
     return qwtHermiteInterpolate( v0, v1, v2, v3, dy );
 }
 
+template< typename T >
+static inline void qwtSetMatrixValue( QVector< T >& values, int index, double value )
+{
+    // out of range values are clipped to the limits of T
+    const double v = qBound( double( std::numeric_limits< T >::min() ),
+        value, double( std::numeric_limits< T >::max() ) );
+
+    values.data()[ index ] = static_cast< T >( qRound( v ) );
+}
+
+static inline void qwtSetMatrixValue( QVector< double >& values, int index, double value )
+{
+    values.data()[ index ] = value;
+}
+
+static inline void qwtSetMatrixValue( QVector< float >& values, int index, double value )
+{
+    values.data()[ index ] = static_cast< float >( value );
+}
+
+template< typename T >
+static inline QVector< double > qwtToDoubles( const QVector< T >& values )
+{
+    QVector< double > doubles( values.size() );
+    for ( int i = 0; i < values.size(); i++ )
+        doubles[i] = values[i];
+
+    return doubles;
+}
+
 class QwtMatrixRasterData::PrivateData
 {
   public:
+    enum ValueType
+    {
+        Double,
+        Float,
+        Int16,
+        UInt16
+    };
+
     PrivateData()
         : resampleMode( QwtMatrixRasterData::NearestNeighbour )
+        , valueType( Double )
         , numColumns(0)
     {
     }
 
-    inline double value(int row, int col) const
+    void clearValues()
+    {
+        values.clear();
+        floatValues.clear();
+        int16Values.clear();
+        uint16Values.clear();
+    }
+
+    int numValues() const
+    {
+        switch( valueType )
+        {
+            case Float:
+                return floatValues.size();
+            case Int16:
+                return int16Values.size();
+            case UInt16:
+                return uint16Values.size();
+            default:
+                return values.size();
+        }
+    }
+
+    template< typename T >
+    inline double valueAt( const T* matrix, int row, int col ) const
+    {
+        return matrix[ row * numColumns + col ];
+    }
+
+    template< typename T >
+    double resampledValue( const T* matrix, double x, double y ) const
     {
-        return values.data()[ row * numColumns + col ];
+        const QwtInterval& xInterval = intervals[Qt::XAxis];
+        const QwtInterval& yInterval = intervals[Qt::YAxis];
+
+        if ( !( xInterval.contains(x) && yInterval.contains(y) ) )
+            return qQNaN();
+
+        double value;
+
+        switch( resampleMode )
+        {
+            case BicubicInterpolation:
+            {
+                const double colF = ( x - xInterval.minValue() ) / dx;
+                const double rowF = ( y - yInterval.minValue() ) / dy;
+
+                const int col = qRound( colF );
+                const int row = qRound( rowF );
+
+                int col0 = col - 2;
+                int col1 = col - 1;
+                int col2 = col;
+                int col3 = col + 1;
+
+                if ( col1 < 0 )
+                    col1 = col2;
+
+                if ( col0 < 0 )
+                    col0 = col1;
+
+                if ( col2 >= numColumns )
+                    col2 = col1;
+
+                if ( col3 >= numColumns )
+                    col3 = col2;
+
+                int row0 = row - 2;
+                int row1 = row - 1;
+                int row2 = row;
+                int row3 = row + 1;
+
+                if ( row1 < 0 )
+                    row1 = row2;
+
+                if ( row0 < 0 )
+                    row0 = row1;
+
+                if ( row2 >= numRows )
+                    row2 = row1;
+
+                if ( row3 >= numRows )
+                    row3 = row2;
+
+                // First row
+                const double v00 = valueAt( matrix, row0, col0 );
+                const double v10 = valueAt( matrix, row0, col1 );
+                const double v20 = valueAt( matrix, row0, col2 );
+                const double v30 = valueAt( matrix, row0, col3 );
+
+                // Second row
+                const double v01 = valueAt( matrix, row1, col0 );
+                const double v11 = valueAt( matrix, row1, col1 );
+                const double v21 = valueAt( matrix, row1, col2 );
+                const double v31 = valueAt( matrix, row1, col3 );
+
+                // Third row
+                const double v02 = valueAt( matrix, row2, col0 );
+                const double v12 = valueAt( matrix, row2, col1 );
+                const double v22 = valueAt( matrix, row2, col2 );
+                const double v32 = valueAt( matrix, row2, col3 );
+
+                // Fourth row
+                const double v03 = valueAt( matrix, row3, col0 );
+                const double v13 = valueAt( matrix, row3, col1 );
+                const double v23 = valueAt( matrix, row3, col2 );
+                const double v33 = valueAt( matrix, row3, col3 );
+
+                value = qwtBicubicInterpolate(
+                    v00, v10, v20, v30, v01, v11, v21, v31,
+                    v02, v12, v22, v32, v03, v13, v23, v33,
+                    colF - col + 0.5, rowF - row + 0.5 );
+
+                break;
+            }
+            case BilinearInterpolation:
+            {
+                int col1 = qRound( ( x - xInterval.minValue() ) / dx ) - 1;
+                int row1 = qRound( ( y - yInterval.minValue() ) / dy ) - 1;
+                int col2 = col1 + 1;
+                int row2 = row1 + 1;
+
+                if ( col1 < 0 )
+                    col1 = col2;
+                else if ( col2 >= numColumns )
+                    col2 = col1;
+
+                if ( row1 < 0 )
+                    row1 = row2;
+                else if ( row2 >= numRows )
+                    row2 = row1;
+
+                const double v11 = valueAt( matrix, row1, col1 );
+                const double v21 = valueAt( matrix, row1, col2 );
+                const double v12 = valueAt( matrix, row2, col1 );
+                const double v22 = valueAt( matrix, row2, col2 );
+
+                const double x2 = xInterval.minValue() + ( col2 + 0.5 ) * dx;
+                const double y2 = yInterval.minValue() + ( row2 + 0.5 ) * dy;
+
+                const double rx = ( x2 - x ) / dx;
+                const double ry = ( y2 - y ) / dy;
+
+                const double vr1 = rx * v11 + ( 1.0 - rx ) * v21;
+                const double vr2 = rx * v12 + ( 1.0 - rx ) * v22;
+
+                value = ry * vr1 + ( 1.0 - ry ) * vr2;
+
+                break;
+            }
+            case NearestNeighbour:
+            default:
+            {
+                int row = int( ( y - yInterval.minValue() ) / dy );
+                int col = int( ( x - xInterval.minValue() ) / dx );
+
+                // In case of intervals, where the maximum is included
+                // we get out of bound for row/col, when the value for the
+                // maximum is requested. Instead we return the value
+                // from the last row/col
+
+                if ( row >= numRows )
+                    row = numRows - 1;
+
+                if ( col >= numColumns )
+                    col = numColumns - 1;
+
+                value = valueAt( matrix, row, col );
+            }
+        }
+
+        return value;
     }
 
     QwtInterval intervals[3];
     QwtMatrixRasterData::ResampleMode resampleMode;
 
+    ValueType valueType;
+
     QVector< double > values;
+    QVector< float > floatValues;
+    QVector< qint16 > int16Values;
+    QVector< quint16 > uint16Values;
+
     int numColumns;
     int numRows;
 
@@ -155,18 +371,103 @@ QwtInterval QwtMatrixRasterData::interval( Qt::Axis axis ) const
 void QwtMatrixRasterData::setValueMatrix(
     const QVector< double >& values, int numColumns )
 {
+    m_data->clearValues();
+
+    m_data->valueType = PrivateData::Double;
     m_data->values = values;
     m_data->numColumns = qMax( numColumns, 0 );
     update();
 }
 
+/*!
+   \brief Assign a value matrix of 32 bit floating point values
+
+   The values are stored and resampled as float, what needs half
+   of the memory of a matrix of doubles.
+
+   \param values Vector of values
+   \param numColumns Number of columns
+
+   \sa setValueMatrix( const QVector< double >&, int )
+ */
+void QwtMatrixRasterData::setValueMatrix(
+    const QVector< float >& values, int numColumns )
+{
+    m_data->clearValues();
+
+    m_data->valueType = PrivateData::Float;
+    m_data->floatValues = values;
+    m_data->numColumns = qMax( numColumns, 0 );
+    update();
+}
+
+/*!
+   \brief Assign a value matrix of 16 bit signed integers
+
+   The values are stored and resampled as qint16, what needs a quarter
+   of the memory of a matrix of doubles.
+
+   \param values Vector of values
+   \param numColumns Number of columns
+
+   \sa setValueMatrix( const QVector< double >&, int )
+ */
+void QwtMatrixRasterData::setValueMatrix(
+    const QVector< qint16 >& values, int numColumns )
+{
+    m_data->clearValues();
+
+    m_data->valueType = PrivateData::Int16;
+    m_data->int16Values = values;
+    m_data->numColumns = qMax( numColumns, 0 );
+    update();
+}
+
+/*!
+   \brief Assign a value matrix of 16 bit unsigned integers
+
+   The values are stored and resampled as quint16, what needs a quarter
+   of the memory of a matrix of doubles.
+
+   \param values Vector of values
+   \param numColumns Number of columns
+
+   \sa setValueMatrix( const QVector< double >&, int )
+ */
+void QwtMatrixRasterData::setValueMatrix(
+    const QVector< quint16 >& values, int numColumns )
+{
+    m_data->clearValues();
+
+    m_data->valueType = PrivateData::UInt16;
+    m_data->uint16Values = values;
+    m_data->numColumns = qMax( numColumns, 0 );
+    update();
+}
+
 /*!
    \return Value matrix
+   \note When the matrix has been assigned in a type different from double
+         a converted copy is returned.
+
    \sa setValueMatrix(), numColumns(), numRows(), setInterval()
  */
 const QVector< double > QwtMatrixRasterData::valueMatrix() const
 {
-    return m_data->values;
+    switch( m_data->valueType )
+    {
+        case PrivateData::Float:
+            return qwtToDoubles( m_data->floatValues );
+
+        case PrivateData::Int16:
+            return qwtToDoubles( m_data->int16Values );
+
+        case PrivateData::UInt16:
+            return qwtToDoubles( m_data->uint16Values );
+
+        default:
+            return m_data->values;
+    }
 }
 
 /*!
@@ -174,7 +475,7 @@ const QVector< double > QwtMatrixRasterData::valueMatrix() const
 
    \param row Row index
    \param col Column index
-   \param value New value
+   \param value New value, that is converted to the type of the matrix
 
    \sa value(), setValueMatrix()
  */
@@ -184,7 +485,24 @@ void QwtMatrixRasterData::setValue( int row, int col, double value )
         col >= 0 && col < m_data->numColumns )
     {
         const int index = row * m_data->numColumns + col;
-        m_data->values.data()[ index ] = value;
+
+        switch( m_data->valueType )
+        {
+            case PrivateData::Float:
+                qwtSetMatrixValue( m_data->floatValues, index, value );
+                break;
+
+            case PrivateData::Int16:
+                qwtSetMatrixValue( m_data->int16Values, index, value );
+                break;
+
+            case PrivateData::UInt16:
+                qwtSetMatrixValue( m_data->uint16Values, index, value );
+                break;
+
+            default:
+                qwtSetMatrixValue( m_data->values, index, value );
+        }
     }
 }
 
@@ -255,146 +573,22 @@ QRectF QwtMatrixRasterData::pixelHint( const QRectF& area ) const
  */
 double QwtMatrixRasterData::value( double x, double y ) const
 {
-    const QwtInterval xInterval = interval( Qt::XAxis );
-    const QwtInterval yInterval = interval( Qt::YAxis );
+    const PrivateData* d = m_data;
 
-    if ( !( xInterval.contains(x) && yInterval.contains(y) ) )
-        return qQNaN();
-
-    double value;
-
-    switch( m_data->resampleMode )
+    switch( d->valueType )
     {
-        case BicubicInterpolation:
-        {
-            const double colF = ( x - xInterval.minValue() ) / m_data->dx;
-            const double rowF = ( y - yInterval.minValue() ) / m_data->dy;
-
-            const int col = qRound( colF );
-            const int row = qRound( rowF );
+        case PrivateData::Float:
+            return d->resampledValue( d->floatValues.constData(), x, y );
 
-            int col0 = col - 2;
-            int col1 = col - 1;
-            int col2 = col;
-            int col3 = col + 1;
+        case PrivateData::Int16:
+            return d->resampledValue( d->int16Values.constData(), x, y );
 
-            if ( col1 < 0 )
-                col1 = col2;
+        case PrivateData::UInt16:
+            return d->resampledValue( d->uint16Values.constData(), x, y );
 
-            if ( col0 < 0 )
-                col0 = col1;
-
-            if ( col2 >= m_data->numColumns )
-                col2 = col1;
-
-            if ( col3 >= m_data->numColumns )
-                col3 = col2;
-
-            int row0 = row - 2;
-            int row1 = row - 1;
-            int row2 = row;
-            int row3 = row + 1;
-
-            if ( row1 < 0 )
-                row1 = row2;
-
-            if ( row0 < 0 )
-                row0 = row1;
-
-            if ( row2 >= m_data->numRows )
-                row2 = row1;
-
-            if ( row3 >= m_data->numRows )
-                row3 = row2;
-
-            // First row
-            const double v00 = m_data->value( row0, col0 );
-            const double v10 = m_data->value( row0, col1 );
-            const double v20 = m_data->value( row0, col2 );
-            const double v30 = m_data->value( row0, col3 );
-
-            // Second row
-            const double v01 = m_data->value( row1, col0 );
-            const double v11 = m_data->value( row1, col1 );
-            const double v21 = m_data->value( row1, col2 );
-            const double v31 = m_data->value( row1, col3 );
-
-            // Third row
-            const double v02 = m_data->value( row2, col0 );
-            const double v12 = m_data->value( row2, col1 );
-            const double v22 = m_data->value( row2, col2 );
-            const double v32 = m_data->value( row2, col3 );
-
-            // Fourth row
-            const double v03 = m_data->value( row3, col0 );
-            const double v13 = m_data->value( row3, col1 );
-            const double v23 = m_data->value( row3, col2 );
-            const double v33 = m_data->value( row3, col3 );
-
-            value = qwtBicubicInterpolate(
-                v00, v10, v20, v30, v01, v11, v21, v31,
-                v02, v12, v22, v32, v03, v13, v23, v33,
-                colF - col + 0.5, rowF - row + 0.5 );
-
-            break;
-        }
-        case BilinearInterpolation:
-        {
-            int col1 = qRound( ( x - xInterval.minValue() ) / m_data->dx ) - 1;
-            int row1 = qRound( ( y - yInterval.minValue() ) / m_data->dy ) - 1;
-            int col2 = col1 + 1;
-            int row2 = row1 + 1;
-
-            if ( col1 < 0 )
-                col1 = col2;
-            else if ( col2 >= m_data->numColumns )
-                col2 = col1;
-
-            if ( row1 < 0 )
-                row1 = row2;
-            else if ( row2 >= m_data->numRows )
-                row2 = row1;
-
-            const double v11 = m_data->value( row1, col1 );
-            const double v21 = m_data->value( row1, col2 );
-            const double v12 = m_data->value( row2, col1 );
-            const double v22 = m_data->value( row2, col2 );
-
-            const double x2 = xInterval.minValue() + ( col2 + 0.5 ) * m_data->dx;
-            const double y2 = yInterval.minValue() + ( row2 + 0.5 ) * m_data->dy;
-
-            const double rx = ( x2 - x ) / m_data->dx;
-            const double ry = ( y2 - y ) / m_data->dy;
-
-            const double vr1 = rx * v11 + ( 1.0 - rx ) * v21;
-            const double vr2 = rx * v12 + ( 1.0 - rx ) * v22;
-
-            value = ry * vr1 + ( 1.0 - ry ) * vr2;
-
-            break;
-        }
-        case NearestNeighbour:
         default:
-        {
-            int row = int( ( y - yInterval.minValue() ) / m_data->dy );
-            int col = int( ( x - xInterval.minValue() ) / m_data->dx );
-
-            // In case of intervals, where the maximum is included
-            // we get out of bound for row/col, when the value for the
-            // maximum is requested. Instead we return the value
-            // from the last row/col
-
-            if ( row >= m_data->numRows )
-                row = m_data->numRows - 1;
-
-            if ( col >= m_data->numColumns )
-                col = m_data->numColumns - 1;
-
-            value = m_data->value( row, col );
-        }
+            return d->resampledValue( d->values.constData(), x, y );
     }
-
-    return value;
 }
 
 void QwtMatrixRasterData::update()
@@ -405,7 +599,7 @@ void QwtMatrixRasterData::update()
 
     if ( m_data->numColumns > 0 )
     {
-        m_data->numRows = m_data->values.size() / m_data->numColumns;
+        m_data->numRows = m_data->numValues() / m_data->numColumns;
 
         const QwtInterval xInterval = interval( Qt::XAxis );
         const QwtInterval yInterval = interval( Qt::YAxis );
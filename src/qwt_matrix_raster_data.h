@@ -24,6 +24,10 @@ template< typename T > class QVector;
    equidistant values, that can be used by a QwtPlotRasterItem.
    It implements a couple of resampling algorithms, to provide
    values for positions, that or not on the value matrix.
+
+   Beside doubles the matrix can be stored as float, qint16 or quint16
+   values, that are resampled without being converted to a matrix
+   of doubles.
  */
 class QWT_EXPORT QwtMatrixRasterData : public QwtRasterData
 {
@@ -63,6 +67,9 @@ class QWT_EXPORT QwtMatrixRasterData : public QwtRasterData
     virtual QwtInterval interval( Qt::Axis axis) const QWT_OVERRIDE QWT_FINAL;
 
     void setValueMatrix( const QVector< double >& values, int numColumns );
+    void setValueMatrix( const QVector< float >& values, int numColumns );
+    void setValueMatrix( const QVector< qint16 >& values, int numColumns );
+    void setValueMatrix( const QVector< quint16 >& values, int numColumns );
     const QVector< double > valueMatrix() const;
 
     void setValue( int row, int col, double value );
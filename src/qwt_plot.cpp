@@ -15,12 +15,14 @@
 #include "qwt_scale_map.h"
 #include "qwt_text_label.h"
 #include "qwt_legend.h"
+#include "qwt_virtual_legend.h"
 #include "qwt_legend_data.h"
 #include "qwt_plot_canvas.h"
 #include "qwt_math.h"
 
 #include <qpainter.h>
 #include <qpointer.h>
+#include <qset.h>
 #include <qapplication.h>
 #include <qcoreevent.h>
 
@@ -84,6 +86,30 @@ static void qwtSetTabOrder(
     }
 }
 
+template< class Legend >
+static void qwtAdjustLegendColumns(
+    Legend* legend, QwtPlot::LegendPosition pos )
+{
+    switch ( pos )
+    {
+        case QwtPlot::LeftLegend:
+        case QwtPlot::RightLegend:
+        {
+            if ( legend->maxColumns() == 0 )
+                legend->setMaxColumns( 1 ); // 1 column: align vertical
+            break;
+        }
+        case QwtPlot::TopLegend:
+        case QwtPlot::BottomLegend:
+        {
+            legend->setMaxColumns( 0 ); // unlimited
+            break;
+        }
+        default:
+            break;
+    }
+}
+
 class QwtPlot::PrivateData
 {
   public:
@@ -94,6 +120,12 @@ class QwtPlot::PrivateData
     QwtPlotLayout* layout;
 
     bool autoReplot;
+
+    // pending operations of beginUpdate()/endUpdate()
+
+    int updateDepth;
+    bool replotPending;
+    QSet< const QwtPlotItem* > legendPending;
 };
 
 /*!
@@ -139,6 +171,9 @@ void QwtPlot::initPlot( const QwtText& title )
     m_data->layout = new QwtPlotLayout;
     m_data->autoReplot = false;
 
+    m_data->updateDepth = 0;
+    m_data->replotPending = false;
+
     // title
     m_data->titleLabel = new QwtTextLabel( this );
     m_data->titleLabel->setObjectName( "QwtPlotTitle" );
@@ -285,11 +320,21 @@ bool QwtPlot::eventFilter( QObject* object, QEvent* event )
     return QFrame::eventFilter( object, event );
 }
 
-//! Replots the plot if autoReplot() is \c true.
+/*!
+   Replots the plot if autoReplot() is \c true.
+
+   Between beginUpdate() and endUpdate() the replot is
+   delayed until endUpdate().
+ */
 void QwtPlot::autoRefresh()
 {
     if ( m_data->autoReplot )
-        replot();
+    {
+        if ( m_data->updateDepth > 0 )
+            m_data->replotPending = true;
+        else
+            replot();
+    }
 }
 
 /*!
@@ -321,6 +366,117 @@ bool QwtPlot::autoReplot() const
     return m_data->autoReplot;
 }
 
+/*!
+   \brief Start a sequence of modifications
+
+   Attaching many items one by one is expensive: each item is inserted
+   into the z-sorted item list, the legend is updated and - when
+   autoReplot() is enabled - the plot gets replotted.
+
+   Between beginUpdate() and endUpdate() these operations are delayed:
+
+   - Attached items are appended to the item list, that is sorted once in endUpdate()
+   - legendDataChanged() is emitted for each modified item in endUpdate()
+   - updateAxes() and replot() are executed once in endUpdate()
+
+   \code
+ plot->beginUpdate();
+
+ for ( int i = 0; i < numCurves; i++ )
+ {
+     QwtPlotCurve* curve = new QwtPlotCurve();
+     curve->setSamples( ... );
+     curve->attach( plot );
+ }
+
+ plot->endUpdate();
+   \endcode
+
+   Calls of beginUpdate() can be nested, the modifications are
+   processed, when the outermost endUpdate() is called.
+
+   \sa endUpdate(), isUpdating(), attachItems()
+   \note While updating itemList() is not ordered by z value
+ */
+void QwtPlot::beginUpdate()
+{
+    if ( m_data->updateDepth++ == 0 )
+        setSortingDeferred( true );
+}
+
+/*!
+   \brief Process the modifications, that have been delayed since beginUpdate()
+   \sa beginUpdate(), isUpdating()
+ */
+void QwtPlot::endUpdate()
+{
+    if ( m_data->updateDepth <= 0 )
+        return;
+
+    if ( --m_data->updateDepth > 0 )
+        return;
+
+    setSortingDeferred( false );
+
+    if ( !m_data->legendPending.isEmpty() )
+    {
+        const QSet< const QwtPlotItem* > pending = m_data->legendPending;
+        m_data->legendPending.clear();
+
+        // emitting in the order of the item list
+
+        const QwtPlotItemList& itmList = itemList();
+        for ( QwtPlotItemIterator it = itmList.begin();
+            it != itmList.end(); ++it )
+        {
+            if ( pending.contains( *it ) )
+                updateLegend( *it );
+        }
+    }
+
+    if ( m_data->replotPending )
+    {
+        m_data->replotPending = false;
+        replot(); // includes updateAxes()
+    }
+    else
+    {
+        updatePendingAxes();
+    }
+}
+
+/*!
+   \return True, when being between beginUpdate() and endUpdate()
+   \sa beginUpdate(), endUpdate()
+ */
+bool QwtPlot::isUpdating() const
+{
+    return m_data->updateDepth > 0;
+}
+
+/*!
+   \brief Attach a list of plot items
+
+   The items are attached between beginUpdate() and endUpdate(),
+   so that sorting the item list, updating the legend and
+   replotting happens only once.
+
+   \param items Plot items
+   \sa beginUpdate(), QwtPlotItem::attach()
+ */
+void QwtPlot::attachItems( const QwtPlotItemList& items )
+{
+    beginUpdate();
+
+    for ( QwtPlotItemIterator it = items.begin(); it != items.end(); ++it )
+    {
+        if ( *it )
+            ( *it )->attach( this );
+    }
+
+    endUpdate();
+}
+
 /*!
    Change the plot's title
    \param title New title
@@ -540,10 +696,19 @@ void QwtPlot::resizeEvent( QResizeEvent* e )
    or if any curves are attached to raw data, the plot has to
    be refreshed explicitly in order to make changes visible.
 
-   \sa updateAxes(), setAutoReplot()
+   Between beginUpdate() and endUpdate() the replot is delayed
+   until endUpdate().
+
+   \sa updateAxes(), setAutoReplot(), beginUpdate()
  */
 void QwtPlot::replot()
 {
+    if ( m_data->updateDepth > 0 )
+    {
+        m_data->replotPending = true;
+        return;
+    }
+
     bool doAutoReplot = autoReplot();
     setAutoReplot( false );
 
@@ -952,25 +1117,14 @@ void QwtPlot::insertLegend( QwtAbstractLegend* legend,
 
             QwtLegend* lgd = qobject_cast< QwtLegend* >( legend );
             if ( lgd )
+                qwtAdjustLegendColumns( lgd, m_data->layout->legendPosition() );
+
+            QwtVirtualLegend* virtualLegend =
+                qobject_cast< QwtVirtualLegend* >( legend );
+            if ( virtualLegend )
             {
-                switch ( m_data->layout->legendPosition() )
-                {
-                    case LeftLegend:
-                    case RightLegend:
-                    {
-                        if ( lgd->maxColumns() == 0     )
-                            lgd->setMaxColumns( 1 ); // 1 column: align vertical
-                        break;
-                    }
-                    case TopLegend:
-                    case BottomLegend:
-                    {
-                        lgd->setMaxColumns( 0 ); // unlimited
-                        break;
-                    }
-                    default:
-                        break;
-                }
+                qwtAdjustLegendColumns( virtualLegend,
+                    m_data->layout->legendPosition() );
             }
 
             QWidget* previousInChain = NULL;
@@ -1026,6 +1180,9 @@ void QwtPlot::updateLegend()
 /*!
    Emit legendDataChanged() for a plot item
 
+   Between beginUpdate() and endUpdate() the signal is delayed
+   until endUpdate().
+
    \param plotItem Plot item
    \sa QwtPlotItem::legendData(), legendDataChanged()
  */
@@ -1034,6 +1191,13 @@ void QwtPlot::updateLegend( const QwtPlotItem* plotItem )
     if ( plotItem == NULL )
         return;
 
+    if ( m_data->updateDepth > 0 )
+    {
+        // emitted in endUpdate()
+        m_data->legendPending += plotItem;
+        return;
+    }
+
     QList< QwtLegendData > legendData;
 
     if ( plotItem->testItemAttribute( QwtPlotItem::Legend ) )
@@ -1116,6 +1280,8 @@ void QwtPlot::attachItem( QwtPlotItem* plotItem, bool on )
         }
         else
         {
+            m_data->legendPending.remove( plotItem );
+
             const QVariant itemInfo = itemToInfo( plotItem );
             Q_EMIT legendDataChanged( itemInfo, QList< QwtLegendData >() );
         }
@@ -113,6 +113,12 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
     void setAutoReplot( bool = true );
     bool autoReplot() const;
 
+    void beginUpdate();
+    void endUpdate();
+    bool isUpdating() const;
+
+    void attachItems( const QwtPlotItemList& );
+
     // Layout
 
     void setPlotLayout( QwtPlotLayout* );
@@ -265,6 +271,14 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
      */
     void itemAttached( QwtPlotItem* plotItem, bool on );
 
+    /*!
+       A signal indicating, that an attached item has been changed
+
+       \param plotItem Plot item
+       \sa QwtPlotItem::itemChanged()
+     */
+    void itemChanged( QwtPlotItem* plotItem );
+
     /*!
        A signal with the attributes how to update
        the legend entries for a plot item.
@@ -297,6 +311,7 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
     void initAxesData();
     void deleteAxesData();
     void updateScaleDiv();
+    void updatePendingAxes();
 
     void initPlot( const QwtText& title );
 
@@ -39,6 +39,8 @@ class QwtPlotAbstractBarChart::PrivateData
     int spacing;
     int margin;
     double baseline;
+
+    QwtPlotAbstractBarChart::PaintAttributes paintAttributes;
 };
 
 /*!
@@ -210,6 +212,36 @@ double QwtPlotAbstractBarChart::baseline() const
     return m_data->baseline;
 }
 
+/*!
+   Specify an attribute how to draw the chart
+
+   \param attribute Paint attribute
+   \param on On/Off
+   \sa testPaintAttribute()
+ */
+void QwtPlotAbstractBarChart::setPaintAttribute(
+    PaintAttribute attribute, bool on )
+{
+    if ( on == testPaintAttribute( attribute ) )
+        return;
+
+    if ( on )
+        m_data->paintAttributes |= attribute;
+    else
+        m_data->paintAttributes &= ~attribute;
+
+    itemChanged();
+}
+
+/*!
+    \return True, when attribute is enabled
+    \sa setPaintAttribute()
+ */
+bool QwtPlotAbstractBarChart::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( m_data->paintAttributes & attribute );
+}
+
 /*!
    Calculate the width for a sample in paint device coordinates
 
@@ -59,6 +59,30 @@ class QWT_EXPORT QwtPlotAbstractBarChart : public QwtPlotSeriesItem
         FixedSampleSize
     };
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        /*!
+           Paint the bars in batches using QwtColumnSymbol::drawColumns().
+           Bars of the Box style, that are painted to the same pixel
+           row or column, are merged and the rectangles of all bars are
+           painted by one QPainter::drawRects() for each brush.
+
+           This is an optimization for charts with many more samples than
+           pixels, where most of the bars are painted on top of each other.
+
+           \note In this mode the bars are painted without calling
+                 the virtual hooks for individual bars - like specialSymbol()
+                 or drawBar() - of the derived classes.
+         */
+        BatchBars = 0x01
+    };
+
+    Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
+
     explicit QwtPlotAbstractBarChart( const QwtText& title );
     virtual ~QwtPlotAbstractBarChart();
 
@@ -77,6 +101,9 @@ class QWT_EXPORT QwtPlotAbstractBarChart : public QwtPlotSeriesItem
     void setBaseline( double );
     double baseline() const;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     virtual void getCanvasMarginHint(
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRectF& canvasRect, double& left, double& top,
@@ -93,4 +120,6 @@ class QWT_EXPORT QwtPlotAbstractBarChart : public QwtPlotSeriesItem
     PrivateData* m_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotAbstractBarChart::PaintAttributes )
+
 #endif
@@ -81,6 +81,7 @@ class QwtPlot::ScaleData
 {
   public:
     ScaleData( QwtPlot* plot )
+        : isUpdatePending( false )
     {
         using namespace QwtAxis;
 
@@ -100,6 +101,9 @@ class QwtPlot::ScaleData
         return m_axisData[ axisId ];
     }
 
+    // updateAxes() has been delayed by QwtPlot::beginUpdate()
+    bool isUpdatePending;
+
   private:
     AxisData m_axisData[ QwtAxis::AxisPositions ];
 };
@@ -662,13 +666,25 @@ void QwtPlot::setAxisTitle( QwtAxisId axisId, const QwtText& title )
    The scale widget indicates modifications by emitting a
    QwtScaleWidget::scaleDivChanged() signal.
 
-   updateAxes() is usually called by replot().
+   updateAxes() is usually called by replot(). Between beginUpdate()
+   and endUpdate() it is delayed until endUpdate().
 
    \sa setAxisAutoScale(), setAxisScale(), setAxisScaleDiv(), replot()
       QwtPlotItem::boundingRect()
  */
 void QwtPlot::updateAxes()
 {
+    if ( isUpdating() )
+    {
+        // the item list is incomplete, updateAxes() will be
+        // called again from endUpdate()
+
+        m_scaleData->isUpdatePending = true;
+        return;
+    }
+
+    m_scaleData->isUpdatePending = false;
+
     // Find bounding interval of the item data
     // for all axes, where autoscaling is enabled
 
@@ -753,3 +769,9 @@ void QwtPlot::updateAxes()
         }
     }
 }
+
+void QwtPlot::updatePendingAxes()
+{
+    if ( m_scaleData->isUpdatePending )
+        updateAxes();
+}
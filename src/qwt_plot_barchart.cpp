@@ -15,6 +15,7 @@
 #include "qwt_legend_data.h"
 
 #include <qpainter.h>
+#include <qvector.h>
 
 class QwtPlotBarChart::PrivateData
 {
@@ -239,15 +240,59 @@ void QwtPlotBarChart::drawSeries( QPainter* painter,
 
     painter->save();
 
-    for ( int i = from; i <= to; i++ )
+    if ( testPaintAttribute( QwtPlotAbstractBarChart::BatchBars ) )
     {
-        drawSample( painter, xMap, yMap,
-            canvasRect, interval, i, sample( i ) );
+        drawBatchedBars( painter, xMap, yMap,
+            canvasRect, interval, from, to );
+    }
+    else
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            drawSample( painter, xMap, yMap,
+                canvasRect, interval, i, sample( i ) );
+        }
     }
 
     painter->restore();
 }
 
+/*
+   Draw the bars with QwtColumnSymbol::drawColumns(), bypassing
+   drawSample(), drawBar() and specialSymbol().
+ */
+void QwtPlotBarChart::drawBatchedBars( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, const QwtInterval& boundingInterval,
+    int from, int to ) const
+{
+    QwtColumnSymbol defaultSymbol( QwtColumnSymbol::Box );
+    defaultSymbol.setLineWidth( 1 );
+    defaultSymbol.setFrameStyle( QwtColumnSymbol::Plain );
+
+    const QwtColumnSymbol* sym = m_data->symbol;
+    if ( sym == NULL )
+        sym = &defaultSymbol;
+
+    const int chunkSize = 10000;
+
+    QVector< QwtColumnRect > columns( qMin( chunkSize, to - from + 1 ) );
+    QwtColumnRect* c = columns.data();
+
+    for ( int i = from; i <= to; i += chunkSize )
+    {
+        const int n = qMin( chunkSize, to - i + 1 );
+
+        for ( int j = 0; j < n; j++ )
+        {
+            c[j] = columnRect( xMap, yMap, canvasRect,
+                boundingInterval, sample( i + j ) );
+        }
+
+        sym->drawColumns( painter, c, n );
+    }
+}
+
 /*!
    Calculate the geometry of a bar in widget coordinates
 
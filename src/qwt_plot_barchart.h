@@ -30,6 +30,9 @@ template< typename T > class QwtSeriesData;
    By activating the LegendBarTitles mode each sample will have
    its own entry on the legend.
 
+   For charts with many more samples than pixels the BatchBars
+   paint attribute can be enabled.
+
    The most common use case of a bar chart is to display a
    list of y coordinates, where the x coordinate is simply the index
    in the list. But for other situations ( f.e. when values are related
@@ -117,6 +120,11 @@ class QWT_EXPORT QwtPlotBarChart
   private:
     void init();
 
+    void drawBatchedBars( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, const QwtInterval& boundingInterval,
+        int from, int to ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -135,6 +135,28 @@ const QPixmap* QwtPlotCanvas::backingStore() const
     return m_data->backingStore;
 }
 
+/*!
+   \brief Replace the content of the backing store
+
+   The pixmap is displayed by the next paint event instead of
+   rendering the plot items. It is usually a copy of backingStore(),
+   that has been taken before, when the plot was in the same state.
+   A pixmap, that doesn't match the size of the canvas is ignored
+   and the canvas is rendered as usual.
+
+   \param pixmap Pixmap
+   \note setBackingStore() is ignored, when BackingStore is disabled
+   \sa backingStore(), invalidateBackingStore()
+ */
+void QwtPlotCanvas::setBackingStore( const QPixmap& pixmap )
+{
+    if ( m_data->backingStore )
+    {
+        *m_data->backingStore = pixmap;
+        update( contentsRect() );
+    }
+}
+
 //! Invalidate the internal backing store
 void QwtPlotCanvas::invalidateBackingStore()
 {
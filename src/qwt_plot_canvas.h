@@ -108,6 +108,7 @@ class QWT_EXPORT QwtPlotCanvas : public QFrame, public QwtPlotAbstractCanvas
     bool testPaintAttribute( PaintAttribute ) const;
 
     const QPixmap* backingStore() const;
+    void setBackingStore( const QPixmap& );
     Q_INVOKABLE void invalidateBackingStore();
 
     virtual bool event( QEvent* ) QWT_OVERRIDE;
@@ -15,6 +15,9 @@
 #include "qwt_scale_map.h"
 #include "qwt_plot.h"
 #include "qwt_spline_curve_fitter.h"
+#include "qwt_spline.h"
+#include "qwt_spline_parametrization.h"
+#include "qwt_transform.h"
 #include "qwt_symbol.h"
 #include "qwt_point_mapper.h"
 #include "qwt_text.h"
@@ -24,6 +27,7 @@
 #include <qpainterpath.h>
 
 #include <climits>
+#include <typeinfo>
 
 static inline QRectF qwtIntersectedClipRect( const QRectF& rect, QPainter* painter )
 {
@@ -57,6 +61,78 @@ static void qwtUpdateLegendIconSize( QwtPlotCurve* curve )
     }
 }
 
+static inline bool qwtIsGap( const QPointF& pos )
+{
+    return qIsNaN( pos.x() );
+}
+
+static inline QPolygonF qwtSubPolyline(
+    const QPolygonF& points, int from, int count )
+{
+    // curves without gaps are not copied
+    if ( from == 0 && count == points.size() )
+        return points;
+
+    return points.mid( from, count );
+}
+
+/*
+    Joining polylines to one polygon, where they are separated
+    by gaps - points with NaN coordinates. This is the format
+    of QwtPointMapper::toPolygonF() with QwtPointMapper::KeepGaps,
+    that is also used for passing the polylines to QwtPlotCurve::fillCurve().
+ */
+static QPolygonF qwtJoinPolylines(
+    const QPolygonF& points, const QVector< int >& polylineSizes )
+{
+    if ( polylineSizes.size() <= 1 )
+        return points;
+
+    QPolygonF polygon;
+    polygon.reserve( points.size() + polylineSizes.size() - 1 );
+
+    const QPointF* p = points.constData();
+    for ( int i = 0; i < polylineSizes.size(); i++ )
+    {
+        if ( i > 0 )
+            polygon += QPointF( qQNaN(), qQNaN() );
+
+        for ( int j = 0; j < polylineSizes[i]; j++ )
+            polygon += *p++;
+    }
+
+    return polygon;
+}
+
+static QPolygonF qwtFitPolylines( const QwtCurveFitter* fitter,
+    const QPolygonF& points, QVector< int >& polylineSizes )
+{
+    QPolygonF fittedPoints;
+
+    int from = 0;
+    for ( int i = 0; i < polylineSizes.size(); i++ )
+    {
+        const QPolygonF fitted = fitter->fitCurve(
+            qwtSubPolyline( points, from, polylineSizes[i] ) );
+
+        from += polylineSizes[i];
+
+        fittedPoints += fitted;
+        polylineSizes[i] = fitted.size();
+    }
+
+    return fittedPoints;
+}
+
+static inline void qwtDrawStick( QPainter* painter,
+    Qt::Orientation orientation, double pos, double from, double to )
+{
+    if ( orientation == Qt::Horizontal )
+        QwtPainter::drawLine( painter, from, pos, to, pos );
+    else
+        QwtPainter::drawLine( painter, pos, from, pos, to );
+}
+
 static int qwtVerifyRange( int size, int& i1, int& i2 )
 {
     if ( size < 1 )
@@ -71,6 +147,193 @@ static int qwtVerifyRange( int size, int& i1, int& i2 )
     return ( i2 - i1 + 1 );
 }
 
+static inline bool qwtIsLinear( const QwtScaleMap& map )
+{
+    const QwtTransform* transform = map.transformation();
+    return ( transform == NULL )
+        || ( dynamic_cast< const QwtNullTransform* >( transform ) != NULL );
+}
+
+static inline int qwtLowerIndex( const QPolygonF& points, double x )
+{
+    // index of the first point with a x coordinate >= x
+
+    int from = 0;
+    int to = points.size();
+
+    while ( from < to )
+    {
+        const int mid = from + ( to - from ) / 2;
+        if ( points[mid].x() < x )
+            from = mid + 1;
+        else
+            to = mid;
+    }
+
+    return from;
+}
+
+namespace
+{
+    class FitCache
+    {
+      public:
+        FitCache()
+            : data( NULL )
+            , spline( NULL )
+            , parametrization( -1 )
+            , boundaryType( QwtSpline::ConditionalBoundaries )
+            , validSize( 0 )
+            , hasGaps( false )
+            , isReplaced( false )
+        {
+        }
+
+        void invalidate( int from = 0 )
+        {
+            validSize = qBound( 0, from, validSize );
+        }
+
+        void update( const QwtSplineInterpolating* spline,
+            const QwtSeriesData< QPointF >* series )
+        {
+            const int type = spline->parametrization()->type();
+
+            if ( spline != this->spline || type != parametrization
+                || spline->boundaryType() != boundaryType )
+            {
+                this->spline = spline;
+                parametrization = type;
+                boundaryType = spline->boundaryType();
+
+                validSize = 0;
+            }
+
+            if ( series != data )
+            {
+                data = series;
+                isReplaced = true;
+            }
+
+            const int n = int( series->size() );
+
+            validSize = qMin( validSize, n );
+            if ( validSize > 0 )
+            {
+                if ( isReplaced )
+                {
+                    /*
+                        The samples have been replaced - usually by the same
+                        samples with some more appended. The polynomials
+                        before the first modified sample can be kept.
+                     */
+
+                    int i = 0;
+                    while ( i < validSize && points[i] == series->sample( i ) )
+                        i++;
+
+                    validSize = i;
+                }
+                else
+                {
+                    // detecting modifications, that have not been announced
+
+                    if ( points[0] != series->sample( 0 )
+                        || points[validSize - 1] != series->sample( validSize - 1 ) )
+                    {
+                        validSize = 0;
+                    }
+                }
+            }
+
+            isReplaced = false;
+
+            // we don't know, if the gaps are in the valid part
+            if ( hasGaps && validSize < points.size() )
+                validSize = 0;
+
+            if ( validSize == n && points.size() == n )
+                return;
+
+            points.resize( n );
+
+            if ( validSize == 0 )
+                hasGaps = false;
+
+            QPointF* p = points.data();
+            for ( int i = validSize; i < n; i++ )
+            {
+                p[i] = series->sample( i );
+
+                if ( qIsNaN( p[i].x() ) || qIsNaN( p[i].y() ) )
+                    hasGaps = true;
+            }
+
+            if ( n <= 2 || hasGaps )
+            {
+                controlLines.clear();
+                validSize = n;
+
+                return;
+            }
+
+            /*
+                Appending points modifies the polynomials at the
+                old end of the polygon - according to the locality
+                of the spline. To avoid, that the boundary conditions
+                at the beginning of the subpolygon have an effect on
+                the polynomials we need, we start even earlier.
+             */
+
+            const int locality = int( spline->locality() );
+
+            const int dirty = validSize - 1 - ( locality + 1 );
+            const int start = dirty - 2 * ( locality + 1 );
+
+            if ( locality <= 0 || boundaryType != QwtSpline::ConditionalBoundaries
+                || start <= 0 || controlLines.size() < dirty )
+            {
+                controlLines = spline->bezierControlLines( points );
+            }
+            else
+            {
+                const QVector< QLineF > lines =
+                    spline->bezierControlLines( points.mid( start ) );
+
+                if ( lines.size() < n - start - 1 )
+                {
+                    controlLines = spline->bezierControlLines( points );
+                }
+                else
+                {
+                    controlLines.resize( n - 1 );
+
+                    for ( int i = dirty; i < n - 1; i++ )
+                        controlLines[i] = lines[i - start];
+                }
+            }
+
+            validSize = n;
+        }
+
+        const QwtSeriesData< QPointF >* data;
+        const QwtSpline* spline;
+        int parametrization;
+        QwtSpline::BoundaryType boundaryType;
+
+        QPolygonF points;
+        QVector< QLineF > controlLines;
+
+        int validSize;
+
+        // the spline is not calculated for curves with NaN samples
+        bool hasGaps;
+
+        // the samples have to be compared with the cached points
+        bool isReplaced;
+    };
+}
+
 class QwtPlotCurve::PrivateData
 {
   public:
@@ -103,6 +366,8 @@ class QwtPlotCurve::PrivateData
     QwtPlotCurve::PaintAttributes paintAttributes;
 
     QwtPlotCurve::LegendAttributes legendAttributes;
+
+    FitCache fitCache;
 };
 
 /*!
@@ -162,6 +427,9 @@ void QwtPlotCurve::setPaintAttribute( PaintAttribute attribute, bool on )
         m_data->paintAttributes |= attribute;
     else
         m_data->paintAttributes &= ~attribute;
+
+    if ( attribute == CacheFittedCurve && !on )
+        m_data->fitCache = FitCache();
 }
 
 /*!
@@ -496,6 +764,12 @@ void QwtPlotCurve::drawLines( QPainter* painter,
         clipRect = clipRect.adjusted(-pw, -pw, pw, pw);
     }
 
+    if ( doFit && !doFill && ( m_data->paintAttributes & CacheFittedCurve ) )
+    {
+        if ( drawCachedFit( painter, xMap, yMap, clipRect, from, to ) )
+            return;
+    }
+
     QwtPointMapper mapper;
 
     if ( doAlign )
@@ -511,7 +785,17 @@ void QwtPlotCurve::drawLines( QPainter* painter,
 
     mapper.setBoundingRect( canvasRect );
 
-    QPolygonF polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
+    /*
+        Samples with NaN coordinates interrupt the curve. All polylines
+        between those gaps are painted here instead of splitting
+        the data into several curves.
+     */
+    QVector< int > polylineSizes;
+    QPolygonF points = mapper.toPolylinesF(
+        xMap, yMap, data(), from, to, polylineSizes );
+
+    if ( points.isEmpty() )
+        return;
 
     if ( doFill )
     {
@@ -521,60 +805,234 @@ void QwtPlotCurve::drawLines( QPainter* painter,
             // the moment we keep an implementation, where we translate the
             // path back to a polyline.
 
-            polyline = m_data->curveFitter->fitCurve( polyline );
+            points = qwtFitPolylines( m_data->curveFitter, points, polylineSizes );
         }
 
+        // all areas are filled before painting the lines on top of them
+
+        QPolygonF filled = qwtJoinPolylines( points, polylineSizes );
+        fillCurve( painter, xMap, yMap, canvasRect, filled );
+        filled.clear();
+
         if ( painter->pen().style() != Qt::NoPen )
         {
-            // here we are wasting memory for the filled copy,
-            // do polygon clipping twice etc .. TODO
+            int offset = 0;
+            for ( int i = 0; i < polylineSizes.size(); i++ )
+            {
+                QPolygonF polyline = qwtSubPolyline(
+                    points, offset, polylineSizes[i] );
 
-            QPolygonF filled = polyline;
-            fillCurve( painter, xMap, yMap, canvasRect, filled );
-            filled.clear();
+                offset += polylineSizes[i];
 
-            if ( m_data->paintAttributes & ClipPolygons )
-                QwtClipper::clipPolygonF( clipRect, polyline, false );
+                if ( m_data->paintAttributes & ClipPolygons )
+                    QwtClipper::clipPolygonF( clipRect, polyline, false );
 
-            QwtPainter::drawPolyline( painter, polyline );
+                QwtPainter::drawPolyline( painter, polyline );
+            }
         }
-        else
+    }
+    else if ( !doFit && testPaintAttribute( ClipPolygons ) )
+    {
+        /*
+           Instead of connecting the clipped parts along the
+           border, we paint the visible runs only
+         */
+        QPolygonF clippedPoints;
+        clippedPoints.reserve( points.size() );
+
+        QVector< int > runSizes;
+
+        const QPointF* p = points.constData();
+        for ( int i = 0; i < polylineSizes.size(); i++ )
         {
-            fillCurve( painter, xMap, yMap, canvasRect, polyline );
+            QwtClipper::clipPolylineF( clipRect,
+                p, polylineSizes[i], clippedPoints, runSizes );
+
+            p += polylineSizes[i];
+
+            const QPointF* runPoints = clippedPoints.constData();
+            for ( int j = 0; j < runSizes.size(); j++ )
+            {
+                QwtPainter::drawPolyline( painter, runPoints, runSizes[j] );
+                runPoints += runSizes[j];
+            }
         }
     }
     else
     {
-        if ( testPaintAttribute( ClipPolygons ) )
+        int offset = 0;
+        for ( int i = 0; i < polylineSizes.size(); i++ )
         {
-            QwtClipper::clipPolygonF( clipRect, polyline, false );
-        }
+            QPolygonF polyline = qwtSubPolyline(
+                points, offset, polylineSizes[i] );
 
-        if ( doFit )
-        {
-            if ( m_data->curveFitter->mode() == QwtCurveFitter::Path )
+            offset += polylineSizes[i];
+
+            if ( testPaintAttribute( ClipPolygons ) )
             {
-                const QPainterPath curvePath =
-                    m_data->curveFitter->fitCurvePath( polyline );
+                QwtClipper::clipPolygonF( clipRect, polyline, false );
+            }
 
-                painter->drawPath( curvePath );
+            if ( doFit )
+            {
+                if ( m_data->curveFitter->mode() == QwtCurveFitter::Path )
+                {
+                    const QPainterPath curvePath =
+                        m_data->curveFitter->fitCurvePath( polyline );
+
+                    painter->drawPath( curvePath );
+                }
+                else
+                {
+                    polyline = m_data->curveFitter->fitCurve( polyline );
+                    QwtPainter::drawPolyline( painter, polyline );
+                }
             }
             else
             {
-                polyline = m_data->curveFitter->fitCurve( polyline );
                 QwtPainter::drawPolyline( painter, polyline );
             }
         }
-        else
+    }
+}
+
+/*
+   Draw a fitted curve from the polynomials, that have been calculated
+   in data coordinates. Returns false, when the curve can't be fitted
+   in data coordinates without changing the result.
+
+   For a valid clipRect the segments outside of it are not painted.
+ */
+bool QwtPlotCurve::drawCachedFit( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& clipRect, int from, int to ) const
+{
+    const QwtSplineCurveFitter* fitter =
+        dynamic_cast< const QwtSplineCurveFitter* >( m_data->curveFitter );
+    if ( fitter == NULL )
+        return false;
+
+    const QwtSplineInterpolating* spline =
+        dynamic_cast< const QwtSplineInterpolating* >( fitter->spline() );
+
+    if ( spline == NULL || spline->boundaryType() == QwtSpline::ClosedPolygon )
+        return false;
+
+    // only those parametrizations are independent of the aspect ratio
+
+    const int type = spline->parametrization()->type();
+    if ( type != QwtSplineParametrization::ParameterX
+        && type != QwtSplineParametrization::ParameterY
+        && type != QwtSplineParametrization::ParameterUniform )
+    {
+        return false;
+    }
+
+    if ( !qwtIsLinear( xMap ) || !qwtIsLinear( yMap ) )
+        return false;
+
+    FitCache& cache = m_data->fitCache;
+    cache.update( spline, data() );
+
+    if ( cache.hasGaps )
+        return false;
+
+    const QPolygonF& points = cache.points;
+    const int n = points.size();
+
+    from = qMax( from, 0 );
+    to = qMin( to, n - 1 );
+
+    if ( type == QwtSplineParametrization::ParameterX
+        && n > 0 && points[0].x() <= points[n - 1].x() )
+    {
+        // only the polynomials of the visible interval
+
+        const double x1 = qMin( xMap.s1(), xMap.s2() );
+        const double x2 = qMax( xMap.s1(), xMap.s2() );
+
+        from = qMax( from, qwtLowerIndex( points, x1 ) - 1 );
+        to = qMin( to, qwtLowerIndex( points, x2 ) );
+    }
+
+    if ( from >= to )
+        return true;
+
+    const bool hasControlLines = ( n > 2 ) && ( cache.controlLines.size() >= n - 1 );
+    const QLineF* lines = cache.controlLines.constData();
+
+    const bool doClip = clipRect.isValid();
+
+    QPainterPath path;
+
+    QPointF p1 = QwtScaleMap::transform( xMap, yMap, points[from] );
+    bool isConnected = false;
+
+    for ( int i = from; i < to; i++ )
+    {
+        const QPointF p2 = QwtScaleMap::transform( xMap, yMap, points[i + 1] );
+
+        QPointF cp1, cp2;
+        if ( hasControlLines )
+        {
+            cp1 = QwtScaleMap::transform( xMap, yMap, lines[i].p1() );
+            cp2 = QwtScaleMap::transform( xMap, yMap, lines[i].p2() );
+        }
+
+        if ( doClip )
+        {
+            // a Bezier curve is inside the hull of its control points
+
+            double x1 = qMin( p1.x(), p2.x() );
+            double x2 = qMax( p1.x(), p2.x() );
+            double y1 = qMin( p1.y(), p2.y() );
+            double y2 = qMax( p1.y(), p2.y() );
+
+            if ( hasControlLines )
+            {
+                x1 = qMin( x1, qMin( cp1.x(), cp2.x() ) );
+                x2 = qMax( x2, qMax( cp1.x(), cp2.x() ) );
+                y1 = qMin( y1, qMin( cp1.y(), cp2.y() ) );
+                y2 = qMax( y2, qMax( cp1.y(), cp2.y() ) );
+            }
+
+            // QRectF::intersects fails for horizontal/vertical lines
+            if ( x2 < clipRect.left() || x1 > clipRect.right()
+                || y2 < clipRect.top() || y1 > clipRect.bottom() )
+            {
+                p1 = p2;
+                isConnected = false;
+
+                continue;
+            }
+        }
+
+        if ( !isConnected )
         {
-            QwtPainter::drawPolyline( painter, polyline );
+            path.moveTo( p1 );
+            isConnected = true;
         }
+
+        if ( hasControlLines )
+            path.cubicTo( cp1, cp2, p2 );
+        else
+            path.lineTo( p2 );
+
+        p1 = p2;
     }
+
+    QwtPainter::drawPath( painter, path );
+
+    return true;
 }
 
 /*!
    Draw sticks
 
+   With FilterPointsAggressive and a painter with integer coordinates
+   all sticks of a pixel column are painted as one line from the
+   minimum to the maximum - including the baseline.
+
    \param painter Painter
    \param xMap x map
    \param yMap y map
@@ -604,6 +1062,15 @@ void QwtPlotCurve::drawSticks( QPainter* painter,
     }
 
     const Qt::Orientation o = orientation();
+    const double base = ( o == Qt::Horizontal ) ? x0 : y0;
+
+    const bool doReduce = doAlign && testPaintAttribute( FilterPointsAggressive );
+
+    // the column of the sticks, that have not been painted yet
+    bool hasColumn = false;
+    double column = 0.0;
+    double min = 0.0;
+    double max = 0.0;
 
     const QwtSeriesData< QPointF >* series = data();
 
@@ -612,18 +1079,49 @@ void QwtPlotCurve::drawSticks( QPainter* painter,
         const QPointF sample = series->sample( i );
         double xi = xMap.transform( sample.x() );
         double yi = yMap.transform( sample.y() );
+
+        if ( !( qIsFinite( xi ) && qIsFinite( yi ) ) )
+            continue;
+
         if ( doAlign )
         {
             xi = qRound( xi );
             yi = qRound( yi );
         }
 
-        if ( o == Qt::Horizontal )
-            QwtPainter::drawLine( painter, x0, yi, xi, yi );
-        else
-            QwtPainter::drawLine( painter, xi, y0, xi, yi );
+        if ( !doReduce )
+        {
+            if ( o == Qt::Horizontal )
+                QwtPainter::drawLine( painter, x0, yi, xi, yi );
+            else
+                QwtPainter::drawLine( painter, xi, y0, xi, yi );
+
+            continue;
+        }
+
+        const double pos = ( o == Qt::Horizontal ) ? yi : xi;
+        const double value = ( o == Qt::Horizontal ) ? xi : yi;
+
+        if ( hasColumn && pos == column )
+        {
+            min = qMin( min, value );
+            max = qMax( max, value );
+
+            continue;
+        }
+
+        if ( hasColumn )
+            qwtDrawStick( painter, o, column, min, max );
+
+        hasColumn = true;
+        column = pos;
+        min = qMin( base, value );
+        max = qMax( base, value );
     }
 
+    if ( hasColumn )
+        qwtDrawStick( painter, o, column, min, max );
+
     painter->restore();
 }
 
@@ -671,11 +1169,16 @@ void QwtPlotCurve::drawDots( QPainter* painter,
     {
         mapper.setFlag( QwtPointMapper::WeedOutPoints, false );
 
-        QPolygonF points = mapper.toPolygonF(
-            xMap, yMap, data(), from, to );
+        // the area below each polyline between the gaps is filled
+
+        QVector< int > polylineSizes;
+        const QPolygonF points = mapper.toPolylinesF(
+            xMap, yMap, data(), from, to, polylineSizes );
 
         QwtPainter::drawPoints( painter, points );
-        fillCurve( painter, xMap, yMap, canvasRect, points );
+
+        QPolygonF filled = qwtJoinPolylines( points, polylineSizes );
+        fillCurve( painter, xMap, yMap, canvasRect, filled );
     }
     else if ( m_data->paintAttributes & ImageBuffer )
     {
@@ -730,6 +1233,10 @@ void QwtPlotCurve::drawDots( QPainter* painter,
 
    The direction of the steps depends on Inverted attribute.
 
+   The steps are built from the points of QwtPointMapper, so that
+   FilterPointsAggressive reduces the samples of each pixel column
+   without changing the painted pixels.
+
    \param painter Painter
    \param xMap x map
    \param yMap y map
@@ -746,63 +1253,126 @@ void QwtPlotCurve::drawSteps( QPainter* painter,
 {
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
-    QPolygonF polygon( 2 * ( to - from ) + 1 );
+    QwtPointMapper mapper;
+
+    if ( doAlign )
+    {
+        mapper.setFlag( QwtPointMapper::RoundPoints, true );
+        mapper.setFlag( QwtPointMapper::WeedOutIntermediatePoints,
+            testPaintAttribute( FilterPointsAggressive ) );
+    }
+
+    mapper.setFlag( QwtPointMapper::WeedOutPoints,
+        testPaintAttribute( FilterPoints ) ||
+        testPaintAttribute( FilterPointsAggressive ) );
+
+    mapper.setFlag( QwtPointMapper::KeepGaps, true );
+
+    /*
+        Within a row or column of pixels the steps between consecutive
+        points are lines along this row or column - the same lines,
+        that would be drawn between the samples, that have been weeded out.
+        Samples with NaN coordinates are mapped to gaps, that are
+        indicated by a point with NaN coordinates.
+     */
+    const QPolygonF mappedPoints = mapper.toPolygonF( xMap, yMap, data(), from, to );
+    if ( mappedPoints.isEmpty() )
+        return;
+
+    QPolygonF polygon( 2 * mappedPoints.size() - 1 );
     QPointF* points = polygon.data();
 
     bool inverted = orientation() == Qt::Vertical;
     if ( m_data->attributes & Inverted )
         inverted = !inverted;
 
-    const QwtSeriesData< QPointF >* series = data();
+    int ip = 0;
+    bool isGap = false;
 
-    int i, ip;
-    for ( i = from, ip = 0; i <= to; i++, ip += 2 )
+    for ( int i = 0; i < mappedPoints.size(); i++ )
     {
-        const QPointF sample = series->sample( i );
-        double xi = xMap.transform( sample.x() );
-        double yi = yMap.transform( sample.y() );
-        if ( doAlign )
+        const QPointF& pos = mappedPoints[i];
+
+        if ( qwtIsGap( pos ) )
         {
-            xi = qRound( xi );
-            yi = qRound( yi );
+            isGap = true;
+            continue;
         }
 
+        const double xi = pos.x();
+        const double yi = pos.y();
+
         if ( ip > 0 )
         {
-            const QPointF& p0 = points[ip - 2];
-            QPointF& p = points[ip - 1];
-
-            if ( inverted )
+            if ( isGap )
             {
-                p.rx() = p0.x();
-                p.ry() = yi;
+                points[ip].rx() = qQNaN();
+                points[ip].ry() = qQNaN();
             }
             else
             {
-                p.rx() = xi;
-                p.ry() = p0.y();
+                const QPointF& p0 = points[ip - 1];
+                QPointF& p = points[ip];
+
+                if ( inverted )
+                {
+                    p.rx() = p0.x();
+                    p.ry() = yi;
+                }
+                else
+                {
+                    p.rx() = xi;
+                    p.ry() = p0.y();
+                }
             }
+
+            ip++;
         }
 
+        isGap = false;
+
         points[ip].rx() = xi;
         points[ip].ry() = yi;
+
+        ip++;
     }
 
+    polygon.resize( ip );
+
+    QRectF clipRect;
     if ( m_data->paintAttributes & ClipPolygons )
     {
-        QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
+        clipRect = qwtIntersectedClipRect( canvasRect, painter );
 
         const qreal pw = QwtPainter::effectivePenWidth( painter->pen() );
         clipRect = clipRect.adjusted(-pw, -pw, pw, pw);
+    }
 
-        const QPolygonF clipped = QwtClipper::clippedPolygonF(
-            clipRect, polygon, false );
+    const int numPoints = polygon.size();
 
-        QwtPainter::drawPolyline( painter, clipped );
-    }
-    else
+    int start = 0;
+    for ( int i = 0; i <= numPoints; i++ )
     {
-        QwtPainter::drawPolyline( painter, polygon );
+        if ( i < numPoints && !qwtIsGap( polygon.at( i ) ) )
+            continue;
+
+        if ( i > start )
+        {
+            if ( m_data->paintAttributes & ClipPolygons )
+            {
+                const QPolygonF clipped = QwtClipper::clippedPolygonF(
+                    clipRect, qwtSubPolyline( polygon, start, i - start ), false );
+
+                QwtPainter::drawPolyline( painter, clipped );
+            }
+            else
+            {
+                QwtPainter::drawPolyline( painter,
+                    polygon.constData() + start, i - start );
+            }
+        }
+
+        start = i + 1;
     }
 
     if ( m_data->brush.style() != Qt::NoBrush )
@@ -862,9 +1432,28 @@ void QwtPlotCurve::setCurveFitter( QwtCurveFitter* curveFitter )
     delete m_data->curveFitter;
     m_data->curveFitter = curveFitter;
 
+    m_data->fitCache = FitCache();
+
     itemChanged();
 }
 
+/*!
+   \brief Announce modified samples to the cache of the fitted curve
+
+   When CacheFittedCurve is enabled, the polynomials of the spline are
+   cached between replots. Samples, that are appended to the data are
+   detected automatically, but modifications of other samples need to
+   be announced, f.e. after modifying the spline of the curve fitter.
+
+   \param from Index of the first sample, that has been modified
+
+   \sa CacheFittedCurve, setCurveFitter()
+ */
+void QwtPlotCurve::invalidateFittedCurve( int from )
+{
+    m_data->fitCache.invalidate( from );
+}
+
 /*!
    Get the curve fitter. If curve fitting is disabled NULL is returned.
 
@@ -876,6 +1465,21 @@ QwtCurveFitter* QwtPlotCurve::curveFitter() const
     return m_data->curveFitter;
 }
 
+/*!
+   \brief Announce the replaced data to the cache of the fitted curve
+
+   The cache is not dropped: the new samples are compared with
+   the cached points and only the polynomials behind the first
+   modified sample are recalculated.
+
+   \sa CacheFittedCurve, invalidateFittedCurve()
+ */
+void QwtPlotCurve::dataChanged()
+{
+    m_data->fitCache.isReplaced = true;
+    QwtPlotSeriesItem::dataChanged();
+}
+
 /*!
    Fill the area between the curve and the baseline with
    the curve brush
@@ -884,7 +1488,9 @@ QwtCurveFitter* QwtPlotCurve::curveFitter() const
    \param xMap x map
    \param yMap y map
    \param canvasRect Contents rectangle of the canvas
-   \param polygon Polygon - will be modified !
+   \param polygon Polygon - will be modified ! Several polylines can be
+                  passed separated by a point with NaN coordinates.
+                  Each of them is filled separately.
 
    \sa setBrush(), setBaseline(), setStyle()
  */
@@ -895,26 +1501,53 @@ void QwtPlotCurve::fillCurve( QPainter* painter,
     if ( m_data->brush.style() == Qt::NoBrush )
         return;
 
-    closePolyline( painter, xMap, yMap, polygon );
-    if ( polygon.count() <= 2 ) // a line can't be filled
-        return;
-
     QBrush brush = m_data->brush;
     if ( !brush.color().isValid() )
         brush.setColor( m_data->pen.color() );
 
+    QRectF clipRect;
     if ( m_data->paintAttributes & ClipPolygons )
-    {
-        const QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
-        QwtClipper::clipPolygonF( clipRect, polygon, true );
-    }
+        clipRect = qwtIntersectedClipRect( canvasRect, painter );
 
     painter->save();
 
     painter->setPen( Qt::NoPen );
     painter->setBrush( brush );
 
-    QwtPainter::drawPolygon( painter, polygon );
+    // polylines, that are separated by gaps, are closed and filled one by one
+
+    const int numPoints = polygon.size();
+
+    int start = 0;
+    while ( start < numPoints )
+    {
+        int end = start;
+        while ( end < numPoints && !qwtIsGap( polygon.at( end ) ) )
+            end++;
+
+        const bool hasGaps = ( start > 0 || end < numPoints );
+
+        QPolygonF closed;
+        if ( hasGaps )
+            closed = polygon.mid( start, end - start );
+        else
+            closed.swap( polygon );
+
+        closePolyline( painter, xMap, yMap, closed );
+
+        if ( closed.count() > 2 ) // a line can't be filled
+        {
+            if ( m_data->paintAttributes & ClipPolygons )
+                QwtClipper::clipPolygonF( clipRect, closed, true );
+
+            QwtPainter::drawPolygon( painter, closed );
+        }
+
+        if ( !hasGaps )
+            polygon.swap( closed );
+
+        start = end + 1;
+    }
 
     painter->restore();
 }
@@ -1286,6 +1919,63 @@ QwtGraphic QwtPlotCurve::legendIcon( int index, const QSizeF& size ) const
     return graphic;
 }
 
+/*!
+   \brief Create a copy of the curve, that can be rendered in another thread
+
+   The series is copied by QwtSeriesData::snapshot(), the symbol
+   by QwtSymbol::snapshot().
+
+   \return Snapshot, that has to be deleted by the caller. NULL,
+           when the curve is fitted, as curve fitters can't be copied.
+
+   \note Derived classes, that reimplement one of the draw methods,
+         need to reimplement snapshot() as well.
+   \sa QwtPlotItem::snapshot(), QwtPlotSnapshot
+ */
+QwtPlotItem* QwtPlotCurve::snapshot() const
+{
+    if ( ( m_data->style == QwtPlotCurve::Lines )
+        && ( m_data->attributes & QwtPlotCurve::Fitted ) )
+    {
+        return NULL;
+    }
+
+    QwtSymbol* symbol = NULL;
+    if ( m_data->symbol )
+    {
+        symbol = m_data->symbol->snapshot();
+        if ( symbol == NULL )
+            return NULL;
+
+        if ( typeid( *symbol ) != typeid( *m_data->symbol ) )
+        {
+            // a derived symbol, that does not reimplement snapshot()
+            delete symbol;
+            return NULL;
+        }
+    }
+
+    QwtPlotCurve* curve = new QwtPlotCurve();
+    initSnapshot( curve );
+
+    curve->setOrientation( orientation() );
+
+    PrivateData* d = curve->m_data;
+
+    d->style = m_data->style;
+    d->baseline = m_data->baseline;
+    d->symbol = symbol;
+    d->pen = m_data->pen;
+    d->brush = m_data->brush;
+    d->attributes = m_data->attributes;
+    d->paintAttributes = m_data->paintAttributes;
+    d->legendAttributes = m_data->legendAttributes;
+
+    curve->setData( data() ? data()->snapshot() : NULL );
+
+    return curve;
+}
+
 /*!
    Assign a series of points
 
@@ -43,7 +43,9 @@ class QPen;
    There are several convenience classes derived from QwtSeriesData, that also store
    the points inside ( like QStandardItemModel ). QwtPlotCurve also offers
    a couple of variations of setSamples(), that build QwtSeriesData objects from
-   arrays internally.</dd>
+   arrays internally.
+   Samples with NaN coordinates are gaps, that interrupt the lines and steps
+   of the curve.</dd>
    <dt>c) Attach the curve to a plot</dt>
    <dd>See QwtPlotItem::attach()
    </dd></dl>
@@ -178,7 +180,10 @@ class QWT_EXPORT QwtPlotCurve
         /*!
            Clip polygons before painting them. In situations, where points
            are far outside the visible area (f.e when zooming deep) this
-           might be a substantial improvement for the painting performance
+           might be a substantial improvement for the painting performance.
+
+           Curves without brush and curve fitter are split into
+           the visible parts, see QwtClipper::clipPolylineF().
          */
         ClipPolygons = 0x01,
 
@@ -222,13 +227,48 @@ class QWT_EXPORT QwtPlotCurve
            The algorithm is very fast and effective for huge datasets, and can be used
            inside a replot cycle.
 
-           \note Implemented for QwtPlotCurve::Lines only
+           For QwtPlotCurve::Sticks all sticks of a column are painted as one line.
+           For QwtPlotCurve::Steps the step function is built from the reduced points.
+           As the points in a column are connected by lines along the column,
+           the area between curve and baseline is the same for the reduced points,
+           when the curve is filled.
+
+           \note Implemented for QwtPlotCurve::Lines, QwtPlotCurve::Sticks
+                 and QwtPlotCurve::Steps
            \note As this algo replaces many small lines by a long one
                 a nasty bug of the raster paint engine ( Qt 4.8, Qt 5.1 - 5.3 )
                 becomes more dominant. For these versions the bug can be
                 worked around by enabling the QwtPainter::polylineSplitting() mode.
          */
         FilterPointsAggressive = 0x10,
+
+        /*!
+           Fit the spline of a QwtSplineCurveFitter in data coordinates
+           and cache the polynomials between replots.
+
+           When samples have been appended to the data only the polynomials,
+           that are affected according to QwtSpline::locality(), are
+           recalculated and only the visible polynomials are translated
+           into paint device coordinates. So the costs of a replot of
+           a growing curve are proportional to the number of new samples.
+
+           The cache is used for curves without a brush only, when the
+           spline is a QwtSplineInterpolating with a ParameterX, ParameterY
+           or ParameterUniform parametrization and both scales are linear.
+           Otherwise the curve is fitted in paint device coordinates
+           like without this attribute.
+
+           With ClipPolygons segments outside of the canvas are not
+           painted. FilterPoints and FilterPointsAggressive have no
+           effect on a cached curve, as the polynomials are calculated
+           from all samples.
+
+           \note Modifications of samples, that had been painted before,
+                 have to be announced by invalidateFittedCurve().
+
+           \sa Fitted, QwtSplineCurveFitter, invalidateFittedCurve()
+         */
+        CacheFittedCurve = 0x20
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -302,12 +342,16 @@ class QWT_EXPORT QwtPlotCurve
     void setCurveFitter( QwtCurveFitter* );
     QwtCurveFitter* curveFitter() const;
 
+    void invalidateFittedCurve( int from = 0 );
+
     virtual void drawSeries( QPainter*,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRectF& canvasRect, int from, int to ) const QWT_OVERRIDE;
 
     virtual QwtGraphic legendIcon( int index, const QSizeF& ) const QWT_OVERRIDE;
 
+    virtual QwtPlotItem* snapshot() const QWT_OVERRIDE;
+
   protected:
 
     void init();
@@ -343,7 +387,13 @@ class QWT_EXPORT QwtPlotCurve
     void closePolyline( QPainter*,
         const QwtScaleMap&, const QwtScaleMap&, QPolygonF& ) const;
 
+    virtual void dataChanged() QWT_OVERRIDE;
+
   private:
+    bool drawCachedFit( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& clipRect, int from, int to ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -17,11 +17,22 @@ class QwtPlotDict::PrivateData
     class ItemList : public QList< QwtPlotItem* >
     {
       public:
+        ItemList()
+            : isSortingDeferred( false )
+        {
+        }
+
         void insertItem( QwtPlotItem* item )
         {
             if ( item == NULL )
                 return;
 
+            if ( isSortingDeferred )
+            {
+                append( item );
+                return;
+            }
+
             QList< QwtPlotItem* >::iterator it =
                 std::upper_bound( begin(), end(), item, LessZThan() );
             insert( it, item );
@@ -32,6 +43,18 @@ class QwtPlotDict::PrivateData
             if ( item == NULL )
                 return;
 
+            if ( isSortingDeferred )
+            {
+                // the list is not sorted, but recently inserted
+                // items are at the end
+
+                const int index = lastIndexOf( item );
+                if ( index >= 0 )
+                    removeAt( index );
+
+                return;
+            }
+
             QList< QwtPlotItem* >::iterator it =
                 std::lower_bound( begin(), end(), item, LessZThan() );
 
@@ -44,6 +67,14 @@ class QwtPlotDict::PrivateData
                 }
             }
         }
+        void sortItems()
+        {
+            // stable: items with the same z value stay in the order of insertion
+            std::stable_sort( begin(), end(), LessZThan() );
+        }
+
+        bool isSortingDeferred;
+
       private:
         class LessZThan
         {
@@ -128,6 +159,38 @@ void QwtPlotDict::removeItem( QwtPlotItem* item )
     m_data->itemList.removeItem( item );
 }
 
+/*!
+   \brief En/Disable the sorting of inserted items
+
+   Inserting an item into the z-sorted list is an O(n) operation.
+   When inserting many items at once it is more efficient to append
+   them and to sort the list once, when sorting is enabled again.
+
+   \param on When true, items are appended to the list without sorting.
+             When false, the list gets sorted.
+
+   \sa isSortingDeferred(), itemList()
+   \note While sorting is deferred itemList() is not ordered by z value
+ */
+void QwtPlotDict::setSortingDeferred( bool on )
+{
+    if ( on == m_data->itemList.isSortingDeferred )
+        return;
+
+    m_data->itemList.isSortingDeferred = on;
+    if ( !on )
+        m_data->itemList.sortItems();
+}
+
+/*!
+   \return True, when sorting is deferred
+   \sa setSortingDeferred()
+ */
+bool QwtPlotDict::isSortingDeferred() const
+{
+    return m_data->itemList.isSortingDeferred;
+}
+
 /*!
    Detach items from the dictionary
 
@@ -48,6 +48,9 @@ class QWT_EXPORT QwtPlotDict
     void insertItem( QwtPlotItem* );
     void removeItem( QwtPlotItem* );
 
+    void setSortingDeferred( bool );
+    bool isSortingDeferred() const;
+
   private:
     class PrivateData;
     PrivateData* m_data;
@@ -12,10 +12,69 @@
 #include "qwt_plot.h"
 #include "qwt_plot_canvas.h"
 #include "qwt_plot_seriesitem.h"
+#include "qwt_plot_curve.h"
+#include "qwt_series_data.h"
+#include "qwt_symbol.h"
+#include "qwt_math.h"
 
 #include <qpainter.h>
 #include <qevent.h>
 #include <qpixmap.h>
+#include <qpointer.h>
+#include <qelapsedtimer.h>
+#include <qvector.h>
+
+namespace
+{
+    class SeriesRange
+    {
+      public:
+        SeriesRange()
+            : seriesItem( NULL )
+            , from( 0 )
+            , to( 0 )
+        {
+        }
+
+        SeriesRange( QwtPlotSeriesItem* item, int index1, int index2 )
+            : seriesItem( item )
+            , from( index1 )
+            , to( index2 )
+        {
+        }
+
+        bool merge( int index1, int index2 )
+        {
+            // to < 0 means: until the last point
+
+            if ( to >= 0 && index1 > to + 1 )
+                return false;
+
+            if ( index2 >= 0 && index2 + 1 < from )
+                return false;
+
+            from = qMin( from, index1 );
+
+            if ( to < 0 || index2 < 0 )
+                to = -1;
+            else
+                to = qMax( to, index2 );
+
+            return true;
+        }
+
+        QwtPlotSeriesItem* seriesItem;
+        int from;
+        int to;
+    };
+
+    class PlotBatch
+    {
+      public:
+        QPointer< QwtPlot > plot;
+        QVector< SeriesRange > ranges;
+    };
+}
 
 static inline void qwtRenderItem(
     QPainter* painter, const QRect& canvasRect,
@@ -33,6 +92,52 @@ static inline void qwtRenderItem(
     seriesItem->drawSeries( painter, xMap, yMap, canvasRect, from, to );
 }
 
+static QRect qwtDirtyRect( const QwtPlotSeriesItem* seriesItem,
+    int from, int to, const QRect& canvasRect )
+{
+    /*
+       For curves the bounding rectangle of the points, extended
+       by the size of pen and symbol, is good enough. Sticks, fills
+       or fitted curves might paint outside of it and for all
+       other types of series we simply don't know.
+     */
+
+    if ( seriesItem->rtti() != QwtPlotItem::Rtti_PlotCurve )
+        return canvasRect;
+
+    const QwtPlotCurve* curve =
+        static_cast< const QwtPlotCurve* >( seriesItem );
+
+    if ( curve->style() == QwtPlotCurve::Sticks
+        || curve->brush().style() != Qt::NoBrush
+        || curve->testCurveAttribute( QwtPlotCurve::Fitted ) )
+    {
+        return canvasRect;
+    }
+
+    const QRectF boundingRect = qwtBoundingRect( *curve->data(), from, to );
+    if ( boundingRect.width() < 0.0 || boundingRect.height() < 0.0 )
+        return QRect();
+
+    const QwtPlot* plot = curve->plot();
+
+    const QRectF rect = QwtScaleMap::transform(
+        plot->canvasMap( curve->xAxis() ),
+        plot->canvasMap( curve->yAxis() ), boundingRect );
+
+    int margin = qwtCeil( curve->pen().widthF() ) + 1;
+
+    const QwtSymbol* symbol = curve->symbol();
+    if ( symbol && symbol->style() != QwtSymbol::NoSymbol )
+    {
+        const QRect symbolRect = symbol->boundingRect();
+        margin += qMax( symbolRect.width(), symbolRect.height() );
+    }
+
+    return rect.toAlignedRect().adjusted(
+        -margin, -margin, margin, margin ) & canvasRect;
+}
+
 static inline bool qwtHasBackingStore( const QwtPlotCanvas* canvas )
 {
     return canvas->testPaintAttribute( QwtPlotCanvas::BackingStore )
@@ -44,9 +149,8 @@ class QwtPlotDirectPainter::PrivateData
   public:
     PrivateData()
         : hasClipping( false )
-        , seriesItem( NULL )
-        , from( 0 )
-        , to( 0 )
+        , frameInterval( 16 )
+        , timerId( 0 )
     {
     }
 
@@ -57,11 +161,18 @@ class QwtPlotDirectPainter::PrivateData
 
     QPainter painter;
 
-    QwtPlotSeriesItem* seriesItem;
-    int from;
-    int to;
+    // ranges to be painted in the paint event of a canvas
+    QVector< SeriesRange > pending;
+
+    // queued ranges of BatchedUpdates
+    QVector< PlotBatch > batches;
+
+    int frameInterval;
+    int timerId;
+    QElapsedTimer lastFlush;
 };
 
+
 //! Constructor
 QwtPlotDirectPainter::QwtPlotDirectPainter( QObject* parent )
     : QObject( parent )
@@ -81,6 +192,7 @@ QwtPlotDirectPainter::~QwtPlotDirectPainter()
    \param attribute Attribute to change
    \param on On/Off
 
+   \note Disabling BatchedUpdates paints the pending ranges by flush()
    \sa Attribute, testAttribute()
  */
 void QwtPlotDirectPainter::setAttribute( Attribute attribute, bool on )
@@ -94,6 +206,9 @@ void QwtPlotDirectPainter::setAttribute( Attribute attribute, bool on )
 
         if ( ( attribute == AtomicPainter ) && on )
             reset();
+
+        if ( ( attribute == BatchedUpdates ) && !on )
+            flush();
     }
 }
 
@@ -153,6 +268,29 @@ QRegion QwtPlotDirectPainter::clipRegion() const
     return m_data->clipRegion;
 }
 
+/*!
+   \brief Set the minimum distance between two flushes
+
+   In BatchedUpdates mode the queued ranges are painted, when
+   the interval since the previous flush has expired.
+
+   \param msecs Interval in milliseconds, the default is 16ms
+   \sa frameInterval(), flush(), BatchedUpdates
+ */
+void QwtPlotDirectPainter::setFrameInterval( int msecs )
+{
+    m_data->frameInterval = qMax( msecs, 0 );
+}
+
+/*!
+   \return Minimum distance between two flushes in milliseconds
+   \sa setFrameInterval()
+ */
+int QwtPlotDirectPainter::frameInterval() const
+{
+    return m_data->frameInterval;
+}
+
 /*!
    \brief Draw a set of points of a seriesItem.
 
@@ -168,6 +306,9 @@ QRegion QwtPlotDirectPainter::clipRegion() const
    \param from Index of the first point to be painted
    \param to Index of the last point to be painted. If to < 0 the
          series will be painted to its last point.
+
+   \note In BatchedUpdates mode the range is queued only.
+   \sa flush()
  */
 void QwtPlotDirectPainter::drawSeries(
     QwtPlotSeriesItem* seriesItem, int from, int to )
@@ -175,6 +316,58 @@ void QwtPlotDirectPainter::drawSeries(
     if ( seriesItem == NULL || seriesItem->plot() == NULL )
         return;
 
+    if ( m_data->attributes & QwtPlotDirectPainter::BatchedUpdates )
+    {
+        QwtPlot* plot = seriesItem->plot();
+
+        PlotBatch* batch = NULL;
+        for ( int i = 0; i < m_data->batches.size(); i++ )
+        {
+            if ( m_data->batches[i].plot == plot )
+            {
+                batch = &m_data->batches[i];
+                break;
+            }
+        }
+
+        if ( batch == NULL )
+        {
+            m_data->batches += PlotBatch();
+
+            batch = &m_data->batches.last();
+            batch->plot = plot;
+        }
+
+        bool merged = false;
+        for ( int i = batch->ranges.size() - 1; i >= 0; i-- )
+        {
+            SeriesRange& range = batch->ranges[i];
+            if ( range.seriesItem == seriesItem )
+            {
+                merged = range.merge( from, to );
+                break;
+            }
+        }
+
+        if ( !merged )
+            batch->ranges += SeriesRange( seriesItem, from, to );
+
+        if ( m_data->timerId == 0 )
+        {
+            int delay = 0;
+            if ( m_data->lastFlush.isValid() )
+            {
+                const qint64 elapsed = m_data->lastFlush.elapsed();
+                if ( elapsed < m_data->frameInterval )
+                    delay = m_data->frameInterval - int( elapsed );
+            }
+
+            m_data->timerId = startTimer( delay );
+        }
+
+        return;
+    }
+
     QWidget* canvas = seriesItem->plot()->canvas();
     const QRect canvasRect = canvas->contentsRect();
 
@@ -244,22 +437,151 @@ void QwtPlotDirectPainter::drawSeries(
     {
         reset();
 
-        m_data->seriesItem = seriesItem;
-        m_data->from = from;
-        m_data->to = to;
+        m_data->pending += SeriesRange( seriesItem, from, to );
 
         QRegion clipRegion = canvasRect;
         if ( m_data->hasClipping )
             clipRegion &= m_data->clipRegion;
 
-        canvas->installEventFilter( this );
-        canvas->repaint(clipRegion);
-        canvas->removeEventFilter( this );
+        repaintCanvas( canvas, clipRegion );
+    }
+}
+
+/*!
+   \brief Paint all queued ranges
+
+   For each canvas the queued series are rendered with one QPainter
+   and the bounding region of the painted ranges is repainted at once.
+   Ranges of items, that have been detached in the meantime, are ignored.
+
+   flush() is called automatically, when the frame interval has expired.
 
-        m_data->seriesItem = NULL;
+   \sa BatchedUpdates, hasPendingUpdates(), setFrameInterval()
+ */
+void QwtPlotDirectPainter::flush()
+{
+    if ( m_data->timerId != 0 )
+    {
+        killTimer( m_data->timerId );
+        m_data->timerId = 0;
+    }
+
+    if ( m_data->batches.isEmpty() )
+        return;
+
+    m_data->lastFlush.start();
+
+    reset();
+
+    const QVector< PlotBatch > batches = m_data->batches;
+    m_data->batches.clear();
+
+    for ( int i = 0; i < batches.size(); i++ )
+    {
+        const QwtPlot* plot = batches[i].plot;
+        if ( plot == NULL )
+            continue;
+
+        const QwtPlotItemList& items = plot->itemList();
+
+        QVector< SeriesRange > ranges;
+        ranges.reserve( batches[i].ranges.size() );
+
+        for ( int j = 0; j < batches[i].ranges.size(); j++ )
+        {
+            const SeriesRange& range = batches[i].ranges[j];
+            if ( items.contains( range.seriesItem ) )
+                ranges += range;
+        }
+
+        if ( ranges.isEmpty() )
+            continue;
+
+        QWidget* canvas = plot->canvas();
+        const QRect canvasRect = canvas->contentsRect();
+
+        QRegion clipRegion = canvasRect;
+        if ( m_data->hasClipping )
+            clipRegion &= m_data->clipRegion;
+
+        QRegion dirtyRegion;
+        for ( int j = 0; j < ranges.size(); j++ )
+        {
+            const SeriesRange& range = ranges[j];
+            dirtyRegion += qwtDirtyRect( range.seriesItem,
+                range.from, range.to, canvasRect );
+        }
+
+        dirtyRegion &= clipRegion;
+
+        QwtPlotCanvas* plotCanvas = qobject_cast< QwtPlotCanvas* >( canvas );
+
+        if ( plotCanvas && qwtHasBackingStore( plotCanvas ) )
+        {
+            QPainter painter( const_cast< QPixmap* >( plotCanvas->backingStore() ) );
+
+            if ( m_data->hasClipping )
+                painter.setClipRegion( m_data->clipRegion );
+
+            m_data->pending = ranges;
+            renderPending( &painter, canvasRect );
+            m_data->pending.clear();
+
+            painter.end();
+
+            // QwtPlotCanvas::paintEvent() copies the backing store
+
+            if ( testAttribute( QwtPlotDirectPainter::FullRepaint ) )
+                plotCanvas->repaint();
+            else if ( !dirtyRegion.isEmpty() )
+                plotCanvas->repaint( dirtyRegion );
+        }
+        else
+        {
+            if ( !dirtyRegion.isEmpty() )
+            {
+                m_data->pending = ranges;
+                repaintCanvas( canvas, dirtyRegion );
+            }
+        }
     }
 }
 
+/*!
+   \return True, when ranges are queued for the next flush
+   \sa flush(), BatchedUpdates
+ */
+bool QwtPlotDirectPainter::hasPendingUpdates() const
+{
+    return !m_data->batches.isEmpty();
+}
+
+void QwtPlotDirectPainter::renderPending(
+    QPainter* painter, const QRect& canvasRect ) const
+{
+    for ( int i = 0; i < m_data->pending.size(); i++ )
+    {
+        const SeriesRange& range = m_data->pending[i];
+
+        painter->save();
+        qwtRenderItem( painter, canvasRect,
+            range.seriesItem, range.from, range.to );
+        painter->restore();
+    }
+}
+
+void QwtPlotDirectPainter::repaintCanvas(
+    QWidget* canvas, const QRegion& region )
+{
+    // the pending ranges are painted in eventFilter()
+
+    canvas->installEventFilter( this );
+    canvas->repaint( region );
+    canvas->removeEventFilter( this );
+
+    m_data->pending.clear();
+}
+
 //! Close the internal QPainter
 void QwtPlotDirectPainter::reset()
 {
@@ -280,11 +602,11 @@ bool QwtPlotDirectPainter::eventFilter( QObject*, QEvent* event )
     {
         reset();
 
-        if ( m_data->seriesItem )
+        if ( !m_data->pending.isEmpty() )
         {
             const QPaintEvent* pe = static_cast< QPaintEvent* >( event );
 
-            QWidget* canvas = m_data->seriesItem->plot()->canvas();
+            QWidget* canvas = m_data->pending.first().seriesItem->plot()->canvas();
 
             QPainter painter( canvas );
             painter.setClipRegion( pe->region() );
@@ -307,10 +629,7 @@ bool QwtPlotDirectPainter::eventFilter( QObject*, QEvent* event )
             }
 
             if ( !doCopyCache )
-            {
-                qwtRenderItem( &painter, canvas->contentsRect(),
-                    m_data->seriesItem, m_data->from, m_data->to );
-            }
+                renderPending( &painter, canvas->contentsRect() );
 
             return true; // don't call QwtPlotCanvas::paintEvent()
         }
@@ -318,3 +637,18 @@ bool QwtPlotDirectPainter::eventFilter( QObject*, QEvent* event )
 
     return false;
 }
+
+/*!
+   Flush the queued ranges, when the frame interval has expired
+   \param event Timer event
+ */
+void QwtPlotDirectPainter::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == m_data->timerId )
+    {
+        flush();
+        return;
+    }
+
+    QObject::timerEvent( event );
+}
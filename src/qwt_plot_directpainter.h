@@ -14,6 +14,9 @@
 #include <qobject.h>
 
 class QRegion;
+class QRect;
+class QPainter;
+class QWidget;
 class QwtPlotSeriesItem;
 
 /*!
@@ -32,6 +35,12 @@ class QwtPlotSeriesItem;
     of the backing store will be copied to a ( maybe unaccelerated )
     frame buffer.
 
+    Applications displaying many series, that are fed at the same time,
+    should enable BatchedUpdates. Then drawSeries() only queues the ranges,
+    that are rendered together with one QPainter per canvas, and the
+    canvas is repainted once per frame - for the bounding region of
+    what has been painted only.
+
     \warning Incremental painting will only help when no replot is triggered
              by another operation ( like changing scales ) and nothing needs
              to be erased.
@@ -67,7 +76,27 @@ class QWT_EXPORT QwtPlotDirectPainter : public QObject
            This flag can also be useful for settings, where Qt fills the
            the clip region with the widget background.
          */
-        CopyBackingStore = 0x04
+        CopyBackingStore = 0x04,
+
+        /*!
+           When BatchedUpdates is set drawSeries() queues the ranges
+           instead of painting them. The queued ranges are rendered
+           together, when the next frame is due ( see frameInterval() )
+           or flush() is called. Consecutive ranges of the same series
+           are merged.
+
+           Without a backing store each canvas is repainted once for
+           all of its series. With a backing store the series are
+           rendered into it and only the accumulated dirty region
+           of the canvas is repainted.
+
+           Disabling BatchedUpdates flushes the queue: the pending
+           ranges are painted before setAttribute() returns.
+
+           \warning Queued series items must not be deleted before
+                    the queue has been flushed.
+         */
+        BatchedUpdates = 0x08
     };
 
     Q_DECLARE_FLAGS( Attributes, Attribute )
@@ -84,12 +113,24 @@ class QWT_EXPORT QwtPlotDirectPainter : public QObject
     void setClipRegion( const QRegion& );
     QRegion clipRegion() const;
 
+    void setFrameInterval( int msecs );
+    int frameInterval() const;
+
     void drawSeries( QwtPlotSeriesItem*, int from, int to );
     void reset();
 
+    void flush();
+    bool hasPendingUpdates() const;
+
     virtual bool eventFilter( QObject*, QEvent* ) QWT_OVERRIDE;
 
+  protected:
+    virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
+
   private:
+    void renderPending( QPainter*, const QRect& canvasRect ) const;
+    void repaintCanvas( QWidget* canvas, const QRegion& );
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -0,0 +1,854 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_eventmarker.h"
+#include "qwt_painter.h"
+#include "qwt_scale_map.h"
+#include "qwt_text.h"
+#include "qwt_graphic.h"
+#include "qwt_math.h"
+
+#include <qpainter.h>
+#include <qstatictext.h>
+#include <qvector.h>
+#include <qhash.h>
+#include <qfont.h>
+#include <qline.h>
+#include <qmath.h>
+
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+
+namespace
+{
+    class PositionLessThan
+    {
+      public:
+        PositionLessThan( const QVector< double >& positions )
+            : m_positions( positions )
+        {
+        }
+
+        bool operator()( int index1, int index2 ) const
+        {
+            return m_positions[index1] < m_positions[index2];
+        }
+
+      private:
+        const QVector< double >& m_positions;
+    };
+}
+
+/*
+   Rectangle occupied by a label in painter coordinates, aligned like
+   the label of a QwtPlotMarker::VLine/QwtPlotMarker::HLine marker
+ */
+static QRectF qwtLabelRect( Qt::Orientation orientation,
+    Qt::Alignment labelAlignment, Qt::Orientation labelOrientation,
+    qreal offset, const QRectF& canvasRect, double pos, const QSizeF& textSize )
+{
+    Qt::Alignment align = labelAlignment;
+    QPointF alignPos;
+
+    if ( orientation == Qt::Vertical )
+    {
+        alignPos.setX( pos );
+
+        if ( labelAlignment & Qt::AlignTop )
+        {
+            alignPos.setY( canvasRect.top() );
+            align &= ~Qt::AlignTop;
+            align |= Qt::AlignBottom;
+        }
+        else if ( labelAlignment & Qt::AlignBottom )
+        {
+            alignPos.setY( canvasRect.bottom() - 1 );
+            align &= ~Qt::AlignBottom;
+            align |= Qt::AlignTop;
+        }
+        else
+        {
+            alignPos.setY( canvasRect.center().y() );
+        }
+    }
+    else
+    {
+        alignPos.setY( pos );
+
+        if ( labelAlignment & Qt::AlignLeft )
+        {
+            alignPos.setX( canvasRect.left() );
+            align &= ~Qt::AlignLeft;
+            align |= Qt::AlignRight;
+        }
+        else if ( labelAlignment & Qt::AlignRight )
+        {
+            alignPos.setX( canvasRect.right() - 1 );
+            align &= ~Qt::AlignRight;
+            align |= Qt::AlignLeft;
+        }
+        else
+        {
+            alignPos.setX( canvasRect.center().x() );
+        }
+    }
+
+    const bool isVertical = ( labelOrientation == Qt::Vertical );
+
+    // extent of the rotated label
+    const qreal w = isVertical ? textSize.height() : textSize.width();
+    const qreal h = isVertical ? textSize.width() : textSize.height();
+
+    if ( align & Qt::AlignLeft )
+        alignPos.rx() -= offset + w;
+    else if ( align & Qt::AlignRight )
+        alignPos.rx() += offset;
+    else
+        alignPos.rx() -= w / 2;
+
+    if ( align & Qt::AlignTop )
+        alignPos.ry() -= offset + h;
+    else if ( align & Qt::AlignBottom )
+        alignPos.ry() += offset;
+    else
+        alignPos.ry() -= h / 2;
+
+    return QRectF( alignPos, QSizeF( w, h ) );
+}
+
+class QwtPlotEventMarker::PrivateData
+{
+  public:
+    PrivateData()
+        : orientation( Qt::Vertical )
+        , labelAlignment( Qt::AlignTop | Qt::AlignRight )
+        , labelOrientation( Qt::Horizontal )
+        , labelColor( Qt::black )
+        , spacing( 2 )
+    {
+    }
+
+    QStaticText labelText( int index ) const
+    {
+        const QHash< int, QStaticText >::const_iterator it =
+            labelCache.constFind( index );
+
+        if ( it != labelCache.constEnd() )
+            return it.value();
+
+        // bounding the memory for panning through many events
+        if ( labelCache.size() >= 10000 )
+            labelCache.clear();
+
+        QStaticText text( labels[index] );
+        text.setTextFormat( Qt::PlainText );
+        text.setPerformanceHint( QStaticText::AggressiveCaching );
+        text.prepare( QTransform(), labelFont );
+
+        labelCache.insert( index, text );
+
+        return text;
+    }
+
+    Qt::Orientation orientation;
+
+    // sorted in increasing order
+    QVector< double > positions;
+    QStringList labels;
+
+    QPen pen;
+
+    QFont labelFont;
+    Qt::Alignment labelAlignment;
+    Qt::Orientation labelOrientation;
+    QColor labelColor;
+
+    int spacing;
+
+    // text layouts by the index of the event
+    mutable QHash< int, QStaticText > labelCache;
+};
+
+/*!
+   \brief Constructor
+   \param title Title of the item
+ */
+QwtPlotEventMarker::QwtPlotEventMarker( const QString& title )
+    : QwtPlotItem( QwtText( title ) )
+{
+    init();
+}
+
+/*!
+   \brief Constructor
+   \param title Title of the item
+ */
+QwtPlotEventMarker::QwtPlotEventMarker( const QwtText& title )
+    : QwtPlotItem( title )
+{
+    init();
+}
+
+//! Destructor
+QwtPlotEventMarker::~QwtPlotEventMarker()
+{
+    delete m_data;
+}
+
+//! Initialize data members
+void QwtPlotEventMarker::init()
+{
+    m_data = new PrivateData;
+    setZ( 30.0 );
+}
+
+//! \return QwtPlotItem::Rtti_PlotEventMarker
+int QwtPlotEventMarker::rtti() const
+{
+    return QwtPlotItem::Rtti_PlotEventMarker;
+}
+
+/*!
+   \brief Set the orientation of the markers
+
+   For Qt::Vertical the events are positions on the x axis and
+   displayed as vertical lines. For Qt::Horizontal they are
+   positions on the y axis displayed as horizontal lines.
+
+   \param orientation Orientation
+   \sa orientation()
+ */
+void QwtPlotEventMarker::setOrientation( Qt::Orientation orientation )
+{
+    if ( orientation != m_data->orientation )
+    {
+        m_data->orientation = orientation;
+
+        legendChanged();
+        itemChanged();
+    }
+}
+
+/*!
+   \return Orientation of the markers
+   \sa setOrientation()
+ */
+Qt::Orientation QwtPlotEventMarker::orientation() const
+{
+    return m_data->orientation;
+}
+
+/*!
+   \brief Assign the events
+
+   The events are sorted by their positions. Events with a position,
+   that is not a finite number are ignored.
+
+   \param positions Positions of the events
+   \param labels Labels of the events. Missing labels are
+                 treated like empty strings.
+
+   \sa addEvent(), clearEvents()
+ */
+void QwtPlotEventMarker::setEvents(
+    const QVector< double >& positions, const QStringList& labels )
+{
+    QVector< double >& p = m_data->positions;
+    QStringList& l = m_data->labels;
+
+    p.clear();
+    l.clear();
+
+    p.reserve( positions.size() );
+    l.reserve( positions.size() );
+
+    bool isSorted = true;
+
+    for ( int i = 0; i < positions.size(); i++ )
+    {
+        const double value = positions[i];
+        if ( !qIsFinite( value ) )
+            continue;
+
+        if ( !p.isEmpty() && value < p.last() )
+            isSorted = false;
+
+        p += value;
+        l += ( i < labels.size() ) ? labels[i] : QString();
+    }
+
+    if ( !isSorted )
+    {
+        QVector< int > indexes( p.size() );
+        for ( int i = 0; i < indexes.size(); i++ )
+            indexes[i] = i;
+
+        std::stable_sort( indexes.begin(), indexes.end(), PositionLessThan( p ) );
+
+        QVector< double > sortedPositions( p.size() );
+        QStringList sortedLabels;
+        sortedLabels.reserve( l.size() );
+
+        for ( int i = 0; i < indexes.size(); i++ )
+        {
+            sortedPositions[i] = p[ indexes[i] ];
+            sortedLabels += l[ indexes[i] ];
+        }
+
+        p = sortedPositions;
+        l = sortedLabels;
+    }
+
+    m_data->labelCache.clear();
+    itemChanged();
+}
+
+/*!
+   \brief Insert an event
+
+   The event is inserted behind all events with the same position.
+   Appending events in increasing order is O(1).
+
+   \param position Position of the event
+   \param label Label of the event
+   \note Events with a position, that is not a finite number are ignored
+   \sa setEvents(), clearEvents()
+ */
+void QwtPlotEventMarker::addEvent( double position, const QString& label )
+{
+    if ( !qIsFinite( position ) )
+        return;
+
+    QVector< double >& p = m_data->positions;
+
+    const int index = std::upper_bound( p.constBegin(),
+        p.constEnd(), position ) - p.constBegin();
+
+    if ( index < p.size() )
+    {
+        // indexes behind the new event are shifted
+        m_data->labelCache.clear();
+    }
+
+    p.insert( index, position );
+    m_data->labels.insert( index, label );
+
+    itemChanged();
+}
+
+/*!
+   \brief Remove all events
+   \sa setEvents(), addEvent()
+ */
+void QwtPlotEventMarker::clearEvents()
+{
+    if ( m_data->positions.isEmpty() )
+        return;
+
+    m_data->positions.clear();
+    m_data->labels.clear();
+    m_data->labelCache.clear();
+
+    itemChanged();
+}
+
+//! \return Number of events
+int QwtPlotEventMarker::eventCount() const
+{
+    return m_data->positions.size();
+}
+
+/*!
+   \param index Index of the event, events are sorted by position
+   \return Position of the event
+ */
+double QwtPlotEventMarker::eventPosition( int index ) const
+{
+    return m_data->positions[index];
+}
+
+/*!
+   \param index Index of the event, events are sorted by position
+   \return Label of the event
+ */
+QString QwtPlotEventMarker::eventLabel( int index ) const
+{
+    return m_data->labels[index];
+}
+
+/*!
+   Build and assign a line pen
+
+   In Qt5 the default pen width is 1.0 ( 0.0 in Qt4 ) what makes it
+   non cosmetic ( see QPen::isCosmetic() ). This method has been introduced
+   to hide this incompatibility.
+
+   \param color Pen color
+   \param width Pen width
+   \param style Pen style
+
+   \sa linePen()
+ */
+void QwtPlotEventMarker::setLinePen(
+    const QColor& color, qreal width, Qt::PenStyle style )
+{
+    setLinePen( QPen( color, width, style ) );
+}
+
+/*!
+   Specify a pen for the lines. Qt::NoPen disables the lines.
+
+   \param pen New pen
+   \sa linePen()
+ */
+void QwtPlotEventMarker::setLinePen( const QPen& pen )
+{
+    if ( pen != m_data->pen )
+    {
+        m_data->pen = pen;
+
+        legendChanged();
+        itemChanged();
+    }
+}
+
+/*!
+   \return Pen of the lines
+   \sa setLinePen()
+ */
+const QPen& QwtPlotEventMarker::linePen() const
+{
+    return m_data->pen;
+}
+
+/*!
+   \brief Set the font of the labels
+   \param font Font
+   \sa labelFont(), setLabelColor()
+ */
+void QwtPlotEventMarker::setLabelFont( const QFont& font )
+{
+    if ( font != m_data->labelFont )
+    {
+        m_data->labelFont = font;
+        m_data->labelCache.clear();
+
+        itemChanged();
+    }
+}
+
+/*!
+   \return Font of the labels
+   \sa setLabelFont()
+ */
+QFont QwtPlotEventMarker::labelFont() const
+{
+    return m_data->labelFont;
+}
+
+/*!
+   \brief Set the color of the labels
+   \param color Color
+   \sa labelColor(), setLabelFont()
+ */
+void QwtPlotEventMarker::setLabelColor( const QColor& color )
+{
+    if ( color != m_data->labelColor )
+    {
+        m_data->labelColor = color;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Color of the labels
+   \sa setLabelColor()
+ */
+QColor QwtPlotEventMarker::labelColor() const
+{
+    return m_data->labelColor;
+}
+
+/*!
+   \brief Set the alignment of the labels
+
+   The alignment is interpreted like for the labels of a QwtPlotMarker
+   with the QwtPlotMarker::VLine ( or QwtPlotMarker::HLine ) style:
+   the flags along the axis are relative to the position of the event,
+   the flags of the other direction are relative to the canvas.
+
+   The default setting is Qt::AlignTop | Qt::AlignRight.
+
+   \param align Alignment
+   \sa labelAlignment(), QwtPlotMarker::setLabelAlignment()
+ */
+void QwtPlotEventMarker::setLabelAlignment( Qt::Alignment align )
+{
+    if ( align != m_data->labelAlignment )
+    {
+        m_data->labelAlignment = align;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Alignment of the labels
+   \sa setLabelAlignment()
+ */
+Qt::Alignment QwtPlotEventMarker::labelAlignment() const
+{
+    return m_data->labelAlignment;
+}
+
+/*!
+   \brief Set the orientation of the labels
+
+   When orientation is Qt::Vertical the labels are rotated by 90.0 degrees
+   ( from bottom to top ).
+
+   \param orientation Orientation of the labels
+   \sa labelOrientation(), setLabelAlignment()
+ */
+void QwtPlotEventMarker::setLabelOrientation( Qt::Orientation orientation )
+{
+    if ( orientation != m_data->labelOrientation )
+    {
+        m_data->labelOrientation = orientation;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Orientation of the labels
+   \sa setLabelOrientation()
+ */
+Qt::Orientation QwtPlotEventMarker::labelOrientation() const
+{
+    return m_data->labelOrientation;
+}
+
+/*!
+   \brief Set the spacing
+
+   The spacing is the distance between a line and its label,
+   and the minimum distance between two labels.
+
+   \param spacing Spacing
+   \sa spacing()
+ */
+void QwtPlotEventMarker::setSpacing( int spacing )
+{
+    if ( spacing < 0 )
+        spacing = 0;
+
+    if ( spacing != m_data->spacing )
+    {
+        m_data->spacing = spacing;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Spacing
+   \sa setSpacing()
+ */
+int QwtPlotEventMarker::spacing() const
+{
+    return m_data->spacing;
+}
+
+/*!
+   Draw the events inside of the canvas
+
+   \param painter Painter
+   \param xMap x Scale Map
+   \param yMap y Scale Map
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+
+   \sa drawLines(), drawLabels()
+ */
+void QwtPlotEventMarker::draw( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    const QVector< double >& positions = m_data->positions;
+    if ( positions.isEmpty() )
+        return;
+
+    const bool isVertical = ( m_data->orientation == Qt::Vertical );
+    const QwtScaleMap& map = isVertical ? xMap : yMap;
+
+    double v1, v2;
+    if ( isVertical )
+    {
+        v1 = map.invTransform( canvasRect.left() );
+        v2 = map.invTransform( canvasRect.right() );
+    }
+    else
+    {
+        v1 = map.invTransform( canvasRect.top() );
+        v2 = map.invTransform( canvasRect.bottom() );
+    }
+
+    if ( v1 > v2 )
+        qSwap( v1, v2 );
+
+    const int from = std::lower_bound( positions.constBegin(),
+        positions.constEnd(), v1 ) - positions.constBegin();
+
+    const int to = std::upper_bound( positions.constBegin(),
+        positions.constEnd(), v2 ) - positions.constBegin() - 1;
+
+    if ( from > to )
+        return;
+
+    drawLines( painter, map, canvasRect, from, to );
+    drawLabels( painter, map, canvasRect, from, to );
+}
+
+/*!
+   Draw the lines of a range of events
+
+   With QwtPainter::roundingAlignment() only one line is drawn for
+   events, that are mapped to the same pixel.
+
+   \param painter Painter
+   \param map Scale map of the axis, where the events are positioned
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+   \param from Index of the first event
+   \param to Index of the last event
+
+   \sa drawLabels()
+ */
+void QwtPlotEventMarker::drawLines( QPainter* painter,
+    const QwtScaleMap& map, const QRectF& canvasRect, int from, int to ) const
+{
+    if ( m_data->pen.style() == Qt::NoPen )
+        return;
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+    const bool isVertical = ( m_data->orientation == Qt::Vertical );
+
+    const double extent = isVertical ? canvasRect.width() : canvasRect.height();
+
+    QVector< QLineF > lines;
+    lines.reserve( qMin( to - from + 1, qCeil( extent ) + 1 ) );
+
+    double lastPos = 0.0;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        double pos = map.transform( m_data->positions[i] );
+
+        if ( doAlign )
+        {
+            pos = qRound( pos );
+
+            // events are sorted: equal pixels are adjacent
+            if ( i > from && pos == lastPos )
+                continue;
+
+            lastPos = pos;
+        }
+
+        if ( isVertical )
+        {
+            lines += QLineF( pos, canvasRect.top(),
+                pos, canvasRect.bottom() - 1.0 );
+        }
+        else
+        {
+            lines += QLineF( canvasRect.left(), pos,
+                canvasRect.right() - 1.0, pos );
+        }
+    }
+
+    painter->setPen( m_data->pen );
+    painter->drawLines( lines );
+}
+
+/*!
+   Draw the labels of a range of events
+
+   The labels are processed in increasing pixel order. A label is skipped,
+   when it is closer than spacing() to the label that has been drawn before.
+   For most of the skipped labels the text doesn't even need to be laid out.
+
+   \param painter Painter
+   \param map Scale map of the axis, where the events are positioned
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+   \param from Index of the first event
+   \param to Index of the last event
+
+   \sa drawLines(), setSpacing()
+ */
+void QwtPlotEventMarker::drawLabels( QPainter* painter,
+    const QwtScaleMap& map, const QRectF& canvasRect, int from, int to ) const
+{
+    const bool isVertical = ( m_data->orientation == Qt::Vertical );
+    const int spacing = m_data->spacing;
+
+    qreal pw2 = m_data->pen.widthF() / 2.0;
+    if ( pw2 == 0.0 || m_data->pen.style() == Qt::NoPen )
+        pw2 = 0.5;
+
+    const qreal offset = pw2 + spacing;
+
+    const bool isIncreasing =
+        map.transform( m_data->positions[from] ) <= map.transform( m_data->positions[to] );
+
+    painter->setFont( m_data->labelFont );
+    painter->setPen( m_data->labelColor );
+
+    double lastEnd = -std::numeric_limits< double >::max();
+
+    for ( int k = from; k <= to; k++ )
+    {
+        const int i = isIncreasing ? k : ( from + to - k );
+
+        if ( m_data->labels[i].isEmpty() )
+            continue;
+
+        const double pos = map.transform( m_data->positions[i] );
+
+        /*
+            The label starts at pos + offset at the latest.
+            When this is already too close to the previous label
+            we don't need to lay it out.
+         */
+        if ( pos + offset < lastEnd + spacing )
+            continue;
+
+        const QStaticText text = m_data->labelText( i );
+
+        const QRectF rect = qwtLabelRect( m_data->orientation,
+            m_data->labelAlignment, m_data->labelOrientation,
+            offset, canvasRect, pos, text.size() );
+
+        const double start = isVertical ? rect.left() : rect.top();
+        if ( start < lastEnd + spacing )
+            continue;
+
+        if ( m_data->labelOrientation == Qt::Vertical )
+        {
+            painter->save();
+
+            painter->translate( rect.left(), rect.bottom() );
+            painter->rotate( -90.0 );
+            painter->drawStaticText( QPointF( 0.0, 0.0 ), text );
+
+            painter->restore();
+        }
+        else
+        {
+            painter->drawStaticText( rect.topLeft(), text );
+        }
+
+        lastEnd = isVertical ? rect.right() : rect.bottom();
+    }
+}
+
+/*!
+   \return Bounding rectangle of the event positions. The extent in the
+           other direction is invalid, so that it doesn't affect the
+           autoscale calculation.
+ */
+QRectF QwtPlotEventMarker::boundingRect() const
+{
+    const QVector< double >& positions = m_data->positions;
+    if ( positions.isEmpty() )
+        return QwtPlotItem::boundingRect();
+
+    const double min = positions.first();
+    const double max = positions.last();
+
+    if ( m_data->orientation == Qt::Vertical )
+        return QRectF( min, 0.0, max - min, -1.0 );
+
+    return QRectF( 0.0, min, -1.0, max - min );
+}
+
+/*!
+   \return Icon representing the markers on the legend
+
+   \param index Index of the legend entry
+                ( usually there is only one )
+   \param size Icon size
+
+   \sa setLegendIconSize(), legendData()
+ */
+QwtGraphic QwtPlotEventMarker::legendIcon(
+    int index, const QSizeF& size ) const
+{
+    Q_UNUSED( index );
+
+    if ( size.isEmpty() )
+        return QwtGraphic();
+
+    QwtGraphic icon;
+    icon.setDefaultSize( size );
+    icon.setRenderHint( QwtGraphic::RenderPensUnscaled, true );
+
+    QPainter painter( &icon );
+    painter.setRenderHint( QPainter::Antialiasing,
+        testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+    painter.setPen( m_data->pen );
+
+    if ( m_data->orientation == Qt::Vertical )
+    {
+        const double x = 0.5 * size.width();
+        QwtPainter::drawLine( &painter, x, 0.0, x, size.height() );
+    }
+    else
+    {
+        const double y = 0.5 * size.height();
+        QwtPainter::drawLine( &painter, 0.0, y, size.width(), y );
+    }
+
+    return icon;
+}
+
+/*!
+   \brief Create a copy of the item, that can be rendered in another thread
+
+   The events are implicitly shared, so that taking a snapshot is cheap.
+   The layout cache of the labels is not copied.
+
+   \return Snapshot, that has to be deleted by the caller. NULL for
+           derived classes, as they might reimplement drawLines() or
+           drawLabels(). QwtPlotSnapshot records those to a QwtGraphic.
+
+   \note Derived classes, that reimplement one of the draw methods,
+         need to reimplement snapshot() to avoid the recording.
+   \sa QwtPlotItem::snapshot()
+ */
+QwtPlotItem* QwtPlotEventMarker::snapshot() const
+{
+    if ( typeid( *this ) != typeid( QwtPlotEventMarker ) )
+        return NULL;
+
+    QwtPlotEventMarker* marker = new QwtPlotEventMarker();
+    initSnapshot( marker );
+
+    PrivateData* d = marker->m_data;
+
+    d->orientation = m_data->orientation;
+    d->positions = m_data->positions;
+    d->labels = m_data->labels;
+    d->pen = m_data->pen;
+    d->labelFont = m_data->labelFont;
+    d->labelAlignment = m_data->labelAlignment;
+    d->labelOrientation = m_data->labelOrientation;
+    d->labelColor = m_data->labelColor;
+    d->spacing = m_data->spacing;
+
+    return marker;
+}
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_EVENT_MARKER_H
+#define QWT_PLOT_EVENT_MARKER_H
+
+#include "qwt_global.h"
+#include "qwt_plot_item.h"
+
+#include <qstring.h>
+#include <qstringlist.h>
+
+class QFont;
+class QColor;
+class QPen;
+class QwtText;
+template< typename T > class QVector;
+
+/*!
+   \brief A plot item for many markers along an axis
+
+   Annotating a trace with thousands of events is expensive with
+   QwtPlotMarker, as each marker is a separate item, that is laid out
+   and painted on its own. QwtPlotEventMarker stores the positions of
+   all events in one array sorted by value - together with an optional
+   plain text label for each of them.
+
+   For vertical orientation each event is displayed as a vertical line at its x
+   position. For horizontal orientation a horizontal line at its y position
+   is drawn instead. The costs of draw() depend on the size of the
+   canvas more than on the number of events:
+
+   - the events inside of the canvas are found by a binary search
+   - with QwtPainter::roundingAlignment() only one line is drawn
+     for all events, that are mapped to the same pixel
+   - all lines are painted with one QPainter::drawLines() call
+   - labels, that would overlap the previous label, are skipped.
+     As all labels are aligned to the same side of the canvas,
+     only the extent along the axis needs to be checked.
+   - the text layouts of the labels are cached by QStaticText
+
+   \note Labels of events outside of the canvas are not displayed
+   \sa QwtPlotMarker
+ */
+class QWT_EXPORT QwtPlotEventMarker : public QwtPlotItem
+{
+  public:
+    explicit QwtPlotEventMarker( const QString& title = QString() );
+    explicit QwtPlotEventMarker( const QwtText& title );
+
+    virtual ~QwtPlotEventMarker();
+
+    virtual int rtti() const QWT_OVERRIDE;
+
+    void setOrientation( Qt::Orientation );
+    Qt::Orientation orientation() const;
+
+    void setEvents( const QVector< double >& positions,
+        const QStringList& labels = QStringList() );
+
+    void addEvent( double position, const QString& label = QString() );
+    void clearEvents();
+
+    int eventCount() const;
+    double eventPosition( int index ) const;
+    QString eventLabel( int index ) const;
+
+    void setLinePen( const QColor&, qreal width = 0.0, Qt::PenStyle = Qt::SolidLine );
+    void setLinePen( const QPen& );
+    const QPen& linePen() const;
+
+    void setLabelFont( const QFont& );
+    QFont labelFont() const;
+
+    void setLabelColor( const QColor& );
+    QColor labelColor() const;
+
+    void setLabelAlignment( Qt::Alignment );
+    Qt::Alignment labelAlignment() const;
+
+    void setLabelOrientation( Qt::Orientation );
+    Qt::Orientation labelOrientation() const;
+
+    void setSpacing( int );
+    int spacing() const;
+
+    virtual void draw( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual QwtGraphic legendIcon(
+        int index, const QSizeF& ) const QWT_OVERRIDE;
+
+    virtual QwtPlotItem* snapshot() const QWT_OVERRIDE;
+
+  protected:
+    virtual void drawLines( QPainter*, const QwtScaleMap&,
+        const QRectF& canvasRect, int from, int to ) const;
+
+    virtual void drawLabels( QPainter*, const QwtScaleMap&,
+        const QRectF& canvasRect, int from, int to ) const;
+
+  private:
+    void init();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
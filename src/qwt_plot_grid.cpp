@@ -441,3 +441,19 @@ void QwtPlotGrid::updateScaleDiv( const QwtScaleDiv& xScaleDiv,
     setXDiv( xScaleDiv );
     setYDiv( yScaleDiv );
 }
+
+/*!
+   \brief Create a copy of the grid, that can be rendered in another thread
+
+   \return Snapshot, that has to be deleted by the caller
+   \sa QwtPlotItem::snapshot()
+ */
+QwtPlotItem* QwtPlotGrid::snapshot() const
+{
+    QwtPlotGrid* grid = new QwtPlotGrid();
+    initSnapshot( grid );
+
+    *grid->m_data = *m_data;
+
+    return grid;
+}
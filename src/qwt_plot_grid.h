@@ -78,6 +78,8 @@ class QWT_EXPORT QwtPlotGrid : public QwtPlotItem
     virtual void updateScaleDiv(
         const QwtScaleDiv& xScaleDiv, const QwtScaleDiv& yScaleDiv ) QWT_OVERRIDE;
 
+    virtual QwtPlotItem* snapshot() const QWT_OVERRIDE;
+
   private:
     void drawLines( QPainter*, const QRectF&,
         Qt::Orientation, const QwtScaleMap&,
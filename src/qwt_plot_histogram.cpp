@@ -16,6 +16,8 @@
 #include <qstring.h>
 #include <qpainter.h>
 
+#include <typeinfo>
+
 static inline bool qwtIsCombinable( const QwtInterval& d1,
     const QwtInterval& d2 )
 {
@@ -690,3 +692,46 @@ QwtGraphic QwtPlotHistogram::legendIcon( int index, const QSizeF& size ) const
     Q_UNUSED( index );
     return defaultIcon( m_data->brush, size );
 }
+
+/*!
+   \brief Create a copy of the histogram, that can be rendered in another thread
+
+   \return Snapshot, that has to be deleted by the caller
+   \note Derived classes, that reimplement one of the draw methods,
+         need to reimplement snapshot() as well.
+   \sa QwtPlotItem::snapshot(), QwtSeriesData::snapshot()
+ */
+QwtPlotItem* QwtPlotHistogram::snapshot() const
+{
+    QwtColumnSymbol* symbol = NULL;
+    if ( m_data->symbol )
+    {
+        symbol = m_data->symbol->snapshot();
+        if ( symbol == NULL )
+            return NULL;
+
+        if ( typeid( *symbol ) != typeid( *m_data->symbol ) )
+        {
+            // a derived symbol, that does not reimplement snapshot()
+            delete symbol;
+            return NULL;
+        }
+    }
+
+    QwtPlotHistogram* histogram = new QwtPlotHistogram();
+    initSnapshot( histogram );
+
+    histogram->setOrientation( orientation() );
+
+    PrivateData* d = histogram->m_data;
+
+    d->baseline = m_data->baseline;
+    d->pen = m_data->pen;
+    d->brush = m_data->brush;
+    d->style = m_data->style;
+    d->symbol = symbol;
+
+    histogram->setData( data() ? data()->snapshot() : NULL );
+
+    return histogram;
+}
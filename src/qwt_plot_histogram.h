@@ -115,6 +115,8 @@ class QWT_EXPORT QwtPlotHistogram
     virtual QwtGraphic legendIcon(
         int index, const QSizeF& ) const QWT_OVERRIDE;
 
+    virtual QwtPlotItem* snapshot() const QWT_OVERRIDE;
+
   protected:
     virtual QwtColumnRect columnRect( const QwtIntervalSample&,
         const QwtScaleMap&, const QwtScaleMap& ) const;
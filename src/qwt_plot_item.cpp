@@ -473,15 +473,18 @@ bool QwtPlotItem::isVisible() const
 }
 
 /*!
-   Update the legend and call QwtPlot::autoRefresh() for the
-   parent plot.
+   Call QwtPlot::autoRefresh() for the parent plot and
+   emit QwtPlot::itemChanged().
 
    \sa QwtPlot::legendChanged(), QwtPlot::autoRefresh()
  */
 void QwtPlotItem::itemChanged()
 {
     if ( m_data->plot )
+    {
         m_data->plot->autoRefresh();
+        Q_EMIT m_data->plot->itemChanged( this );
+    }
 }
 
 /*!
@@ -725,3 +728,42 @@ QRectF QwtPlotItem::paintRect( const QwtScaleMap& xMap,
 
     return rect;
 }
+
+/*!
+   \brief Create a copy of the item, that can be rendered in another thread
+
+   A snapshot is not attached to a plot and shares nothing with
+   the item, that might be modified, while the snapshot is drawn.
+   Series data is copied using QwtSeriesData::snapshot(), what is
+   a cheap shallow copy for implicitly shared containers.
+
+   The default implementation returns NULL, indicating that the item
+   doesn't support snapshots. QwtPlotSnapshot records those
+   items to a QwtGraphic instead. The same happens, when the type
+   of the snapshot differs from the type of the item, because a
+   derived class did not reimplement snapshot().
+
+   \return Snapshot, that has to be deleted by the caller, or NULL
+   \sa initSnapshot(), QwtPlotSnapshot
+ */
+QwtPlotItem* QwtPlotItem::snapshot() const
+{
+    return NULL;
+}
+
+/*!
+   \brief Copy the attributes of QwtPlotItem to a snapshot
+
+   Title, z value, axes, visibility, item attributes and
+   render hints are copied, the snapshot remains detached.
+
+   \param item Snapshot, created by an implementation of snapshot()
+ */
+void QwtPlotItem::initSnapshot( QwtPlotItem* item ) const
+{
+    if ( item == NULL || item == this )
+        return;
+
+    *item->m_data = *m_data;
+    item->m_data->plot = NULL;
+}
@@ -128,6 +128,9 @@ class QWT_EXPORT QwtPlotItem
         //! For QwtPlotVectorField
         Rtti_PlotVectorField,
 
+        //! For QwtPlotEventMarker
+        Rtti_PlotEventMarker,
+
         /*!
            Values >= Rtti_PlotUserItem are reserved for plot items
            not implemented in the Qwt library.
@@ -291,8 +294,11 @@ class QWT_EXPORT QwtPlotItem
 
     virtual QwtGraphic legendIcon( int index, const QSizeF& ) const;
 
+    virtual QwtPlotItem* snapshot() const;
+
   protected:
     QwtGraphic defaultIcon( const QBrush&, const QSizeF& ) const;
+    void initSnapshot( QwtPlotItem* ) const;
 
   private:
     Q_DISABLE_COPY(QwtPlotItem)
@@ -17,6 +17,8 @@
 
 #include <qpainter.h>
 
+#include <typeinfo>
+
 class QwtPlotMarker::PrivateData
 {
   public:
@@ -642,3 +644,46 @@ QwtGraphic QwtPlotMarker::legendIcon( int index, const QSizeF& size ) const
     return icon;
 }
 
+/*!
+   \brief Create a copy of the marker, that can be rendered in another thread
+
+   \return Snapshot, that has to be deleted by the caller
+   \note Derived classes, that reimplement one of the draw methods,
+         need to reimplement snapshot() as well.
+   \sa QwtPlotItem::snapshot()
+ */
+QwtPlotItem* QwtPlotMarker::snapshot() const
+{
+    QwtSymbol* symbol = NULL;
+    if ( m_data->symbol )
+    {
+        symbol = m_data->symbol->snapshot();
+        if ( symbol == NULL )
+            return NULL;
+
+        if ( typeid( *symbol ) != typeid( *m_data->symbol ) )
+        {
+            // a derived symbol, that does not reimplement snapshot()
+            delete symbol;
+            return NULL;
+        }
+    }
+
+    QwtPlotMarker* marker = new QwtPlotMarker();
+    initSnapshot( marker );
+
+    PrivateData* d = marker->m_data;
+
+    d->label = m_data->label;
+    d->labelAlignment = m_data->labelAlignment;
+    d->labelOrientation = m_data->labelOrientation;
+    d->spacing = m_data->spacing;
+    d->pen = m_data->pen;
+    d->symbol = symbol;
+    d->style = m_data->style;
+    d->xValue = m_data->xValue;
+    d->yValue = m_data->yValue;
+
+    return marker;
+}
+
@@ -113,6 +113,8 @@ class QWT_EXPORT QwtPlotMarker : public QwtPlotItem
     virtual QwtGraphic legendIcon(
         int index, const QSizeF& ) const QWT_OVERRIDE;
 
+    virtual QwtPlotItem* snapshot() const QWT_OVERRIDE;
+
   protected:
     virtual void drawLines( QPainter*,
         const QRectF&, const QPointF& ) const;
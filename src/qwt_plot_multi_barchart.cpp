@@ -16,6 +16,7 @@
 #include "qwt_math.h"
 
 #include <qmap.h>
+#include <qvector.h>
 
 inline static bool qwtIsIncreasing(
     const QwtScaleMap& map, const QVector< double >& values )
@@ -32,6 +33,193 @@ inline static bool qwtIsIncreasing(
     return !isInverting;
 }
 
+template< class BarSink >
+static void qwtGroupedBars( Qt::Orientation orientation,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap, double baseline,
+    double sampleWidth, const QwtSetSample& sample, BarSink& sink )
+{
+    const int numBars = sample.set.size();
+    if ( numBars == 0 )
+        return;
+
+    if ( orientation == Qt::Vertical )
+    {
+        const double barWidth = sampleWidth / numBars;
+
+        const double y1 = yMap.transform( baseline );
+        const double x0 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
+
+        for ( int i = 0; i < numBars; i++ )
+        {
+            const double x1 = x0 + i * barWidth;
+            const double x2 = x1 + barWidth;
+
+            const double y2 = yMap.transform( sample.set[i] );
+
+            QwtColumnRect barRect;
+            barRect.direction = ( y1 < y2 ) ?
+                QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
+
+            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
+            if ( i != 0 )
+                barRect.hInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
+
+            barRect.vInterval = QwtInterval( y1, y2 ).normalized();
+
+            sink.append( i, barRect );
+        }
+    }
+    else
+    {
+        const double barHeight = sampleWidth / numBars;
+
+        const double x1 = xMap.transform( baseline );
+        const double y0 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
+
+        for ( int i = 0; i < numBars; i++ )
+        {
+            double y1 = y0 + i * barHeight;
+            double y2 = y1 + barHeight;
+
+            double x2 = xMap.transform( sample.set[i] );
+
+            QwtColumnRect barRect;
+            barRect.direction = x1 < x2 ?
+                QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
+
+            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
+
+            barRect.vInterval = QwtInterval( y1, y2 );
+            if ( i != 0 )
+                barRect.vInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
+
+            sink.append( i, barRect );
+        }
+    }
+}
+
+template< class BarSink >
+static void qwtStackedBars( Qt::Orientation orientation,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap, double baseline,
+    double sampleWidth, const QwtSetSample& sample, BarSink& sink )
+{
+    const int numBars = sample.set.size();
+    if ( numBars == 0 )
+        return;
+
+    QwtInterval::BorderFlag borderFlags = QwtInterval::IncludeBorders;
+
+    if ( orientation == Qt::Vertical )
+    {
+        const double x1 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
+        const double x2 = x1 + sampleWidth;
+
+        const bool increasing = qwtIsIncreasing( yMap, sample.set );
+
+        QwtColumnRect bar;
+        bar.direction = increasing ?
+            QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
+
+        bar.hInterval = QwtInterval( x1, x2 ).normalized();
+
+        double sum = baseline;
+
+        for ( int i = 0; i < numBars; i++ )
+        {
+            const double si = sample.set[ i ];
+            if ( si == 0.0 )
+                continue;
+
+            const double y1 = yMap.transform( sum );
+            const double y2 = yMap.transform( sum + si );
+
+            if ( ( y2 > y1 ) != increasing )
+            {
+                // stacked bars need to be in the same direction
+                continue;
+            }
+
+            bar.vInterval = QwtInterval( y1, y2 ).normalized();
+            bar.vInterval.setBorderFlags( borderFlags );
+
+            sink.append( i, bar );
+
+            sum += si;
+
+            if ( increasing )
+                borderFlags = QwtInterval::ExcludeMinimum;
+            else
+                borderFlags = QwtInterval::ExcludeMaximum;
+        }
+    }
+    else
+    {
+        const double y1 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
+        const double y2 = y1 + sampleWidth;
+
+        const bool increasing = qwtIsIncreasing( xMap, sample.set );
+
+        QwtColumnRect bar;
+        bar.direction = increasing ?
+            QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
+        bar.vInterval = QwtInterval( y1, y2 ).normalized();
+
+        double sum = baseline;
+
+        for ( int i = 0; i < sample.set.size(); i++ )
+        {
+            const double si = sample.set[ i ];
+            if ( si == 0.0 )
+                continue;
+
+            const double x1 = xMap.transform( sum );
+            const double x2 = xMap.transform( sum + si );
+
+            if ( ( x2 > x1 ) != increasing )
+            {
+                // stacked bars need to be in the same direction
+                continue;
+            }
+
+            bar.hInterval = QwtInterval( x1, x2 ).normalized();
+            bar.hInterval.setBorderFlags( borderFlags );
+
+            sink.append( i, bar );
+
+            sum += si;
+
+            if ( increasing )
+                borderFlags = QwtInterval::ExcludeMinimum;
+            else
+                borderFlags = QwtInterval::ExcludeMaximum;
+        }
+    }
+}
+
+namespace
+{
+    // collecting the bars of all samples for each value index
+    class BarCollector
+    {
+      public:
+        explicit BarCollector( QVector< QVector< QwtColumnRect > >& bars )
+            : m_bars( bars )
+        {
+        }
+
+        inline void append( int valueIndex, const QwtColumnRect& rect )
+        {
+            if ( valueIndex >= m_bars.size() )
+                m_bars.resize( valueIndex + 1 );
+
+            m_bars[valueIndex] += rect;
+        }
+
+      private:
+        QVector< QVector< QwtColumnRect > >& m_bars;
+    };
+}
+
 class QwtPlotMultiBarChart::PrivateData
 {
   public:
@@ -40,6 +228,29 @@ class QwtPlotMultiBarChart::PrivateData
     {
     }
 
+    // painting the bars of a sample with drawBar()
+    class BarPainter
+    {
+      public:
+        BarPainter( const QwtPlotMultiBarChart* chart,
+                QPainter* painter, int sampleIndex )
+            : m_chart( chart )
+            , m_painter( painter )
+            , m_sampleIndex( sampleIndex )
+        {
+        }
+
+        inline void append( int valueIndex, const QwtColumnRect& rect )
+        {
+            m_chart->drawBar( m_painter, m_sampleIndex, valueIndex, rect );
+        }
+
+      private:
+        const QwtPlotMultiBarChart* m_chart;
+        QPainter* m_painter;
+        const int m_sampleIndex;
+    };
+
     QwtPlotMultiBarChart::ChartStyle style;
     QList< QwtText > barTitles;
     QMap< int, QwtColumnSymbol* > symbolMap;
@@ -390,15 +601,92 @@ void QwtPlotMultiBarChart::drawSeries( QPainter* painter,
 
     painter->save();
 
-    for ( int i = from; i <= to; i++ )
+    if ( testPaintAttribute( QwtPlotAbstractBarChart::BatchBars ) )
+    {
+        drawBatchedBars( painter, xMap, yMap,
+            canvasRect, interval, from, to );
+    }
+    else
     {
-        drawSample( painter, xMap, yMap,
-            canvasRect, interval, i, sample( i ) );
+        for ( int i = from; i <= to; i++ )
+        {
+            drawSample( painter, xMap, yMap,
+                canvasRect, interval, i, sample( i ) );
+        }
     }
 
     painter->restore();
 }
 
+/*
+   Collect the bars of the same value index and draw them with
+   QwtColumnSymbol::drawColumns(), bypassing drawSample(), drawBar()
+   and specialSymbol().
+ */
+void QwtPlotMultiBarChart::drawBatchedBars( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, const QwtInterval& boundingInterval,
+    int from, int to ) const
+{
+    QwtColumnSymbol defaultSymbol( QwtColumnSymbol::Box );
+    defaultSymbol.setLineWidth( 1 );
+    defaultSymbol.setFrameStyle( QwtColumnSymbol::Plain );
+
+    const Qt::Orientation o = orientation();
+
+    QVector< QVector< QwtColumnRect > > bars;
+    BarCollector collector( bars );
+
+    const int chunkSize = 1000;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QwtSetSample setSample = sample( i );
+
+        if ( setSample.set.size() > 0 )
+        {
+            double sampleW;
+
+            if ( o == Qt::Horizontal )
+            {
+                sampleW = sampleWidth( yMap, canvasRect.height(),
+                    boundingInterval.width(), setSample.value );
+            }
+            else
+            {
+                sampleW = sampleWidth( xMap, canvasRect.width(),
+                    boundingInterval.width(), setSample.value );
+            }
+
+            if ( m_data->style == Stacked )
+            {
+                qwtStackedBars( o, xMap, yMap,
+                    baseline(), sampleW, setSample, collector );
+            }
+            else
+            {
+                qwtGroupedBars( o, xMap, yMap,
+                    baseline(), sampleW, setSample, collector );
+            }
+        }
+
+        if ( ( i - from ) % chunkSize == chunkSize - 1 || i == to )
+        {
+            for ( int valueIndex = 0; valueIndex < bars.size(); valueIndex++ )
+            {
+                QVector< QwtColumnRect >& columns = bars[valueIndex];
+
+                const QwtColumnSymbol* sym = symbol( valueIndex );
+                if ( sym == NULL )
+                    sym = &defaultSymbol;
+
+                sym->drawColumns( painter, columns.constData(), columns.size() );
+                columns.resize( 0 );
+            }
+        }
+    }
+}
+
 /*!
    Draw a sample
 
@@ -465,64 +753,10 @@ void QwtPlotMultiBarChart::drawGroupedBars( QPainter* painter,
 {
     Q_UNUSED( canvasRect );
 
-    const int numBars = sample.set.size();
-    if ( numBars == 0 )
-        return;
-
-    if ( orientation() == Qt::Vertical )
-    {
-        const double barWidth = sampleWidth / numBars;
-
-        const double y1 = yMap.transform( baseline() );
-        const double x0 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
-
-        for ( int i = 0; i < numBars; i++ )
-        {
-            const double x1 = x0 + i * barWidth;
-            const double x2 = x1 + barWidth;
-
-            const double y2 = yMap.transform( sample.set[i] );
-
-            QwtColumnRect barRect;
-            barRect.direction = ( y1 < y2 ) ?
-                QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
-
-            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
-            if ( i != 0 )
-                barRect.hInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
-
-            barRect.vInterval = QwtInterval( y1, y2 ).normalized();
-
-            drawBar( painter, index, i, barRect );
-        }
-    }
-    else
-    {
-        const double barHeight = sampleWidth / numBars;
+    PrivateData::BarPainter barPainter( this, painter, index );
 
-        const double x1 = xMap.transform( baseline() );
-        const double y0 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
-
-        for ( int i = 0; i < numBars; i++ )
-        {
-            double y1 = y0 + i * barHeight;
-            double y2 = y1 + barHeight;
-
-            double x2 = xMap.transform( sample.set[i] );
-
-            QwtColumnRect barRect;
-            barRect.direction = x1 < x2 ?
-                QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
-
-            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
-
-            barRect.vInterval = QwtInterval( y1, y2 );
-            if ( i != 0 )
-                barRect.vInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
-
-            drawBar( painter, index, i, barRect );
-        }
-    }
+    qwtGroupedBars( orientation(), xMap, yMap,
+        baseline(), sampleWidth, sample, barPainter );
 }
 
 /*!
@@ -545,97 +779,10 @@ void QwtPlotMultiBarChart::drawStackedBars( QPainter* painter,
 {
     Q_UNUSED( canvasRect ); // clipping the bars ?
 
-    const int numBars = sample.set.size();
-    if ( numBars == 0 )
-        return;
-
-    QwtInterval::BorderFlag borderFlags = QwtInterval::IncludeBorders;
-
-    if ( orientation() == Qt::Vertical )
-    {
-        const double x1 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
-        const double x2 = x1 + sampleWidth;
-
-        const bool increasing = qwtIsIncreasing( yMap, sample.set );
+    PrivateData::BarPainter barPainter( this, painter, index );
 
-        QwtColumnRect bar;
-        bar.direction = increasing ?
-            QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
-
-        bar.hInterval = QwtInterval( x1, x2 ).normalized();
-
-        double sum = baseline();
-
-        for ( int i = 0; i < numBars; i++ )
-        {
-            const double si = sample.set[ i ];
-            if ( si == 0.0 )
-                continue;
-
-            const double y1 = yMap.transform( sum );
-            const double y2 = yMap.transform( sum + si );
-
-            if ( ( y2 > y1 ) != increasing )
-            {
-                // stacked bars need to be in the same direction
-                continue;
-            }
-
-            bar.vInterval = QwtInterval( y1, y2 ).normalized();
-            bar.vInterval.setBorderFlags( borderFlags );
-
-            drawBar( painter, index, i, bar );
-
-            sum += si;
-
-            if ( increasing )
-                borderFlags = QwtInterval::ExcludeMinimum;
-            else
-                borderFlags = QwtInterval::ExcludeMaximum;
-        }
-    }
-    else
-    {
-        const double y1 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
-        const double y2 = y1 + sampleWidth;
-
-        const bool increasing = qwtIsIncreasing( xMap, sample.set );
-
-        QwtColumnRect bar;
-        bar.direction = increasing ?
-            QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
-        bar.vInterval = QwtInterval( y1, y2 ).normalized();
-
-        double sum = baseline();
-
-        for ( int i = 0; i < sample.set.size(); i++ )
-        {
-            const double si = sample.set[ i ];
-            if ( si == 0.0 )
-                continue;
-
-            const double x1 = xMap.transform( sum );
-            const double x2 = xMap.transform( sum + si );
-
-            if ( ( x2 > x1 ) != increasing )
-            {
-                // stacked bars need to be in the same direction
-                continue;
-            }
-
-            bar.hInterval = QwtInterval( x1, x2 ).normalized();
-            bar.hInterval.setBorderFlags( borderFlags );
-
-            drawBar( painter, index, i, bar );
-
-            sum += si;
-
-            if ( increasing )
-                borderFlags = QwtInterval::ExcludeMinimum;
-            else
-                borderFlags = QwtInterval::ExcludeMaximum;
-        }
-    }
+    qwtStackedBars( orientation(), xMap, yMap,
+        baseline(), sampleWidth, sample, barPainter );
 }
 
 /*!
@@ -32,6 +32,9 @@ template< typename T > class QwtSeriesData;
    or vertically. The bars cover the interval between the baseline()
    and the value.
 
+   For charts with many more samples than pixels the BatchBars
+   paint attribute can be enabled.
+
    In opposite to most other plot items, QwtPlotMultiBarChart returns more
    than one entry for the legend - one for each symbol.
 
@@ -122,6 +125,11 @@ class QWT_EXPORT QwtPlotMultiBarChart
   private:
     void init();
 
+    void drawBatchedBars( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, const QwtInterval& boundingInterval,
+        int from, int to ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -12,7 +12,16 @@
 #include "qwt_plot.h"
 #include "qwt_scale_map.h"
 #include "qwt_painter.h"
-
+#include "qwt_math.h"
+#include "qwt_plot_canvas.h"
+#include "qwt_plot_curve.h"
+#include "qwt_plot_marker.h"
+#include "qwt_symbol.h"
+#include "qwt_text.h"
+
+#include <qcoreapplication.h>
+#include <qevent.h>
+#include <qvector.h>
 #include <qbitmap.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
@@ -104,16 +113,95 @@ static QBitmap qwtBorderMask( const QWidget* canvas, const QSize& size )
     return QBitmap::fromImage( mask );
 }
 
+static bool qwtIsScrollable( const QwtPlot* plot )
+{
+    // items, that are aligned to the canvas, can't be scrolled
+
+    const QwtPlotItemList& items = plot->itemList();
+    for ( QwtPlotItemIterator it = items.begin(); it != items.end(); ++it )
+    {
+        const QwtPlotItem* item = *it;
+        if ( !item->isVisible() )
+            continue;
+
+        switch( item->rtti() )
+        {
+            case QwtPlotItem::Rtti_PlotLegend:
+            case QwtPlotItem::Rtti_PlotTextLabel:
+            case QwtPlotItem::Rtti_PlotScale:
+            {
+                return false;
+            }
+            case QwtPlotItem::Rtti_PlotMarker:
+            {
+                // the label of a line is aligned to the canvas
+
+                const QwtPlotMarker* marker =
+                    static_cast< const QwtPlotMarker* >( item );
+
+                if ( marker->lineStyle() != QwtPlotMarker::NoLine
+                    && !marker->label().isEmpty() )
+                {
+                    return false;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+static int qwtStripMargin( const QwtPlot* plot )
+{
+    /*
+       Symbols are culled, when their position is outside of
+       the area to be painted. So we have to paint a bit more to
+       catch the symbols reaching into a strip from outside.
+     */
+
+    int margin = 2;
+
+    const QwtPlotItemList items = plot->itemList( QwtPlotItem::Rtti_PlotCurve );
+    for ( QwtPlotItemIterator it = items.begin(); it != items.end(); ++it )
+    {
+        const QwtPlotCurve* curve = static_cast< const QwtPlotCurve* >( *it );
+        if ( !curve->isVisible() )
+            continue;
+
+        int extent = qwtCeil( curve->pen().widthF() );
+
+        const QwtSymbol* symbol = curve->symbol();
+        if ( symbol && symbol->style() != QwtSymbol::NoSymbol )
+        {
+            const QRect r = symbol->boundingRect();
+            extent += qMax( r.width(), r.height() );
+        }
+
+        margin = qMax( margin, extent + 2 );
+    }
+
+    return margin;
+}
+
 class QwtPlotPanner::PrivateData
 {
   public:
     PrivateData()
+        : isLivePanning( false )
     {
         for ( int axis = 0; axis < QwtAxis::AxisPositions; axis++ )
             isAxisEnabled[axis] = true;
     }
 
     bool isAxisEnabled[QwtAxis::AxisPositions];
+
+    bool isLivePanning;
+
+    // offset, that has already been applied to the axes while dragging
+    QPoint liveOffset;
 };
 
 /*!
@@ -132,6 +220,9 @@ QwtPlotPanner::QwtPlotPanner( QWidget* canvas )
 
     connect( this, SIGNAL(panned(int,int)),
         SLOT(moveCanvas(int,int)) );
+
+    connect( this, SIGNAL(moved(int,int)),
+        SLOT(moveCanvasLive(int,int)) );
 }
 
 //! Destructor
@@ -173,6 +264,39 @@ bool QwtPlotPanner::isAxisEnabled( QwtAxisId axisId ) const
     return true;
 }
 
+/*!
+   \brief En/Disable live panning
+
+   In live panning mode the scales are adjusted for each mouse move
+   and the canvas shows the plot at its current position, while dragging.
+
+   For a QwtPlotCanvas with a backing store the content of the backing
+   store is scrolled and only the strips, that have been exposed, are
+   rendered. Otherwise - or when the plot contains items, that are aligned
+   to the canvas ( like QwtPlotLegendItem or QwtPlotTextLabel ) -
+   the canvas is replotted for each mouse move.
+
+   \param on On/Off
+   \sa isLivePanning(), QwtPlotCanvas::BackingStore
+
+   \note Plot items, that are aligned to the canvas, but can't be
+         identified by their rtti(), won't be displayed correctly
+         until the mouse button is released.
+ */
+void QwtPlotPanner::setLivePanning( bool on )
+{
+    m_data->isLivePanning = on;
+}
+
+/*!
+   \return True, when live panning is enabled
+   \sa setLivePanning()
+ */
+bool QwtPlotPanner::isLivePanning() const
+{
+    return m_data->isLivePanning;
+}
+
 //! Return observed plot canvas
 QWidget* QwtPlotPanner::canvas()
 {
@@ -215,13 +339,124 @@ const QwtPlot* QwtPlotPanner::plot() const
  */
 void QwtPlotPanner::moveCanvas( int dx, int dy )
 {
+    QwtPlot* plot = this->plot();
+    if ( plot == NULL )
+        return;
+
+    if ( !m_data->liveOffset.isNull() )
+    {
+        // the axes have already been adjusted, while dragging
+
+        dx -= m_data->liveOffset.x();
+        dy -= m_data->liveOffset.y();
+
+        m_data->liveOffset = QPoint();
+
+        if ( dx == 0 && dy == 0 )
+        {
+            plot->replot();
+            return;
+        }
+    }
+
     if ( dx == 0 && dy == 0 )
         return;
 
+    shiftAxes( plot, dx, dy );
+    plot->replot();
+}
+
+/*!
+   Cancel live panning, when the abort key has been pressed
+
+   \param keyEvent Key event
+   \sa QwtPanner::setAbortKey()
+ */
+void QwtPlotPanner::widgetKeyPressEvent( QKeyEvent* keyEvent )
+{
+    const bool isPanning = isVisible();
+
+    QwtPanner::widgetKeyPressEvent( keyEvent );
+
+    if ( isPanning && !isVisible() && !m_data->liveOffset.isNull() )
+    {
+        const QPoint offset = m_data->liveOffset;
+        m_data->liveOffset = QPoint();
+
+        QwtPlot* plot = this->plot();
+        if ( plot )
+        {
+            shiftAxes( plot, -offset.x(), -offset.y() );
+            plot->replot();
+        }
+    }
+}
+
+/*!
+   Finish live panning, when the mouse button has been released
+
+   \param mouseEvent Mouse event
+   \sa moveCanvas()
+ */
+void QwtPlotPanner::widgetMouseReleaseEvent( QMouseEvent* mouseEvent )
+{
+    QwtPanner::widgetMouseReleaseEvent( mouseEvent );
+
+    if ( !m_data->liveOffset.isNull() )
+    {
+        // released at the initial position: panned() is not emitted
+        moveCanvas( 0, 0 );
+    }
+}
+
+/*!
+   Paint the grabbed canvas, unless live panning is enabled
+
+   \param event Paint event
+ */
+void QwtPlotPanner::paintEvent( QPaintEvent* event )
+{
+    if ( m_data->isLivePanning )
+    {
+        // the canvas below is visible
+        return;
+    }
+
+    QwtPanner::paintEvent( event );
+}
+
+void QwtPlotPanner::moveCanvasLive( int dx, int dy )
+{
+    if ( !m_data->isLivePanning )
+        return;
+
     QwtPlot* plot = this->plot();
     if ( plot == NULL )
         return;
 
+    const QPoint step = QPoint( dx, dy ) - m_data->liveOffset;
+    if ( step.isNull() )
+        return;
+
+    m_data->liveOffset = QPoint( dx, dy );
+
+    const QRect canvasRect = canvas()->contentsRect();
+
+    shiftAxes( plot, step.x(), step.y() );
+    plot->updateAxes();
+
+    // the tick labels might need a different amount of space
+    QCoreApplication::sendPostedEvents( plot, QEvent::LayoutRequest );
+
+    if ( canvas()->contentsRect() != canvasRect
+        || !scrollCanvas( plot, step.x(), step.y() ) )
+    {
+        plot->replot();
+    }
+}
+
+void QwtPlotPanner::shiftAxes( QwtPlot* plot, int dx, int dy )
+{
     const bool doAutoReplot = plot->autoReplot();
     plot->setAutoReplot( false );
 
@@ -255,7 +490,99 @@ void QwtPlotPanner::moveCanvas( int dx, int dy )
     }
 
     plot->setAutoReplot( doAutoReplot );
-    plot->replot();
+}
+
+bool QwtPlotPanner::scrollCanvas( QwtPlot* plot, int dx, int dy )
+{
+    QwtPlotCanvas* plotCanvas = qobject_cast< QwtPlotCanvas* >( canvas() );
+    if ( plotCanvas == NULL || plotCanvas->borderRadius() > 0.0 )
+        return false;
+
+    if ( !plotCanvas->testPaintAttribute( QwtPlotCanvas::BackingStore )
+        || plotCanvas->backingStore() == NULL
+        || plotCanvas->backingStore()->isNull() )
+    {
+        return false;
+    }
+
+    QPixmap* backingStore = const_cast< QPixmap* >( plotCanvas->backingStore() );
+
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( backingStore );
+    const int ratio = qRound( pixelRatio );
+
+    if ( ratio != pixelRatio
+        || backingStore->size() != plotCanvas->size() * ratio )
+    {
+        return false;
+    }
+
+    const QRect canvasRect = plotCanvas->contentsRect();
+    if ( qAbs( dx ) >= canvasRect.width() || qAbs( dy ) >= canvasRect.height() )
+        return false;
+
+    if ( !qwtIsScrollable( plot ) )
+        return false;
+
+    backingStore->scroll( dx * ratio, dy * ratio,
+        QRect( canvasRect.topLeft() * ratio, canvasRect.size() * ratio ) );
+
+    // the strips, that have been exposed
+
+    QRect rect = canvasRect;
+    QVector< QRect > strips;
+
+    if ( dx > 0 )
+    {
+        strips += QRect( rect.left(), rect.top(), dx, rect.height() );
+        rect.setLeft( rect.left() + dx );
+    }
+    else if ( dx < 0 )
+    {
+        strips += QRect( rect.right() + 1 + dx, rect.top(), -dx, rect.height() );
+        rect.setRight( rect.right() + dx );
+    }
+
+    if ( dy > 0 )
+        strips += QRect( rect.left(), rect.top(), rect.width(), dy );
+    else if ( dy < 0 )
+        strips += QRect( rect.left(), rect.bottom() + 1 + dy, rect.width(), -dy );
+
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+        maps[axisPos] = plot->canvasMap( axisPos );
+
+    const int margin = qwtStripMargin( plot );
+
+    QPainter painter( backingStore );
+
+    for ( int i = 0; i < strips.size(); i++ )
+    {
+        const QRect& strip = strips[i];
+
+        /*
+           Rendering to a separate pixmap without clipping - otherwise
+           the plot items would cull anything outside of the strip.
+         */
+        const QRect renderRect =
+            strip.adjusted( -margin, -margin, margin, margin ) & canvasRect;
+
+        QPixmap pm = QwtPainter::backingStore( plotCanvas, renderRect.size() );
+        QwtPainter::fillPixmap( plotCanvas, pm, renderRect.topLeft() );
+
+        QPainter p( &pm );
+        p.translate( -renderRect.topLeft() );
+        plot->drawItems( &p, renderRect, maps );
+        p.end();
+
+        painter.setClipRect( strip );
+        painter.drawPixmap( renderRect.topLeft(), pm );
+    }
+
+    painter.end();
+
+    plotCanvas->update( canvasRect );
+
+    return true;
 }
 
 /*!
@@ -266,6 +593,9 @@ void QwtPlotPanner::moveCanvas( int dx, int dy )
  */
 QBitmap QwtPlotPanner::contentsMask() const
 {
+    if ( m_data->isLivePanning )
+        return QBitmap();
+
     if ( canvas() )
         return qwtBorderMask( canvas(), size() );
 
@@ -277,6 +607,12 @@ QBitmap QwtPlotPanner::contentsMask() const
  */
 QPixmap QwtPlotPanner::grab() const
 {
+    if ( m_data->isLivePanning )
+    {
+        // nothing to grab, the canvas is updated while panning
+        return QPixmap();
+    }
+
     const QWidget* cv = canvas();
     if ( cv && cv->inherits( "QGLWidget" ) )
     {
@@ -26,8 +26,13 @@ class QwtPlot;
    Together with QwtPlotZoomer and QwtPlotMagnifier powerful ways
    of navigating on a QwtPlot widget can be implemented easily.
 
-   \note The axes are not updated, while dragging the canvas
-   \sa QwtPlotZoomer, QwtPlotMagnifier
+   In live panning mode the axes follow the mouse while dragging.
+   Instead of replotting the canvas for each mouse move, its backing
+   store is scrolled and only the newly exposed strips are rendered.
+
+   \note The axes are not updated, while dragging the canvas,
+         unless live panning is enabled
+   \sa QwtPlotZoomer, QwtPlotMagnifier, setLivePanning()
  */
 class QWT_EXPORT QwtPlotPanner : public QwtPanner
 {
@@ -46,14 +51,28 @@ class QWT_EXPORT QwtPlotPanner : public QwtPanner
     void setAxisEnabled( QwtAxisId axisId, bool on );
     bool isAxisEnabled( QwtAxisId ) const;
 
+    void setLivePanning( bool );
+    bool isLivePanning() const;
+
   public Q_SLOTS:
     virtual void moveCanvas( int dx, int dy );
 
   protected:
+    virtual void widgetMouseReleaseEvent( QMouseEvent* ) QWT_OVERRIDE;
+    virtual void widgetKeyPressEvent( QKeyEvent* ) QWT_OVERRIDE;
+
+    virtual void paintEvent( QPaintEvent* ) QWT_OVERRIDE;
+
     virtual QBitmap contentsMask() const QWT_OVERRIDE;
     virtual QPixmap grab() const QWT_OVERRIDE;
 
+  private Q_SLOTS:
+    void moveCanvasLive( int dx, int dy );
+
   private:
+    void shiftAxes( QwtPlot*, int dx, int dy );
+    bool scrollCanvas( QwtPlot*, int dx, int dy );
+
     class PrivateData;
     PrivateData* m_data;
 };
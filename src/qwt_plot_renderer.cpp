@@ -9,6 +9,7 @@
 
 #include "qwt_plot_renderer.h"
 #include "qwt_plot.h"
+#include "qwt_plot_snapshot.h"
 #include "qwt_painter.h"
 #include "qwt_plot_layout.h"
 #include "qwt_abstract_legend.h"
@@ -663,6 +664,64 @@ void QwtPlotRenderer::render( QwtPlot* plot,
 
 }
 
+/*!
+   \brief Render the canvas of a plot snapshot to a \c QPaintDevice
+
+   The snapshot is rendered to the complete paint device.
+   Unlike renderTo( QwtPlot*, QPaintDevice& ) it can be called
+   from any thread.
+
+   \param snapshot Snapshot of a plot
+   \param paintDevice Device to paint on, f.e a QImage
+
+   \sa render(), QwtPlotSnapshot
+ */
+void QwtPlotRenderer::renderTo(
+    const QwtPlotSnapshot& snapshot, QPaintDevice& paintDevice ) const
+{
+    int w = paintDevice.width();
+    int h = paintDevice.height();
+
+    QPainter p( &paintDevice );
+    render( snapshot, &p, QRectF( 0, 0, w, h ) );
+}
+
+/*!
+   \brief Paint the canvas of a plot snapshot into a given rectangle
+
+   The background of the canvas is painted unless DiscardBackground
+   or DiscardCanvasBackground is set. As a snapshot doesn't contain any
+   widgets, title, footer, scales and legend are not rendered.
+
+   \param snapshot Snapshot of a plot
+   \param painter Painter
+   \param canvasRect Bounding rectangle for the canvas contents
+
+   \sa renderTo(), QwtPlotSnapshot::draw()
+ */
+void QwtPlotRenderer::render( const QwtPlotSnapshot& snapshot,
+    QPainter* painter, const QRectF& canvasRect ) const
+{
+    if ( painter == 0 || !painter->isActive() ||
+        !canvasRect.isValid() || snapshot.isNull() )
+    {
+        return;
+    }
+
+    painter->save();
+
+    if ( !( m_data->discardFlags & DiscardBackground )
+        && !( m_data->discardFlags & DiscardCanvasBackground ) )
+    {
+        painter->fillRect( canvasRect, snapshot.canvasBackground() );
+    }
+
+    painter->setClipRect( canvasRect, Qt::IntersectClip );
+    snapshot.draw( painter, canvasRect );
+
+    painter->restore();
+}
+
 /*!
    Render the title into a given rectangle.
 
@@ -17,6 +17,7 @@
 #include <qsize.h>
 
 class QwtPlot;
+class QwtPlotSnapshot;
 class QwtScaleMap;
 class QRectF;
 class QPainter;
@@ -126,10 +127,14 @@ class QWT_EXPORT QwtPlotRenderer : public QObject
 #endif
 
     void renderTo( QwtPlot*, QPaintDevice& ) const;
+    void renderTo( const QwtPlotSnapshot&, QPaintDevice& ) const;
 
     virtual void render( QwtPlot*,
         QPainter*, const QRectF& plotRect ) const;
 
+    void render( const QwtPlotSnapshot&,
+        QPainter*, const QRectF& canvasRect ) const;
+
     virtual void renderTitle( const QwtPlot*,
         QPainter*, const QRectF& titleRect ) const;
 
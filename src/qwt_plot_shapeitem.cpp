@@ -18,6 +18,301 @@
 
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qvector.h>
+#include <qmap.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    class Subpath
+    {
+      public:
+        QRectF boundingRect;
+        QPolygonF polygon;
+
+        // simplified polygons by level
+        mutable QMap< int, QPolygonF > levels;
+    };
+
+    class BoxNode
+    {
+      public:
+        QRectF boundingRect;
+
+        // children, or -1 for leaves
+        int child1;
+        int child2;
+
+        // range of DetailCache::indexes for leaves
+        int from;
+        int count;
+    };
+
+    class CenterLessThan
+    {
+      public:
+        CenterLessThan( const QVector< Subpath >& subpaths, bool isHorizontal )
+            : m_subpaths( subpaths )
+            , m_isHorizontal( isHorizontal )
+        {
+        }
+
+        bool operator()( int index1, int index2 ) const
+        {
+            const QPointF c1 = m_subpaths[index1].boundingRect.center();
+            const QPointF c2 = m_subpaths[index2].boundingRect.center();
+
+            return m_isHorizontal ? ( c1.x() < c2.x() ) : ( c1.y() < c2.y() );
+        }
+
+      private:
+        const QVector< Subpath >& m_subpaths;
+        const bool m_isHorizontal;
+    };
+
+    /*
+        The subpaths of a shape in plot coordinates with a bounding
+        box hierarchy over them and simplified polygons for
+        different levels of detail
+     */
+    class DetailCache
+    {
+      public:
+        explicit DetailCache( const QPainterPath& path )
+        {
+            const QList< QPolygonF > polygons = path.toSubpathPolygons();
+
+            subpaths.resize( polygons.size() );
+            indexes.resize( polygons.size() );
+
+            for ( int i = 0; i < polygons.size(); i++ )
+            {
+                subpaths[i].polygon = polygons[i];
+                subpaths[i].boundingRect = polygons[i].boundingRect();
+
+                indexes[i] = i;
+            }
+
+            if ( !subpaths.isEmpty() )
+                insertNode( 0, subpaths.size() );
+        }
+
+        void visibleSubpaths( const QRectF& rect, QVector< int >& visibleIndexes ) const
+        {
+            if ( nodes.isEmpty() )
+                return;
+
+            QVector< int > stack;
+            stack += 0;
+
+            while ( !stack.isEmpty() )
+            {
+                const BoxNode& node = nodes[ stack.last() ];
+                stack.removeLast();
+
+                if ( !intersects( node.boundingRect, rect ) )
+                    continue;
+
+                if ( node.child1 >= 0 )
+                {
+                    stack += node.child1;
+                    stack += node.child2;
+                    continue;
+                }
+
+                for ( int i = node.from; i < node.from + node.count; i++ )
+                {
+                    const int index = indexes[i];
+                    if ( intersects( subpaths[index].boundingRect, rect ) )
+                        visibleIndexes += index;
+                }
+            }
+
+            // the same order of subpaths for each draw
+            std::sort( visibleIndexes.begin(), visibleIndexes.end() );
+        }
+
+        const QPolygonF& polygon( int index, int level ) const
+        {
+            const Subpath& subpath = subpaths[index];
+
+            if ( subpath.polygon.size() <= 4 )
+                return subpath.polygon;
+
+            QMap< int, QPolygonF >::const_iterator it = subpath.levels.constFind( level );
+            if ( it == subpath.levels.constEnd() )
+            {
+                // zooming around forever should not eat up the memory
+                if ( subpath.levels.size() >= 16 )
+                    subpath.levels.clear();
+
+                const QwtWeedingCurveFitter fitter( std::ldexp( 1.0, level ) );
+                it = subpath.levels.insert( level, fitter.fitCurve( subpath.polygon ) );
+            }
+
+            return it.value();
+        }
+
+        QVector< Subpath > subpaths;
+
+      private:
+        static inline bool intersects( const QRectF& r1, const QRectF& r2 )
+        {
+            // QRectF::intersects fails for rectangles with a width/height of 0
+
+            return !( r1.left() > r2.right() || r1.right() < r2.left()
+                || r1.top() > r2.bottom() || r1.bottom() < r2.top() );
+        }
+
+        int insertNode( int from, int count )
+        {
+            const int nodeIndex = nodes.size();
+            nodes.resize( nodeIndex + 1 );
+
+            QRectF rect = subpaths[ indexes[from] ].boundingRect;
+            for ( int i = from + 1; i < from + count; i++ )
+                rect |= subpaths[ indexes[i] ].boundingRect;
+
+            int child1 = -1;
+            int child2 = -1;
+
+            if ( count > 8 )
+            {
+                // splitting at the median of the longer side
+
+                const int count1 = count / 2;
+
+                int* begin = indexes.data() + from;
+                std::nth_element( begin, begin + count1, begin + count,
+                    CenterLessThan( subpaths, rect.width() >= rect.height() ) );
+
+                child1 = insertNode( from, count1 );
+                child2 = insertNode( from + count1, count - count1 );
+            }
+
+            BoxNode& node = nodes[nodeIndex];
+            node.boundingRect = rect;
+            node.child1 = child1;
+            node.child2 = child2;
+            node.from = from;
+            node.count = count;
+
+            return nodeIndex;
+        }
+
+        // subpaths ordered by the hierarchy
+        QVector< int > indexes;
+        QVector< BoxNode > nodes;
+    };
+}
+
+static bool qwtHasCurves( const QPainterPath& path )
+{
+    for ( int i = 0; i < path.elementCount(); i++ )
+    {
+        if ( path.elementAt( i ).type == QPainterPath::CurveToElement )
+            return true;
+    }
+
+    return false;
+}
+
+/*
+    Find the level, where the error of the simplified subpaths
+    is below tolerance in paint device coordinates. The tolerance of
+    a level is 2^level in plot coordinates.
+ */
+static bool qwtDetailLevel( const QwtScaleMap& xMap,
+    const QwtScaleMap& yMap, double tolerance, int& level )
+{
+    if ( xMap.transformation() || yMap.transformation() )
+        return false;
+
+    if ( xMap.sDist() == 0.0 || yMap.sDist() == 0.0 )
+        return false;
+
+    const double sx = qAbs( xMap.pDist() / xMap.sDist() );
+    const double sy = qAbs( yMap.pDist() / yMap.sDist() );
+
+    const double plotTolerance = tolerance / qwtMaxF( sx, sy );
+    if ( !( plotTolerance > 0.0 ) || !qIsFinite( plotTolerance ) )
+        return false;
+
+    int exponent;
+    ( void )std::frexp( plotTolerance, &exponent );
+
+    // 2^level <= plotTolerance
+    level = exponent - 1;
+
+    return true;
+}
+
+static QPolygonF qwtTransformPolygon( const QwtScaleMap& xMap,
+    const QwtScaleMap& yMap, const QPolygonF& polygon, bool doAlign )
+{
+    QPolygonF points( polygon.size() );
+
+    const QPointF* p = polygon.constData();
+    QPointF* q = points.data();
+
+    for ( int i = 0; i < polygon.size(); i++ )
+    {
+        double x = xMap.transform( p[i].x() );
+        double y = yMap.transform( p[i].y() );
+
+        if ( doAlign )
+        {
+            x = qRound( x );
+            y = qRound( y );
+        }
+
+        q[i] = QPointF( x, y );
+    }
+
+    return points;
+}
+
+static QPainterPath qwtDetailPath( const DetailCache* cache,
+    Qt::FillRule fillRule, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& clipRect, double renderTolerance, bool doClip, bool doAlign )
+{
+    QVector< int > indexes;
+    cache->visibleSubpaths( QwtScaleMap::invTransform(
+        xMap, yMap, clipRect ).normalized(), indexes );
+
+    int level = 0;
+    const bool doSimplify = qwtDetailLevel( xMap, yMap,
+        ( renderTolerance > 0.0 ) ? renderTolerance : 0.5, level );
+
+    // the simplified subpaths are already within renderTolerance
+    const bool doWeed = !doSimplify && ( renderTolerance > 0.0 );
+    const QwtWeedingCurveFitter fitter( renderTolerance );
+
+    QPainterPath path;
+    path.setFillRule( fillRule );
+
+    for ( int i = 0; i < indexes.size(); i++ )
+    {
+        const int index = indexes[i];
+
+        const QPolygonF& polygon = doSimplify
+            ? cache->polygon( index, level ) : cache->subpaths[index].polygon;
+
+        QPolygonF points = qwtTransformPolygon( xMap, yMap, polygon, doAlign );
+
+        if ( doClip )
+            QwtClipper::clipPolygonF( clipRect, points, true );
+
+        if ( doWeed )
+            points = fitter.fitCurve( points );
+
+        path.addPolygon( points );
+    }
+
+    return path;
+}
 
 static QPainterPath qwtTransformPath( const QwtScaleMap& xMap,
     const QwtScaleMap& yMap, const QPainterPath& path, bool doAlign )
@@ -86,7 +381,28 @@ class QwtPlotShapeItem::PrivateData
     PrivateData()
         : legendMode( QwtPlotShapeItem::LegendColor )
         , renderTolerance( 0.0 )
+        , hasCurves( false )
+        , detailCache( NULL )
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete detailCache;
+    }
+
+    const DetailCache* levelOfDetail() const
     {
+        if ( detailCache == NULL && !hasCurves )
+            detailCache = new DetailCache( shape );
+
+        return detailCache;
+    }
+
+    void invalidateDetailCache()
+    {
+        delete detailCache;
+        detailCache = NULL;
     }
 
     QwtPlotShapeItem::PaintAttributes paintAttributes;
@@ -98,6 +414,9 @@ class QwtPlotShapeItem::PrivateData
     QPen pen;
     QBrush brush;
     QPainterPath shape;
+    bool hasCurves;
+
+    mutable DetailCache* detailCache;
 };
 
 /*!
@@ -166,6 +485,9 @@ void QwtPlotShapeItem::setPaintAttribute( PaintAttribute attribute, bool on )
         m_data->paintAttributes |= attribute;
     else
         m_data->paintAttributes &= ~attribute;
+
+    if ( attribute == LevelOfDetail && !on )
+        m_data->invalidateDetailCache();
 }
 
 /*!
@@ -246,6 +568,9 @@ void QwtPlotShapeItem::setShape( const QPainterPath& shape )
     if ( shape != m_data->shape )
     {
         m_data->shape = shape;
+        m_data->hasCurves = qwtHasCurves( shape );
+        m_data->invalidateDetailCache();
+
         if ( shape.isEmpty() )
         {
             m_data->boundingRect = QwtPlotItem::boundingRect();
@@ -409,6 +734,27 @@ void QwtPlotShapeItem::draw( QPainter* painter,
 
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
+    if ( testPaintAttribute( QwtPlotShapeItem::LevelOfDetail ) )
+    {
+        const DetailCache* cache = m_data->levelOfDetail();
+        if ( cache )
+        {
+            const qreal pw = QwtPainter::effectivePenWidth( m_data->pen );
+            const QRectF clipRect = canvasRect.adjusted( -pw, -pw, pw, pw );
+
+            const QPainterPath path = qwtDetailPath( cache,
+                m_data->shape.fillRule(), xMap, yMap, clipRect,
+                m_data->renderTolerance,
+                testPaintAttribute( QwtPlotShapeItem::ClipPolygons ), doAlign );
+
+            painter->setPen( m_data->pen );
+            painter->setBrush( m_data->brush );
+
+            painter->drawPath( path );
+            return;
+        }
+    }
+
     QPainterPath path = qwtTransformPath( xMap, yMap,
         m_data->shape, doAlign );
 
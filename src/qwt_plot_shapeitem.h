@@ -56,6 +56,23 @@ class QWT_EXPORT QwtPlotShapeItem : public QwtPlotItem
            performance of paths composed from curves or ellipses.
          */
         ClipPolygons = 0x01,
+
+        /*!
+           Render shapes with many subpaths and points - like GIS outlines -
+           from a cache, that is built in plot coordinates:
+
+           - only the subpaths, that intersect with the canvas are
+             mapped, found by a bounding box hierarchy
+           - the subpaths are simplified by the Douglas-Peucker algorithm
+             for the current zoom level. The tolerance is renderTolerance(),
+             or half a pixel, when weeding is disabled.
+
+           The simplified subpaths are built on demand and kept for
+           each level. The attribute is ignored for shapes containing
+           curves and the simplification is disabled for
+           non linear scales.
+         */
+        LevelOfDetail = 0x02
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
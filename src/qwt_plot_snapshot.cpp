@@ -0,0 +1,299 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_snapshot.h"
+#include "qwt_plot.h"
+#include "qwt_plot_item.h"
+#include "qwt_scale_map.h"
+#include "qwt_graphic.h"
+
+#include <qpainter.h>
+#include <qwidget.h>
+#include <qlist.h>
+
+#include <typeinfo>
+
+namespace
+{
+    class Entry
+    {
+      public:
+        Entry()
+            : item( NULL )
+            , isAntialiased( false )
+        {
+        }
+
+        // a copy of the item, or NULL, when it has been recorded
+        QwtPlotItem* item;
+
+        QwtGraphic graphic;
+        bool isAntialiased;
+    };
+}
+
+class QwtPlotSnapshot::PrivateData
+{
+  public:
+    PrivateData()
+        : numRecorded( 0 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        for ( int i = 0; i < entries.size(); i++ )
+            delete entries[i].item;
+
+        entries.clear();
+        numRecorded = 0;
+
+        canvasRect = QRectF();
+        background = QBrush();
+    }
+
+    QList< Entry > entries;
+    int numRecorded;
+
+    QRectF canvasRect;
+    QBrush background;
+
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+};
+
+/*!
+   \brief Constructor
+
+   Creates a null snapshot
+   \sa update()
+ */
+QwtPlotSnapshot::QwtPlotSnapshot()
+{
+    m_data = new PrivateData;
+}
+
+/*!
+   \brief Constructor
+
+   \param plot Plot, that is copied
+   \sa update()
+ */
+QwtPlotSnapshot::QwtPlotSnapshot( const QwtPlot* plot )
+{
+    m_data = new PrivateData;
+    update( plot );
+}
+
+//! Destructor
+QwtPlotSnapshot::~QwtPlotSnapshot()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Take a snapshot of a plot
+
+   Replaces the previous content of the snapshot by the visible
+   items and the canvas maps of the plot.
+
+   \param plot Plot
+   \warning update() needs to be called from the GUI thread, while
+            the snapshot is not rendered in another thread.
+ */
+void QwtPlotSnapshot::update( const QwtPlot* plot )
+{
+    m_data->reset();
+
+    if ( plot == NULL || plot->canvas() == NULL )
+        return;
+
+    const QWidget* canvas = plot->canvas();
+
+    m_data->canvasRect = canvas->contentsRect();
+    m_data->background = canvas->palette().brush( canvas->backgroundRole() );
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+        m_data->maps[axisPos] = plot->canvasMap( axisPos );
+
+    const QwtPlotItemList& items = plot->itemList();
+    for ( QwtPlotItemIterator it = items.begin(); it != items.end(); ++it )
+    {
+        const QwtPlotItem* item = *it;
+        if ( item == NULL || !item->isVisible() )
+            continue;
+
+        Entry entry;
+        entry.isAntialiased = item->testRenderHint( QwtPlotItem::RenderAntialiased );
+        entry.item = item->snapshot();
+
+        if ( entry.item && typeid( *entry.item ) != typeid( *item ) )
+        {
+            /*
+                The item is derived from a class with a snapshot()
+                implementation, but does not reimplement it. The copy
+                would lose the reimplemented draw methods.
+             */
+            delete entry.item;
+            entry.item = NULL;
+        }
+
+        if ( entry.item == NULL )
+        {
+            // the commands are replayed only once
+            entry.graphic.setCachePolicy( QwtGraphic::NoCache );
+
+            QPainter painter( &entry.graphic );
+            painter.setRenderHint( QPainter::Antialiasing, entry.isAntialiased );
+
+            item->draw( &painter, m_data->maps[ item->xAxis() ],
+                m_data->maps[ item->yAxis() ], m_data->canvasRect );
+
+            painter.end();
+
+            m_data->numRecorded++;
+        }
+
+        m_data->entries += entry;
+    }
+}
+
+//! Remove all items and set the snapshot to null
+void QwtPlotSnapshot::reset()
+{
+    m_data->reset();
+}
+
+/*!
+   \return True, when the snapshot has not been taken from a plot
+   \sa update()
+ */
+bool QwtPlotSnapshot::isNull() const
+{
+    return m_data->canvasRect.isEmpty();
+}
+
+/*!
+   \return Contents rectangle of the canvas, when the snapshot was taken
+ */
+QRectF QwtPlotSnapshot::canvasRect() const
+{
+    return m_data->canvasRect;
+}
+
+//! \return Background brush of the canvas
+QBrush QwtPlotSnapshot::canvasBackground() const
+{
+    return m_data->background;
+}
+
+/*!
+   \param axisId Axis
+   \return Canvas map, when the snapshot was taken
+   \sa QwtPlot::canvasMap()
+ */
+QwtScaleMap QwtPlotSnapshot::canvasMap( QwtAxisId axisId ) const
+{
+    if ( !QwtAxis::isValid( axisId ) )
+        return QwtScaleMap();
+
+    return m_data->maps[ axisId ];
+}
+
+//! \return Number of items, including the recorded ones
+int QwtPlotSnapshot::itemCount() const
+{
+    return m_data->entries.size();
+}
+
+/*!
+   \return Number of items, that have been recorded to a QwtGraphic,
+           because they don't support QwtPlotItem::snapshot() or
+           don't reimplement it in a derived class
+ */
+int QwtPlotSnapshot::recordedItemCount() const
+{
+    return m_data->numRecorded;
+}
+
+/*!
+   \brief Draw the items
+
+   The canvas maps are stretched from canvasRect() to the target
+   rectangle, what also includes the canvas margins. The background
+   is not painted.
+
+   \param painter Painter
+   \param canvasRect Target rectangle for the canvas contents
+
+   \sa QwtPlotRenderer::render(), QwtPlot::drawItems()
+ */
+void QwtPlotSnapshot::draw( QPainter* painter, const QRectF& canvasRect ) const
+{
+    const QRectF& rect = m_data->canvasRect;
+    if ( painter == NULL || rect.isEmpty() || canvasRect.isEmpty() )
+        return;
+
+    const double sx = canvasRect.width() / rect.width();
+    const double sy = canvasRect.height() / rect.height();
+
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        QwtScaleMap& map = maps[axisPos];
+        map = m_data->maps[axisPos];
+
+        if ( QwtAxis::isXAxis( axisPos ) )
+        {
+            map.setPaintInterval(
+                canvasRect.left() + ( map.p1() - rect.left() ) * sx,
+                canvasRect.left() + ( map.p2() - rect.left() ) * sx );
+        }
+        else
+        {
+            map.setPaintInterval(
+                canvasRect.top() + ( map.p1() - rect.top() ) * sy,
+                canvasRect.top() + ( map.p2() - rect.top() ) * sy );
+        }
+    }
+
+    for ( int i = 0; i < m_data->entries.size(); i++ )
+    {
+        const Entry& entry = m_data->entries[i];
+
+        painter->save();
+
+        painter->setRenderHint( QPainter::Antialiasing, entry.isAntialiased );
+
+#if QT_VERSION < 0x050100
+        painter->setRenderHint( QPainter::HighQualityAntialiasing,
+            entry.isAntialiased );
+#endif
+
+        if ( entry.item )
+        {
+            entry.item->draw( painter, maps[ entry.item->xAxis() ],
+                maps[ entry.item->yAxis() ], canvasRect );
+        }
+        else
+        {
+            painter->translate( canvasRect.topLeft() );
+            painter->scale( sx, sy );
+            painter->translate( -rect.topLeft() );
+
+            entry.graphic.render( painter );
+        }
+
+        painter->restore();
+    }
+}
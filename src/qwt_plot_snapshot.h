@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_SNAPSHOT_H
+#define QWT_PLOT_SNAPSHOT_H
+
+#include "qwt_global.h"
+#include "qwt_axis_id.h"
+
+class QwtPlot;
+class QwtScaleMap;
+class QPainter;
+class QBrush;
+class QRectF;
+
+/*!
+   \brief Immutable copy of the canvas contents of a plot
+
+   QwtPlotItem::draw() reads the state of the item and its series
+   without any synchronization. Rendering a plot from a worker thread,
+   while the application keeps on modifying it in the GUI thread,
+   is not possible without copying it first.
+
+   QwtPlotSnapshot takes a copy of the visible items and the
+   canvas maps of a plot:
+
+   - items supporting QwtPlotItem::snapshot() are copied. Series data
+     is copied by QwtSeriesData::snapshot(), what is a shallow copy
+     for the implicitly shared arrays of QwtArraySeriesData
+     and QwtPointArrayData.
+   - all other items are recorded to a QwtGraphic, that is
+     scaled, when the snapshot is rendered to a different size.
+
+   The snapshot has to be taken in the GUI thread. Afterwards it can
+   be handed over to another thread and rendered there
+   by QwtPlotRenderer.
+
+   \code
+ QwtPlotSnapshot* snapshot = new QwtPlotSnapshot( plot );
+
+ QtConcurrent::run( [snapshot]()
+ {
+     QImage image( 800, 600, QImage::Format_ARGB32 );
+
+     QwtPlotRenderer renderer;
+     renderer.renderTo( *snapshot, image );
+
+     image.save( "plot.png" );
+     delete snapshot;
+ } );
+   \endcode
+
+   \note As QWidgets can't be used outside of the GUI thread, a snapshot
+         contains the canvas only. Title, scales and legend are not included.
+   \note A snapshot can't be rendered from several threads at the same time.
+
+   \sa QwtPlotRenderer::render(), QwtPlotItem::snapshot()
+ */
+class QWT_EXPORT QwtPlotSnapshot
+{
+  public:
+    QwtPlotSnapshot();
+    explicit QwtPlotSnapshot( const QwtPlot* );
+
+    ~QwtPlotSnapshot();
+
+    void update( const QwtPlot* );
+    void reset();
+
+    bool isNull() const;
+
+    QRectF canvasRect() const;
+    QBrush canvasBackground() const;
+    QwtScaleMap canvasMap( QwtAxisId ) const;
+
+    int itemCount() const;
+    int recordedItemCount() const;
+
+    void draw( QPainter*, const QRectF& canvasRect ) const;
+
+  private:
+    Q_DISABLE_COPY(QwtPlotSnapshot)
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -9,12 +9,17 @@
 
 #include "qwt_plot_zoomer.h"
 #include "qwt_plot.h"
+#include "qwt_plot_canvas.h"
 #include "qwt_scale_div.h"
 #include "qwt_scale_map.h"
 #include "qwt_interval.h"
 #include "qwt_picker_machine.h"
 
 #include <qstack.h>
+#include <qlist.h>
+#include <qpixmap.h>
+#include <qapplication.h>
+#include <qevent.h>
 
 static QwtInterval qwtExpandedZoomInterval( double v1, double v2,
     double minRange, const QwtTransform* transform )
@@ -78,13 +83,40 @@ static QRectF qwtExpandedZoomRect( const QRectF& zoomRect, const QSizeF& minSize
     return r;
 }
 
+namespace
+{
+    class ImageEntry
+    {
+      public:
+        QRectF rect;
+        QPixmap pixmap;
+
+        // items have been changed, since the image was rendered
+        bool isOutdated;
+    };
+}
+
 class QwtPlotZoomer::PrivateData
 {
   public:
+    PrivateData()
+        : zoomRectIndex( 0 )
+        , maxStackDepth( -1 )
+        , imageCacheSize( 0 )
+        , isDisplayOutdated( false )
+    {
+    }
+
     uint zoomRectIndex;
     QStack< QRectF > zoomStack;
 
     int maxStackDepth;
+
+    // the most recently used image first
+    QList< ImageEntry > images;
+    int imageCacheSize;
+
+    bool isDisplayOutdated;
 };
 
 /*!
@@ -297,6 +329,200 @@ uint QwtPlotZoomer::zoomRectIndex() const
     return m_data->zoomRectIndex;
 }
 
+/*!
+   \brief Limit the number of images in the image cache
+
+   When leaving a zoom rectangle the rendered canvas is kept in a
+   cache with up to size images. Coming back to a rectangle on the
+   zoom stack displays the cached image instead of rendering the plot
+   items. When the cache is full, the least recently used image
+   is discarded.
+
+   Changes of attached items - QwtPlotItem::itemChanged() - don't
+   remove the cached images, but mark them as outdated. An outdated image
+   is displayed immediately, followed by a replot, that is
+   processed from the event loop.
+
+   Images are cached only for a QwtPlotCanvas with the
+   QwtPlotCanvas::BackingStore paint attribute.
+
+   \param size Maximum number of cached images. 0 disables the cache,
+               what is the default setting.
+
+   \note Each image has the size of the canvas. Modifications of the
+         plot, that are not indicated by the items - f.e. changing the
+         canvas background - require calling clearImageCache().
+
+   \sa imageCacheSize(), clearImageCache(), QwtPlotCanvas::setBackingStore()
+ */
+void QwtPlotZoomer::setImageCacheSize( int size )
+{
+    size = qMax( size, 0 );
+    if ( size == m_data->imageCacheSize )
+        return;
+
+    QwtPlot* plt = plot();
+    if ( plt )
+    {
+        if ( m_data->imageCacheSize == 0 )
+        {
+            connect( plt, SIGNAL(itemChanged(QwtPlotItem*)),
+                SLOT(invalidateImageCache()) );
+            connect( plt, SIGNAL(itemAttached(QwtPlotItem*,bool)),
+                SLOT(invalidateImageCache()) );
+        }
+        else if ( size == 0 )
+        {
+            disconnect( plt, SIGNAL(itemChanged(QwtPlotItem*)),
+                this, SLOT(invalidateImageCache()) );
+            disconnect( plt, SIGNAL(itemAttached(QwtPlotItem*,bool)),
+                this, SLOT(invalidateImageCache()) );
+        }
+    }
+
+    m_data->imageCacheSize = size;
+
+    while ( m_data->images.size() > size )
+        m_data->images.removeLast();
+}
+
+/*!
+   \return Maximum number of images in the image cache
+   \sa setImageCacheSize()
+ */
+int QwtPlotZoomer::imageCacheSize() const
+{
+    return m_data->imageCacheSize;
+}
+
+/*!
+   Remove all images from the image cache
+   \sa setImageCacheSize()
+ */
+void QwtPlotZoomer::clearImageCache()
+{
+    m_data->images.clear();
+}
+
+//! Mark the cached images as outdated
+void QwtPlotZoomer::invalidateImageCache()
+{
+    for ( int i = 0; i < m_data->images.size(); i++ )
+        m_data->images[i].isOutdated = true;
+
+    const QwtPlot* plt = plot();
+    if ( plt && !plt->autoReplot() )
+        m_data->isDisplayOutdated = true;
+}
+
+//! Replot, when an outdated image is displayed
+void QwtPlotZoomer::refreshImage()
+{
+    QwtPlot* plt = plot();
+    if ( plt && m_data->isDisplayOutdated )
+    {
+        m_data->isDisplayOutdated = false;
+        plt->replot();
+    }
+}
+
+/*!
+   Insert the image of the canvas for scaleRect() into the image cache
+   \sa restoreImage()
+ */
+void QwtPlotZoomer::cacheImage()
+{
+    const QwtPlot* plt = plot();
+    if ( plt == NULL || plt->isUpdating() )
+        return;
+
+    const QwtPlotCanvas* canvas =
+        qobject_cast< const QwtPlotCanvas* >( plt->canvas() );
+    if ( canvas == NULL )
+        return;
+
+    // a null backing store is waiting for the next paint event
+    const QPixmap* backingStore = canvas->backingStore();
+    if ( backingStore == NULL || backingStore->isNull() )
+        return;
+
+    const QRectF rect = scaleRect();
+
+    for ( int i = 0; i < m_data->images.size(); i++ )
+    {
+        if ( m_data->images[i].rect == rect )
+        {
+            m_data->images.removeAt( i );
+            break;
+        }
+    }
+
+    ImageEntry entry;
+    entry.rect = rect;
+    entry.pixmap = *backingStore;
+    entry.isOutdated = m_data->isDisplayOutdated;
+
+    m_data->images.prepend( entry );
+
+    while ( m_data->images.size() > m_data->imageCacheSize )
+        m_data->images.removeLast();
+}
+
+/*!
+   Display the cached image of zoomRect() without rendering the plot items
+
+   \return true, when an image has been found in the image cache
+   \sa cacheImage()
+ */
+bool QwtPlotZoomer::restoreImage()
+{
+    QwtPlot* plt = plot();
+    if ( plt == NULL || plt->isUpdating() )
+        return false;
+
+    QwtPlotCanvas* canvas = qobject_cast< QwtPlotCanvas* >( plt->canvas() );
+    if ( canvas == NULL || canvas->backingStore() == NULL )
+        return false;
+
+    const QRectF rect = zoomRect();
+
+    for ( int i = 0; i < m_data->images.size(); i++ )
+    {
+        if ( m_data->images[i].rect != rect )
+            continue;
+
+        const ImageEntry entry = m_data->images.takeAt( i );
+        m_data->images.prepend( entry );
+
+        // what QwtPlot::replot() does beside rendering the canvas
+
+        const bool doAutoReplot = plt->autoReplot();
+        plt->setAutoReplot( false );
+
+        plt->updateAxes();
+        QApplication::sendPostedEvents( plt, QEvent::LayoutRequest );
+
+        plt->setAutoReplot( doAutoReplot );
+
+        /*
+            When the layout has changed the size of the canvas,
+            the image is ignored and the canvas is rendered.
+         */
+        canvas->setBackingStore( entry.pixmap );
+
+        m_data->isDisplayOutdated = entry.isOutdated;
+        if ( entry.isOutdated )
+        {
+            QMetaObject::invokeMethod( this,
+                "refreshImage", Qt::QueuedConnection );
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
 /*!
    \brief Zoom in
 
@@ -410,7 +636,9 @@ void QwtPlotZoomer::setZoomStack(
 /*!
    Adjust the observed plot to zoomRect()
 
-   \note Initiates QwtPlot::replot()
+   \note Initiates QwtPlot::replot(), unless the image
+         of zoomRect() can be taken from the image cache
+   \sa setImageCacheSize()
  */
 
 void QwtPlotZoomer::rescale()
@@ -422,6 +650,9 @@ void QwtPlotZoomer::rescale()
     const QRectF& rect = m_data->zoomStack[m_data->zoomRectIndex];
     if ( rect != scaleRect() )
     {
+        if ( m_data->imageCacheSize > 0 )
+            cacheImage();
+
         const bool doReplot = plt->autoReplot();
         plt->setAutoReplot( false );
 
@@ -441,7 +672,11 @@ void QwtPlotZoomer::rescale()
 
         plt->setAutoReplot( doReplot );
 
-        plt->replot();
+        if ( m_data->imageCacheSize <= 0 || !restoreImage() )
+        {
+            m_data->isDisplayOutdated = false;
+            plt->replot();
+        }
     }
 }
 
@@ -457,6 +692,8 @@ void QwtPlotZoomer::setAxes( QwtAxisId xAxisId, QwtAxisId yAxisId )
     if ( xAxisId != QwtPlotPicker::xAxis() || yAxisId != QwtPlotPicker::yAxis() )
     {
         QwtPlotPicker::setAxes( xAxisId, yAxisId );
+
+        clearImageCache();
         setZoomBase( scaleRect() );
     }
 }
@@ -70,6 +70,14 @@ template< typename T > class QStack;
    allowed to attach a second QwtPlotZoomer ( without rubber band and tracker )
    for the other axes.
 
+   Zooming out re-renders the plot, even when the previous zoom rectangle
+   has been displayed a moment ago. With setImageCacheSize() the zoomer
+   keeps the rendered canvas images of the most recently visited zoom
+   rectangles. When going back to one of them, the image is displayed
+   without rendering the plot items. When attached items have been
+   changed in the meantime, the image is displayed first and the
+   plot is replotted from the event loop afterwards.
+
    \note The realtime example includes an derived zoomer class that adds
         scrollbars to the plot canvas.
 
@@ -103,6 +111,11 @@ class QWT_EXPORT QwtPlotZoomer : public QwtPlotPicker
 
     uint zoomRectIndex() const;
 
+    void setImageCacheSize( int );
+    int imageCacheSize() const;
+
+    void clearImageCache();
+
   public Q_SLOTS:
     void moveBy( double dx, double dy );
     virtual void moveTo( const QPointF& );
@@ -132,9 +145,16 @@ class QWT_EXPORT QwtPlotZoomer : public QwtPlotPicker
     virtual bool end( bool ok = true ) QWT_OVERRIDE;
     virtual bool accept( QPolygon& ) const QWT_OVERRIDE;
 
+  private Q_SLOTS:
+    void invalidateImageCache();
+    void refreshImage();
+
   private:
     void init( bool doReplot );
 
+    void cacheImage();
+    bool restoreImage();
+
     class PrivateData;
     PrivateData* m_data;
 };
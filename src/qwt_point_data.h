@@ -28,6 +28,8 @@ class QwtPointArrayData : public QwtSeriesData< QPointF >
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual QwtSeriesData< QPointF >* snapshot() const QWT_OVERRIDE;
+
     const QVector< T >& xData() const;
     const QVector< T >& yData() const;
 
@@ -241,6 +243,19 @@ QPointF QwtPointArrayData< T >::sample( size_t index ) const
     return QPointF( m_x[int( index )], m_y[int( index )] );
 }
 
+/*!
+   \return Shallow copy of the x and y arrays
+   \sa QwtSeriesData::snapshot()
+ */
+template< typename T >
+QwtSeriesData< QPointF >* QwtPointArrayData< T >::snapshot() const
+{
+    QwtPointArrayData< T >* data = new QwtPointArrayData< T >( m_x, m_y );
+    data->cachedBoundingRect = cachedBoundingRect;
+
+    return data;
+}
+
 //! \return Array of the x-values
 template< typename T >
 const QVector< T >& QwtPointArrayData< T >::xData() const
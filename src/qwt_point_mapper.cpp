@@ -11,9 +11,11 @@
 #include "qwt_scale_map.h"
 #include "qwt_pixel_matrix.h"
 #include "qwt_series_data.h"
+#include "qwt_point_data.h"
 #include "qwt_math.h"
 
 #include <qpolygon.h>
+#include <qvector.h>
 #include <qimage.h>
 #include <qpen.h>
 #include <qpainter.h>
@@ -22,6 +24,8 @@
 #include <qfuture.h>
 #include <qtconcurrentrun.h>
 
+#include <typeinfo>
+
 #if !defined( QT_NO_QFUTURE )
 #define QWT_USE_THREADS 1
 #endif
@@ -43,8 +47,129 @@ static inline double qwtRoundValueF( double value )
 #endif
 }
 
+static inline bool qwtIsValidPoint( double x, double y )
+{
+    return qIsFinite( x ) && qIsFinite( y );
+}
+
+/*
+    Gaps - caused by samples with NaN coordinates - are indicated
+    by a point with NaN coordinates between the polylines.
+    As a QPolygon can't store them, integer polylines are
+    connected over the gaps.
+ */
+static inline bool qwtIsGap( const QPointF& pos )
+{
+    return qIsNaN( pos.x() );
+}
+
+static inline bool qwtIsGap( const QPoint& )
+{
+    return false;
+}
+
+static inline void qwtAppendGap( QPolygonF& polyline )
+{
+    if ( !polyline.isEmpty() && !qwtIsGap( polyline.last() ) )
+        polyline += QPointF( qQNaN(), qQNaN() );
+}
+
+static inline void qwtAppendGap( QPolygon& )
+{
+}
+
+static inline void qwtInsertGap( QPointF* points, int& numPoints )
+{
+    if ( numPoints > 0 && !qwtIsGap( points[ numPoints - 1 ] ) )
+        points[ numPoints++ ] = QPointF( qQNaN(), qQNaN() );
+}
+
+static inline void qwtInsertGap( QPoint*, int& )
+{
+}
+
+namespace
+{
+    /*
+        Access to the samples of a series. For the most common
+        data classes the compiler can inline the access to the arrays,
+        instead of calling the virtual QwtSeriesData::sample()
+     */
+    class QwtSeriesAccess
+    {
+      public:
+        inline explicit QwtSeriesAccess( const QwtSeriesData< QPointF >* series )
+            : m_series( series )
+        {
+        }
+
+        inline QPointF sample( int index ) const
+        {
+            return m_series->sample( index );
+        }
+
+      private:
+        const QwtSeriesData< QPointF >* m_series;
+    };
+
+    template< typename T >
+    class QwtArrayAccess
+    {
+      public:
+        inline QwtArrayAccess( const T* x, const T* y )
+            : m_x( x )
+            , m_y( y )
+        {
+        }
+
+        inline QPointF sample( int index ) const
+        {
+            return QPointF( m_x[index], m_y[index] );
+        }
+
+      private:
+        const T* m_x;
+        const T* m_y;
+    };
+}
+
+/*
+    Find the x/y arrays of a QwtPointArrayData< T > or QwtCPointerData< T >.
+    Derived classes might have overloaded sample(), so that only
+    the exact types can be accessed directly.
+ */
+template< typename T >
+static bool qwtSeriesArrays( const QwtSeriesData< QPointF >* series,
+    const T*& x, const T*& y )
+{
+    if ( typeid( *series ) == typeid( QwtPointArrayData< T > ) )
+    {
+        const QwtPointArrayData< T >* data =
+            static_cast< const QwtPointArrayData< T >* >( series );
+
+        x = data->xData().constData();
+        y = data->yData().constData();
+
+        return true;
+    }
+
+    if ( typeid( *series ) == typeid( QwtCPointerData< T > ) )
+    {
+        const QwtCPointerData< T >* data =
+            static_cast< const QwtCPointerData< T >* >( series );
+
+        x = data->xData();
+        y = data->yData();
+
+        return true;
+    }
+
+    return false;
+}
+
+template< class Series >
 static Qt::Orientation qwtProbeOrientation(
-    const QwtSeriesData< QPointF >* series, int from, int to )
+    const Series& series, int from, int to )
 {
     if ( to - from < 20 )
     {
@@ -52,8 +177,8 @@ static Qt::Orientation qwtProbeOrientation(
         return Qt::Horizontal;
     }
 
-    const double x0 = series->sample( from ).x();
-    const double xn = series->sample( to ).x();
+    const double x0 = series.sample( from ).x();
+    const double xn = series.sample( to ).x();
 
     if ( x0 == xn )
         return Qt::Vertical;
@@ -64,7 +189,7 @@ static Qt::Orientation qwtProbeOrientation(
     double x1 = x0;
     for ( int i = from + step; i < to; i += step )
     {
-        const double x2 = series->sample( i ).x();
+        const double x2 = series.sample( i ).x();
         if ( x2 != x1 )
         {
             if ( ( x2 > x1 ) != isIncreasing )
@@ -183,31 +308,53 @@ namespace
     };
 }
 
-template< class Polygon, class Point, class PolygonQuadrupel >
+template< class Polygon, class Point, class PolygonQuadrupel, class Series >
 static Polygon qwtMapPointsQuad( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
-    const QwtSeriesData< QPointF >* series, int from, int to )
+    const Series& series, int from, int to, bool withGaps )
 {
-    const QPointF sample0 = series->sample( from );
-
     PolygonQuadrupel q;
-    q.start( qwtRoundValue( xMap.transform( sample0.x() ) ),
-        qwtRoundValue( yMap.transform( sample0.y() ) ) );
+    bool isStarted = false;
 
     Polygon polyline;
     for ( int i = from; i <= to; i++ )
     {
-        const QPointF sample = series->sample( i );
+        const QPointF sample = series.sample( i );
+
+        const double xf = xMap.transform( sample.x() );
+        const double yf = yMap.transform( sample.y() );
+
+        if ( !qwtIsValidPoint( xf, yf ) )
+        {
+            if ( isStarted )
+            {
+                q.flush( polyline );
+                isStarted = false;
+            }
+
+            continue;
+        }
+
+        const int x = qwtRoundValue( xf );
+        const int y = qwtRoundValue( yf );
 
-        const int x = qwtRoundValue( xMap.transform( sample.x() ) );
-        const int y = qwtRoundValue( yMap.transform( sample.y() ) );
+        if ( !isStarted )
+        {
+            // after a gap
+            if ( withGaps )
+                qwtAppendGap( polyline );
 
-        if ( !q.append( x, y ) )
+            q.start( x, y );
+            isStarted = true;
+        }
+        else if ( !q.append( x, y ) )
         {
             q.flush( polyline );
             q.start( x, y );
         }
     }
-    q.flush( polyline );
+
+    if ( isStarted )
+        q.flush( polyline );
 
     return polyline;
 }
@@ -225,28 +372,48 @@ static Polygon qwtMapPointsQuad( const Polygon& polyline )
     Polygon polylineXY;
 
     PolygonQuadrupel q;
-    q.start( points[0].x(), points[0].y() );
+    bool isStarted = false;
 
     for ( int i = 0; i < numPoints; i++ )
     {
+        if ( qwtIsGap( points[i] ) )
+        {
+            if ( isStarted )
+            {
+                q.flush( polylineXY );
+                isStarted = false;
+            }
+
+            continue;
+        }
+
         const int x = points[i].x();
         const int y = points[i].y();
 
-        if ( !q.append( x, y ) )
+        if ( !isStarted )
+        {
+            qwtAppendGap( polylineXY );
+
+            q.start( x, y );
+            isStarted = true;
+        }
+        else if ( !q.append( x, y ) )
         {
             q.flush( polylineXY );
             q.start( x, y );
         }
     }
-    q.flush( polylineXY );
+
+    if ( isStarted )
+        q.flush( polylineXY );
 
     return polylineXY;
 }
 
 
-template< class Polygon, class Point >
+template< class Polygon, class Point, class Series >
 static Polygon qwtMapPointsQuad( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
-    const QwtSeriesData< QPointF >* series, int from, int to )
+    const Series& series, int from, int to, bool withGaps )
 {
     Polygon polyline;
     if ( from > to )
@@ -261,7 +428,8 @@ static Polygon qwtMapPointsQuad( const QwtScaleMap& xMap, const QwtScaleMap& yMa
     if ( orientation == Qt::Horizontal )
     {
         polyline = qwtMapPointsQuad< Polygon, Point,
-            QwtPolygonQuadrupelY< Polygon, Point > >( xMap, yMap, series, from, to );
+            QwtPolygonQuadrupelY< Polygon, Point > >(
+            xMap, yMap, series, from, to, withGaps );
 
         polyline = qwtMapPointsQuad< Polygon, Point,
             QwtPolygonQuadrupelX< Polygon, Point > >( polyline );
@@ -269,7 +437,8 @@ static Polygon qwtMapPointsQuad( const QwtScaleMap& xMap, const QwtScaleMap& yMa
     else
     {
         polyline = qwtMapPointsQuad< Polygon, Point,
-            QwtPolygonQuadrupelX< Polygon, Point > >( xMap, yMap, series, from, to );
+            QwtPolygonQuadrupelX< Polygon, Point > >(
+            xMap, yMap, series, from, to, withGaps );
 
         polyline = qwtMapPointsQuad< Polygon, Point,
             QwtPolygonQuadrupelY< Polygon, Point > >( polyline );
@@ -306,8 +475,14 @@ static void qwtRenderDots(
     {
         const QPointF sample = command.series->sample( i );
 
-        const int x = static_cast< int >( xMap.transform( sample.x() ) + 0.5 ) - x0;
-        const int y = static_cast< int >( yMap.transform( sample.y() ) + 0.5 ) - y0;
+        const double xf = xMap.transform( sample.x() );
+        const double yf = yMap.transform( sample.y() );
+
+        if ( !qwtIsValidPoint( xf, yf ) )
+            continue;
+
+        const int x = static_cast< int >( xf + 0.5 ) - x0;
+        const int y = static_cast< int >( yf + 0.5 ) - y0;
 
         if ( x >= 0 && x < w && y >= 0 && y < h )
             bits[ y * w + x ] = rgb;
@@ -340,14 +515,14 @@ struct QwtNoRoundF
 };
 
 // mapping points without any filtering - beside checking
-// the bounding rectangle
+// the bounding rectangle. Invalid points are skipped or
+// replaced by a gap, when withGaps is set
 
-template< class Polygon, class Point, class Round >
+template< class Polygon, class Point, class Round, class Series >
 static inline Polygon qwtToPoints(
     const QRectF& boundingRect,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
-    const QwtSeriesData< QPointF >* series,
-    int from, int to, Round round )
+    const Series& series, int from, int to, Round round, bool withGaps )
 {
     Polygon polyline( to - from + 1 );
     Point* points = polyline.data();
@@ -362,7 +537,7 @@ static inline Polygon qwtToPoints(
 
         for ( int i = from; i <= to; i++ )
         {
-            const QPointF sample = series->sample( i );
+            const QPointF sample = series.sample( i );
 
             const double x = xMap.transform( sample.x() );
             const double y = yMap.transform( sample.y() );
@@ -383,52 +558,66 @@ static inline Polygon qwtToPoints(
         // simply iterating over all values
         // without any filtering
 
+        bool isGap = false;
+
         for ( int i = from; i <= to; i++ )
         {
-            const QPointF sample = series->sample( i );
+            const QPointF sample = series.sample( i );
 
             const double x = xMap.transform( sample.x() );
             const double y = yMap.transform( sample.y() );
 
+            if ( !qwtIsValidPoint( x, y ) )
+            {
+                isGap = withGaps;
+                continue;
+            }
+
+            if ( isGap )
+            {
+                qwtInsertGap( points, numPoints );
+                isGap = false;
+            }
+
             points[ numPoints ].rx() = round( x );
             points[ numPoints ].ry() = round( y );
 
             numPoints++;
         }
+
+        polyline.resize( numPoints );
     }
 
     return polyline;
 }
 
+template< class Series >
 static inline QPolygon qwtToPointsI(
     const QRectF& boundingRect,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
-    const QwtSeriesData< QPointF >* series,
-    int from, int to )
+    const Series& series, int from, int to )
 {
     return qwtToPoints< QPolygon, QPoint >(
-        boundingRect, xMap, yMap, series, from, to, QwtRoundI() );
+        boundingRect, xMap, yMap, series, from, to, QwtRoundI(), false );
 }
 
-template< class Round >
+template< class Round, class Series >
 static inline QPolygonF qwtToPointsF(
     const QRectF& boundingRect,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
-    const QwtSeriesData< QPointF >* series,
-    int from, int to, Round round )
+    const Series& series, int from, int to, Round round, bool withGaps )
 {
     return qwtToPoints< QPolygonF, QPointF >(
-        boundingRect, xMap, yMap, series, from, to, round );
+        boundingRect, xMap, yMap, series, from, to, round, withGaps );
 }
 
 // Mapping points with filtering out consecutive
 // points mapped to the same position
 
-template< class Polygon, class Point, class Round >
+template< class Polygon, class Point, class Round, class Series >
 static inline Polygon qwtToPolylineFiltered(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
-    const QwtSeriesData< QPointF >* series,
-    int from, int to, Round round )
+    const Series& series, int from, int to, Round round, bool withGaps )
 {
     // in curves with many points consecutive points
     // are often mapped to the same position. As this might
@@ -438,44 +627,56 @@ static inline Polygon qwtToPolylineFiltered(
     Polygon polyline( to - from + 1 );
     Point* points = polyline.data();
 
-    const QPointF sample0 = series->sample( from );
-
-    points[0].rx() = round( xMap.transform( sample0.x() ) );
-    points[0].ry() = round( yMap.transform( sample0.y() ) );
+    int numPoints = 0;
+    bool isGap = false;
 
-    int pos = 0;
-    for ( int i = from + 1; i <= to; i++ )
+    for ( int i = from; i <= to; i++ )
     {
-        const QPointF sample = series->sample( i );
+        const QPointF sample = series.sample( i );
+
+        const double x = xMap.transform( sample.x() );
+        const double y = yMap.transform( sample.y() );
+
+        if ( !qwtIsValidPoint( x, y ) )
+        {
+            isGap = withGaps;
+            continue;
+        }
 
-        const Point p( round( xMap.transform( sample.x() ) ),
-            round( yMap.transform( sample.y() ) ) );
+        if ( isGap )
+        {
+            // a gap never follows a gap, so that it
+            // always fits into the place of the invalid sample
+            qwtInsertGap( points, numPoints );
+            isGap = false;
+        }
 
-        if ( points[pos] != p )
-            points[++pos] = p;
+        const Point p( round( x ), round( y ) );
+
+        if ( numPoints == 0 || points[ numPoints - 1 ] != p )
+            points[ numPoints++ ] = p;
     }
 
-    polyline.resize( pos + 1 );
+    polyline.resize( numPoints );
     return polyline;
 }
 
+template< class Series >
 static inline QPolygon qwtToPolylineFilteredI(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
-    const QwtSeriesData< QPointF >* series,
-    int from, int to )
+    const Series& series, int from, int to )
 {
     return qwtToPolylineFiltered< QPolygon, QPoint >(
-        xMap, yMap, series, from, to, QwtRoundI() );
+        xMap, yMap, series, from, to, QwtRoundI(), false );
 }
 
-template< class Round >
+template< class Round, class Series >
 static inline QPolygonF qwtToPolylineFilteredF(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
-    const QwtSeriesData< QPointF >* series,
-    int from, int to, Round round )
+    const Series& series, int from, int to, Round round, bool withGaps )
 {
     return qwtToPolylineFiltered< QPolygonF, QPointF >(
-        xMap, yMap, series, from, to, round );
+        xMap, yMap, series, from, to, round, withGaps );
 }
 
 template< class Polygon, class Point >
@@ -497,8 +698,14 @@ static inline Polygon qwtToPointsFiltered(
     {
         const QPointF sample = series->sample( i );
 
-        const int x = qwtRoundValue( xMap.transform( sample.x() ) );
-        const int y = qwtRoundValue( yMap.transform( sample.y() ) );
+        const double xf = xMap.transform( sample.x() );
+        const double yf = yMap.transform( sample.y() );
+
+        if ( !qwtIsValidPoint( xf, yf ) )
+            continue;
+
+        const int x = qwtRoundValue( xf );
+        const int y = qwtRoundValue( yf );
 
         if ( pixelMatrix.testAndSetPixel( x, y, true ) == false )
         {
@@ -531,6 +738,127 @@ static inline QPolygonF qwtToPointsFilteredF(
         boundingRect, xMap, yMap, series, from, to );
 }
 
+template< class Series >
+static QPolygonF qwtToPolygonF( QwtPointMapper::TransformationFlags flags,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const Series& series, int from, int to, bool withGaps )
+{
+    QPolygonF polyline;
+
+    if ( flags & QwtPointMapper::RoundPoints )
+    {
+        if ( flags & QwtPointMapper::WeedOutIntermediatePoints )
+        {
+            polyline = qwtMapPointsQuad< QPolygonF, QPointF >(
+                xMap, yMap, series, from, to, withGaps );
+        }
+        else if ( flags & QwtPointMapper::WeedOutPoints )
+        {
+            polyline = qwtToPolylineFilteredF(
+                xMap, yMap, series, from, to, QwtRoundF(), withGaps );
+        }
+        else
+        {
+            polyline = qwtToPointsF( qwtInvalidRect,
+                xMap, yMap, series, from, to, QwtRoundF(), withGaps );
+        }
+    }
+    else
+    {
+        if ( flags & QwtPointMapper::WeedOutPoints )
+        {
+            polyline = qwtToPolylineFilteredF(
+                xMap, yMap, series, from, to, QwtNoRoundF(), withGaps );
+        }
+        else
+        {
+            polyline = qwtToPointsF( qwtInvalidRect,
+                xMap, yMap, series, from, to, QwtNoRoundF(), withGaps );
+        }
+    }
+
+    return polyline;
+}
+
+static QPolygonF qwtToPolygonF( QwtPointMapper::TransformationFlags flags,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to, bool withGaps )
+{
+    const double* xd;
+    const double* yd;
+
+    if ( qwtSeriesArrays( series, xd, yd ) )
+    {
+        return qwtToPolygonF( flags, xMap, yMap,
+            QwtArrayAccess< double >( xd, yd ), from, to, withGaps );
+    }
+
+    const float* xf;
+    const float* yf;
+
+    if ( qwtSeriesArrays( series, xf, yf ) )
+    {
+        return qwtToPolygonF( flags, xMap, yMap,
+            QwtArrayAccess< float >( xf, yf ), from, to, withGaps );
+    }
+
+    return qwtToPolygonF( flags, xMap, yMap,
+        QwtSeriesAccess( series ), from, to, withGaps );
+}
+
+template< class Series >
+static QPolygon qwtToPolygon( QwtPointMapper::TransformationFlags flags,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const Series& series, int from, int to )
+{
+    QPolygon polyline;
+
+    if ( flags & QwtPointMapper::WeedOutIntermediatePoints )
+    {
+        // TODO WeedOutIntermediatePointsY ...
+        polyline = qwtMapPointsQuad< QPolygon, QPoint >(
+            xMap, yMap, series, from, to, false );
+    }
+    else if ( flags & QwtPointMapper::WeedOutPoints )
+    {
+        polyline = qwtToPolylineFilteredI(
+            xMap, yMap, series, from, to );
+    }
+    else
+    {
+        polyline = qwtToPointsI(
+            qwtInvalidRect, xMap, yMap, series, from, to );
+    }
+
+    return polyline;
+}
+
+static QPolygon qwtToPolygon( QwtPointMapper::TransformationFlags flags,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to )
+{
+    const double* xd;
+    const double* yd;
+
+    if ( qwtSeriesArrays( series, xd, yd ) )
+    {
+        return qwtToPolygon( flags, xMap, yMap,
+            QwtArrayAccess< double >( xd, yd ), from, to );
+    }
+
+    const float* xf;
+    const float* yf;
+
+    if ( qwtSeriesArrays( series, xf, yf ) )
+    {
+        return qwtToPolygon( flags, xMap, yMap,
+            QwtArrayAccess< float >( xf, yf ), from, to );
+    }
+
+    return qwtToPolygon( flags, xMap, yMap,
+        QwtSeriesAccess( series ), from, to );
+}
+
 class QwtPointMapper::PrivateData
 {
   public:
@@ -636,6 +964,11 @@ QRectF QwtPointMapper::boundingRect() const
    When RoundPoints & WeedOutIntermediatePoints is enabled an even more
    aggressive weeding algorithm is enabled.
 
+   Samples with NaN coordinates are skipped, so that the polygon
+   is connected over the gaps. When KeepGaps is set the polyline
+   is interrupted instead: a gap is indicated by a point with NaN
+   coordinates between the valid points.
+
    \param xMap x map
    \param yMap y map
    \param series Series of points to be mapped
@@ -643,45 +976,72 @@ QRectF QwtPointMapper::boundingRect() const
    \param to Index of the last point to be painted
 
    \return Translated polygon
+   \sa KeepGaps, toPolylinesF()
  */
 QPolygonF QwtPointMapper::toPolygonF(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QwtSeriesData< QPointF >* series, int from, int to ) const
 {
-    QPolygonF polyline;
+    return qwtToPolygonF( m_data->flags, xMap, yMap,
+        series, from, to, m_data->flags & KeepGaps );
+}
 
-    if ( m_data->flags & RoundPoints )
-    {
-        if ( m_data->flags & WeedOutIntermediatePoints )
-        {
-            polyline = qwtMapPointsQuad< QPolygonF, QPointF >(
-                xMap, yMap, series, from, to );
-        }
-        else if ( m_data->flags & WeedOutPoints )
-        {
-            polyline = qwtToPolylineFilteredF(
-                xMap, yMap, series, from, to, QwtRoundF() );
-        }
-        else
-        {
-            polyline = qwtToPointsF( qwtInvalidRect,
-                xMap, yMap, series, from, to, QwtRoundF() );
-        }
-    }
-    else
+/*!
+   \brief Translate a series of points into polylines, that are
+          interrupted by samples with NaN coordinates
+
+   The points are mapped like in toPolygonF() with KeepGaps being set,
+   but the gaps are removed and the polylines are returned one after
+   the other. All flags, including WeedOutIntermediatePoints, are supported.
+
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+   \param polylineSizes Number of points of each polyline
+
+   \return Points of all polylines
+   \sa toPolygonF()
+ */
+QPolygonF QwtPointMapper::toPolylinesF(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to,
+    QVector< int >& polylineSizes ) const
+{
+    polylineSizes.clear();
+
+    QPolygonF polyline = qwtToPolygonF( m_data->flags,
+        xMap, yMap, series, from, to, true );
+
+    const int numPoints = polyline.size();
+    if ( numPoints == 0 )
+        return polyline;
+
+    QPointF* points = polyline.data();
+
+    int count = 0;
+    int start = 0;
+
+    for ( int i = 0; i < numPoints; i++ )
     {
-        if ( m_data->flags & WeedOutPoints )
+        if ( qwtIsGap( points[i] ) )
         {
-            polyline = qwtToPolylineFilteredF(
-                xMap, yMap, series, from, to, QwtNoRoundF() );
+            polylineSizes += count - start;
+            start = count;
         }
         else
         {
-            polyline = qwtToPointsF( qwtInvalidRect,
-                xMap, yMap, series, from, to, QwtNoRoundF() );
+            if ( count != i )
+                points[count] = points[i];
+
+            count++;
         }
     }
 
+    polylineSizes += count - start;
+
+    polyline.resize( count );
     return polyline;
 }
 
@@ -691,6 +1051,9 @@ QPolygonF QwtPointMapper::toPolygonF(
    When the WeedOutPoints flag is enabled consecutive points,
    that are mapped to the same position will be one point.
 
+   Samples with NaN coordinates are skipped, so that the
+   polygon is connected over the gaps.
+
    \param xMap x map
    \param yMap y map
    \param series Series of points to be mapped
@@ -703,26 +1066,7 @@ QPolygon QwtPointMapper::toPolygon(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QwtSeriesData< QPointF >* series, int from, int to ) const
 {
-    QPolygon polyline;
-
-    if ( m_data->flags & WeedOutIntermediatePoints )
-    {
-        // TODO WeedOutIntermediatePointsY ...
-        polyline = qwtMapPointsQuad< QPolygon, QPoint >(
-            xMap, yMap, series, from, to );
-    }
-    else if ( m_data->flags & WeedOutPoints )
-    {
-        polyline = qwtToPolylineFilteredI(
-            xMap, yMap, series, from, to );
-    }
-    else
-    {
-        polyline = qwtToPointsI(
-            qwtInvalidRect, xMap, yMap, series, from, to );
-    }
-
-    return polyline;
+    return qwtToPolygon( m_data->flags, xMap, yMap, series, from, to );
 }
 
 /*!
@@ -744,6 +1088,8 @@ QPolygon QwtPointMapper::toPolygon(
    - !WeedOutPoints & boundingRect().isValid()
     Points outside of the bounding rectangle are ignored.
 
+   Samples with NaN coordinates are always ignored.
+
    When RoundPoints is set all points are rounded to integers
    but returned as PolygonF - what only makes sense
    when the further processing of the values need a QPolygonF.
@@ -778,7 +1124,8 @@ QPolygonF QwtPointMapper::toPointsF(
                 // consecutive points
 
                 points = qwtToPolylineFilteredF(
-                    xMap, yMap, series, from, to, QwtRoundF() );
+                    xMap, yMap, QwtSeriesAccess( series ),
+                    from, to, QwtRoundF(), false );
             }
         }
         else
@@ -787,7 +1134,8 @@ QPolygonF QwtPointMapper::toPointsF(
             // qwtToPointsFilteredF
 
             points = qwtToPolylineFilteredF(
-                xMap, yMap, series, from, to, QwtNoRoundF() );
+                xMap, yMap, QwtSeriesAccess( series ),
+                from, to, QwtNoRoundF(), false );
         }
     }
     else
@@ -795,12 +1143,14 @@ QPolygonF QwtPointMapper::toPointsF(
         if ( m_data->flags & RoundPoints )
         {
             points = qwtToPointsF( m_data->boundingRect,
-                xMap, yMap, series, from, to, QwtRoundF() );
+                xMap, yMap, QwtSeriesAccess( series ),
+                from, to, QwtRoundF(), false );
         }
         else
         {
             points = qwtToPointsF( m_data->boundingRect,
-                xMap, yMap, series, from, to, QwtNoRoundF() );
+                xMap, yMap, QwtSeriesAccess( series ),
+                from, to, QwtNoRoundF(), false );
         }
     }
 
@@ -849,13 +1199,14 @@ QPolygon QwtPointMapper::toPoints(
             // we can do is to filter out consecutive duplicates
 
             points = qwtToPolylineFilteredI(
-                xMap, yMap, series, from, to );
+                xMap, yMap, QwtSeriesAccess( series ), from, to );
         }
     }
     else
     {
         points = qwtToPointsI(
-            m_data->boundingRect, xMap, yMap, series, from, to );
+            m_data->boundingRect, xMap, yMap,
+            QwtSeriesAccess( series ), from, to );
     }
 
     return points;
@@ -14,6 +14,7 @@
 
 class QwtScaleMap;
 template< typename T > class QwtSeriesData;
+template< typename T > class QVector;
 class QPolygonF;
 class QPointF;
 class QRectF;
@@ -65,7 +66,17 @@ class QWT_EXPORT QwtPointMapper
            As the algorithm is fast it can be used inside of
            a polyline render cycle.
          */
-        WeedOutIntermediatePoints = 0x04
+        WeedOutIntermediatePoints = 0x04,
+
+        /*!
+           Indicate the gaps - caused by samples with NaN coordinates -
+           by a point with NaN coordinates between the polylines
+           in the result of toPolygonF(). Otherwise invalid samples
+           are skipped and the polygon is connected over the gaps.
+
+           \sa toPolylinesF()
+         */
+        KeepGaps = 0x08
     };
 
     Q_DECLARE_FLAGS( TransformationFlags, TransformationFlag )
@@ -85,6 +96,10 @@ class QWT_EXPORT QwtPointMapper
     QPolygonF toPolygonF( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QwtSeriesData< QPointF >* series, int from, int to ) const;
 
+    QPolygonF toPolylinesF( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >* series, int from, int to,
+        QVector< int >& polylineSizes ) const;
+
     QPolygon toPolygon( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QwtSeriesData< QPointF >* series, int from, int to ) const;
 
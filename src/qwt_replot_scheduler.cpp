@@ -0,0 +1,420 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_replot_scheduler.h"
+#include "qwt_plot.h"
+
+#include <qcoreapplication.h>
+#include <qelapsedtimer.h>
+#include <qpointer.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qevent.h>
+
+namespace
+{
+    class PlotState
+    {
+      public:
+        PlotState()
+            : isScheduled( false )
+            , isStale( false )
+        {
+        }
+
+        bool isScheduled;
+
+        // a request has been dropped, while the plot was hidden
+        bool isStale;
+    };
+}
+
+static inline bool qwtIsOnScreen( const QwtPlot* plot )
+{
+    return !plot->visibleRegion().isEmpty();
+}
+
+QwtReplotScheduler::Statistics::Statistics()
+    : requests( 0 )
+    , replots( 0 )
+    , coalesced( 0 )
+    , dropped( 0 )
+    , postponed( 0 )
+    , frames( 0 )
+{
+}
+
+class QwtReplotScheduler::PrivateData
+{
+  public:
+    PrivateData()
+        : frameInterval( 16 )
+        , frameBudget( 8 )
+        , timerId( 0 )
+    {
+    }
+
+    int frameInterval;
+    int frameBudget;
+
+    int timerId;
+    QElapsedTimer lastFrame;
+
+    QHash< QwtPlot*, PlotState > plots;
+    QList< QwtPlot* > queue;
+
+    Statistics statistics;
+};
+
+/*!
+   \brief Constructor
+
+   The default frame interval is 16ms ( ~60 frames per second ),
+   the default budget is 8ms.
+
+   \param parent Parent object
+   \sa instance()
+ */
+QwtReplotScheduler::QwtReplotScheduler( QObject* parent )
+    : QObject( parent )
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtReplotScheduler::~QwtReplotScheduler()
+{
+    delete m_data;
+}
+
+/*!
+   \return Scheduler, that is shared by all plots of the application
+
+   The scheduler is created on the first call and deleted together
+   with the application object.
+ */
+QwtReplotScheduler* QwtReplotScheduler::instance()
+{
+    static QPointer< QwtReplotScheduler > scheduler;
+
+    if ( scheduler.isNull() )
+        scheduler = new QwtReplotScheduler( QCoreApplication::instance() );
+
+    return scheduler;
+}
+
+/*!
+   \brief Set the minimum distance between two frames
+
+   \param msecs Interval in milliseconds
+   \sa frameInterval(), setFrameBudget()
+ */
+void QwtReplotScheduler::setFrameInterval( int msecs )
+{
+    m_data->frameInterval = qMax( msecs, 0 );
+}
+
+/*!
+   \return Minimum distance between two frames in milliseconds
+   \sa setFrameInterval()
+ */
+int QwtReplotScheduler::frameInterval() const
+{
+    return m_data->frameInterval;
+}
+
+/*!
+   \brief Set the time, that can be spent for replots in one frame
+
+   When the budget is exceeded the remaining plots are postponed
+   to the next frame. At least one plot is replotted per frame,
+   regardless of the budget.
+
+   \param msecs Budget in milliseconds, 0 means unlimited
+   \sa frameBudget(), setFrameInterval()
+ */
+void QwtReplotScheduler::setFrameBudget( int msecs )
+{
+    m_data->frameBudget = qMax( msecs, 0 );
+}
+
+/*!
+   \return Time, that can be spent for replots in one frame
+   \sa setFrameBudget()
+ */
+int QwtReplotScheduler::frameBudget() const
+{
+    return m_data->frameBudget;
+}
+
+/*!
+   \return True, when a replot of plot is pending
+   \param plot Plot
+ */
+bool QwtReplotScheduler::isScheduled( const QwtPlot* plot ) const
+{
+    QHash< QwtPlot*, PlotState >::const_iterator it =
+        m_data->plots.constFind( const_cast< QwtPlot* >( plot ) );
+
+    return ( it != m_data->plots.constEnd() ) && it.value().isScheduled;
+}
+
+//! \return Number of plots with pending replots
+int QwtReplotScheduler::pendingCount() const
+{
+    return m_data->queue.size();
+}
+
+/*!
+   \return Counters about requests and replots
+   \sa resetStatistics()
+ */
+QwtReplotScheduler::Statistics QwtReplotScheduler::statistics() const
+{
+    return m_data->statistics;
+}
+
+/*!
+   Reset all counters
+   \sa statistics()
+ */
+void QwtReplotScheduler::resetStatistics()
+{
+    m_data->statistics = Statistics();
+}
+
+/*!
+   \brief Request a replot
+
+   The plot will be replotted in the next frame, unless it is hidden.
+
+   \param plot Plot
+   \sa cancelReplot(), flush()
+ */
+void QwtReplotScheduler::scheduleReplot( QwtPlot* plot )
+{
+    if ( plot == NULL )
+        return;
+
+    m_data->statistics.requests++;
+
+    if ( !m_data->plots.contains( plot ) )
+    {
+        connect( plot, SIGNAL(destroyed(QObject*)),
+            this, SLOT(removePlot(QObject*)) );
+
+        // for replotting plots, when they are shown again
+        plot->installEventFilter( this );
+    }
+
+    PlotState& state = m_data->plots[ plot ];
+    if ( state.isScheduled )
+    {
+        m_data->statistics.coalesced++;
+        return;
+    }
+
+    state.isScheduled = true;
+    m_data->queue += plot;
+
+    activateTimer();
+}
+
+/*!
+   \brief Remove a pending replot
+
+   \param plot Plot
+   \sa scheduleReplot()
+ */
+void QwtReplotScheduler::cancelReplot( QwtPlot* plot )
+{
+    QHash< QwtPlot*, PlotState >::iterator it = m_data->plots.find( plot );
+    if ( it != m_data->plots.end() )
+    {
+        it.value().isScheduled = it.value().isStale = false;
+        m_data->queue.removeAll( plot );
+    }
+}
+
+/*!
+   \brief Replot all pending plots immediately
+
+   The frame budget is ignored, but requests for hidden plots
+   are dropped as in a regular frame.
+ */
+void QwtReplotScheduler::flush()
+{
+    processFrame( 0 );
+}
+
+/*!
+   \brief Replot stale plots, when they are shown again
+
+   \param object Object to be filtered
+   \param event Event
+   \return See QObject::eventFilter()
+ */
+bool QwtReplotScheduler::eventFilter( QObject* object, QEvent* event )
+{
+    if ( event->type() == QEvent::Show )
+    {
+        QHash< QwtPlot*, PlotState >::iterator it =
+            m_data->plots.find( static_cast< QwtPlot* >( object ) );
+
+        if ( it != m_data->plots.end() && it.value().isStale )
+        {
+            it.value().isStale = false;
+
+            if ( !it.value().isScheduled )
+            {
+                it.value().isScheduled = true;
+                m_data->queue += it.key();
+
+                activateTimer();
+            }
+        }
+    }
+
+    return QObject::eventFilter( object, event );
+}
+
+/*!
+   Process the next frame
+   \param event Timer event
+ */
+void QwtReplotScheduler::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == m_data->timerId )
+    {
+        killTimer( m_data->timerId );
+        m_data->timerId = 0;
+
+        processFrame( m_data->frameBudget );
+        return;
+    }
+
+    QObject::timerEvent( event );
+}
+
+void QwtReplotScheduler::removePlot( QObject* object )
+{
+    // called from ~QObject: object is no QwtPlot anymore
+    QwtPlot* plot = reinterpret_cast< QwtPlot* >( object );
+
+    m_data->plots.remove( plot );
+    m_data->queue.removeAll( plot );
+}
+
+void QwtReplotScheduler::activateTimer()
+{
+    if ( m_data->timerId != 0 || m_data->queue.isEmpty() )
+        return;
+
+    int delay = 0;
+    if ( m_data->lastFrame.isValid() )
+    {
+        const qint64 elapsed = m_data->lastFrame.elapsed();
+        if ( elapsed < m_data->frameInterval )
+            delay = m_data->frameInterval - int( elapsed );
+    }
+
+    m_data->timerId = startTimer( delay );
+}
+
+void QwtReplotScheduler::processFrame( int budget )
+{
+    if ( m_data->queue.isEmpty() )
+        return;
+
+    m_data->lastFrame.start();
+    m_data->statistics.frames++;
+
+    /*
+       Plots, that are visible on screen, first. Plots, that are
+       visible but covered or scrolled out of the viewport next.
+       The order of requests is preserved inside of each group.
+     */
+
+    QList< QwtPlot* > onScreen;
+    QList< QwtPlot* > offScreen;
+
+    const QList< QwtPlot* > queue = m_data->queue;
+    m_data->queue.clear();
+
+    for ( int i = 0; i < queue.size(); i++ )
+    {
+        QwtPlot* plot = queue[i];
+        PlotState& state = m_data->plots[ plot ];
+
+        if ( !plot->isVisible() )
+        {
+            state.isScheduled = false;
+            state.isStale = true;
+
+            m_data->statistics.dropped++;
+        }
+        else if ( qwtIsOnScreen( plot ) )
+        {
+            onScreen += plot;
+        }
+        else
+        {
+            offScreen += plot;
+        }
+    }
+
+    const QList< QwtPlot* > plots = onScreen + offScreen;
+
+    int numReplots = 0;
+    for ( int i = 0; i < plots.size(); i++ )
+    {
+        QwtPlot* plot = plots[i];
+
+        if ( !m_data->plots.contains( plot ) )
+        {
+            // deleted by a slot, that has been called during a replot
+            continue;
+        }
+
+        if ( budget > 0 && numReplots > 0
+            && m_data->lastFrame.elapsed() >= budget )
+        {
+            /*
+               The postponed plots go first in the next frame. Requests,
+               that have been made during this frame, are behind.
+             */
+
+            QList< QwtPlot* > postponed;
+            for ( int j = i; j < plots.size(); j++ )
+            {
+                if ( m_data->plots.contains( plots[j] ) )
+                    postponed += plots[j];
+            }
+
+            m_data->statistics.postponed += postponed.size();
+            m_data->queue = postponed + m_data->queue;
+
+            break;
+        }
+
+        // requests for this plot, while replotting, go to the next frame
+        m_data->plots[ plot ].isScheduled = false;
+
+        plot->replot();
+
+        numReplots++;
+        m_data->statistics.replots++;
+    }
+
+    activateTimer();
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_replot_scheduler.cpp"
+#endif
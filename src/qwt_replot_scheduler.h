@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_REPLOT_SCHEDULER_H
+#define QWT_REPLOT_SCHEDULER_H
+
+#include "qwt_global.h"
+#include <qobject.h>
+
+class QwtPlot;
+
+/*!
+   \brief Coalescing replots of many plots to frames
+
+   Applications with many plots, that are fed by independent data
+   sources, often replot the same plot several times during one
+   refresh cycle of the display. As each replot includes
+   QwtPlot::updateAxes(), processing layout requests and painting
+   the canvas, most of the CPU time is wasted for results nobody sees.
+
+   QwtReplotScheduler collects replot requests and executes them
+   in frames:
+
+   - a plot is replotted at most once per frame, all other
+     requests for it are coalesced
+   - frames are separated by frameInterval()
+   - plots, that are visible on screen, are replotted first
+   - when the time spent in a frame exceeds frameBudget() the
+     remaining plots are postponed to the next frame
+   - requests for hidden plots are dropped. The plot is replotted,
+     when it is shown again.
+
+   \code
+ // instead of calling plot->replot() for each new sample
+
+ QwtReplotScheduler::instance()->scheduleReplot( plot );
+   \endcode
+
+   \sa Statistics, QwtPlot::replot()
+   \note QwtReplotScheduler has to be used from the GUI thread.
+         Data sources living in other threads need to use
+         queued connections to scheduleReplot().
+ */
+class QWT_EXPORT QwtReplotScheduler : public QObject
+{
+    Q_OBJECT
+
+  public:
+    /*!
+       \brief Counters of a QwtReplotScheduler
+       \sa statistics(), resetStatistics()
+     */
+    class QWT_EXPORT Statistics
+    {
+      public:
+        Statistics();
+
+        //! Number of calls of scheduleReplot()
+        int requests;
+
+        //! Number of executed replots
+        int replots;
+
+        //! Number of requests for plots, that had been scheduled before
+        int coalesced;
+
+        //! Number of requests, that have been dropped for hidden plots
+        int dropped;
+
+        //! Number of replots, that have been postponed because of the frame budget
+        int postponed;
+
+        //! Number of processed frames
+        int frames;
+    };
+
+    explicit QwtReplotScheduler( QObject* parent = NULL );
+    virtual ~QwtReplotScheduler();
+
+    static QwtReplotScheduler* instance();
+
+    void setFrameInterval( int msecs );
+    int frameInterval() const;
+
+    void setFrameBudget( int msecs );
+    int frameBudget() const;
+
+    bool isScheduled( const QwtPlot* ) const;
+    int pendingCount() const;
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+    virtual bool eventFilter( QObject*, QEvent* ) QWT_OVERRIDE;
+
+  public Q_SLOTS:
+    void scheduleReplot( QwtPlot* );
+    void cancelReplot( QwtPlot* );
+
+    void flush();
+
+  protected:
+    virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
+
+  private Q_SLOTS:
+    void removePlot( QObject* );
+
+  private:
+    void processFrame( int budget );
+    void activateTimer();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,263 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SAMPLE_ARRAY_DATA_H
+#define QWT_SAMPLE_ARRAY_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_samples.h"
+
+/*!
+   \brief Interval samples, that are stored in separate arrays of T
+
+   QwtIntervalArrayData is an alternative for QwtIntervalSeriesData, when
+   the values are available in a type, that is smaller than double.
+   F.e. storing the minimum and maximum values as float and the position
+   as double needs 16 bytes per sample instead of 24 bytes for a
+   QwtIntervalSample.
+
+   \tparam T Type of the minimum and maximum values
+   \tparam P Type of the position ( QwtIntervalSample::value )
+
+   \sa QwtPlotIntervalCurve, QwtPlotHistogram, QwtOHLCArrayData
+ */
+template< typename T, typename P = T >
+class QwtIntervalArrayData : public QwtSeriesData< QwtIntervalSample >
+{
+  public:
+    QwtIntervalArrayData( const QVector< P >& values,
+        const QVector< T >& minValues, const QVector< T >& maxValues );
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QwtIntervalSample sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual QwtSeriesData< QwtIntervalSample >* snapshot() const QWT_OVERRIDE;
+
+    const QVector< P >& values() const;
+    const QVector< T >& minValues() const;
+    const QVector< T >& maxValues() const;
+
+  private:
+    QVector< P > m_values;
+    QVector< T > m_minValues;
+    QVector< T > m_maxValues;
+};
+
+/*!
+   \brief OHLC samples, that are stored in separate arrays of T
+
+   QwtOHLCArrayData is an alternative for QwtTradingChartData, when
+   the prices are available in a type, that is smaller than double.
+   F.e. storing the prices as float and the time as double needs
+   24 bytes per sample instead of 40 bytes for a QwtOHLCSample.
+
+   \tparam T Type of the prices
+   \tparam P Type of the time
+
+   \sa QwtPlotTradingCurve, QwtIntervalArrayData
+ */
+template< typename T, typename P = T >
+class QwtOHLCArrayData : public QwtSeriesData< QwtOHLCSample >
+{
+  public:
+    QwtOHLCArrayData( const QVector< P >& time,
+        const QVector< T >& open, const QVector< T >& high,
+        const QVector< T >& low, const QVector< T >& close );
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QwtOHLCSample sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual QwtSeriesData< QwtOHLCSample >* snapshot() const QWT_OVERRIDE;
+
+    const QVector< P >& timeData() const;
+    const QVector< T >& openData() const;
+    const QVector< T >& highData() const;
+    const QVector< T >& lowData() const;
+    const QVector< T >& closeData() const;
+
+  private:
+    QVector< P > m_time;
+    QVector< T > m_open;
+    QVector< T > m_high;
+    QVector< T > m_low;
+    QVector< T > m_close;
+};
+
+/*!
+   Constructor
+
+   \param values Array of positions
+   \param minValues Array of the minimum values of the intervals
+   \param maxValues Array of the maximum values of the intervals
+
+   \sa QwtPlotIntervalCurve::setSamples(), QwtPlotHistogram::setSamples()
+ */
+template< typename T, typename P >
+QwtIntervalArrayData< T, P >::QwtIntervalArrayData( const QVector< P >& values,
+        const QVector< T >& minValues, const QVector< T >& maxValues )
+    : m_values( values )
+    , m_minValues( minValues )
+    , m_maxValues( maxValues )
+{
+}
+
+//! \return Size of the data set
+template< typename T, typename P >
+size_t QwtIntervalArrayData< T, P >::size() const
+{
+    return qMin( m_values.size(), qMin( m_minValues.size(), m_maxValues.size() ) );
+}
+
+/*!
+   Return the sample at position i
+
+   \param index Index
+   \return Sample at position i
+ */
+template< typename T, typename P >
+QwtIntervalSample QwtIntervalArrayData< T, P >::sample( size_t index ) const
+{
+    const int i = int( index );
+    return QwtIntervalSample( m_values[i], m_minValues[i], m_maxValues[i] );
+}
+
+/*!
+   \return Shallow copy of the arrays
+   \sa QwtSeriesData::snapshot()
+ */
+template< typename T, typename P >
+QwtSeriesData< QwtIntervalSample >* QwtIntervalArrayData< T, P >::snapshot() const
+{
+    QwtIntervalArrayData< T, P >* data =
+        new QwtIntervalArrayData< T, P >( m_values, m_minValues, m_maxValues );
+    data->cachedBoundingRect = cachedBoundingRect;
+
+    return data;
+}
+
+//! \return Array of the positions
+template< typename T, typename P >
+const QVector< P >& QwtIntervalArrayData< T, P >::values() const
+{
+    return m_values;
+}
+
+//! \return Array of the minimum values
+template< typename T, typename P >
+const QVector< T >& QwtIntervalArrayData< T, P >::minValues() const
+{
+    return m_minValues;
+}
+
+//! \return Array of the maximum values
+template< typename T, typename P >
+const QVector< T >& QwtIntervalArrayData< T, P >::maxValues() const
+{
+    return m_maxValues;
+}
+
+/*!
+   Constructor
+
+   \param time Array of time values
+   \param open Array of opening prices
+   \param high Array of highest prices
+   \param low Array of lowest prices
+   \param close Array of closing prices
+
+   \sa QwtPlotTradingCurve::setSamples()
+ */
+template< typename T, typename P >
+QwtOHLCArrayData< T, P >::QwtOHLCArrayData( const QVector< P >& time,
+        const QVector< T >& open, const QVector< T >& high,
+        const QVector< T >& low, const QVector< T >& close )
+    : m_time( time )
+    , m_open( open )
+    , m_high( high )
+    , m_low( low )
+    , m_close( close )
+{
+}
+
+//! \return Size of the data set
+template< typename T, typename P >
+size_t QwtOHLCArrayData< T, P >::size() const
+{
+    const size_t size1 = qMin( m_time.size(), m_open.size() );
+    const size_t size2 = qMin( m_high.size(), qMin( m_low.size(), m_close.size() ) );
+
+    return qMin( size1, size2 );
+}
+
+/*!
+   Return the sample at position i
+
+   \param index Index
+   \return Sample at position i
+ */
+template< typename T, typename P >
+QwtOHLCSample QwtOHLCArrayData< T, P >::sample( size_t index ) const
+{
+    const int i = int( index );
+
+    return QwtOHLCSample( m_time[i],
+        m_open[i], m_high[i], m_low[i], m_close[i] );
+}
+
+/*!
+   \return Shallow copy of the arrays
+   \sa QwtSeriesData::snapshot()
+ */
+template< typename T, typename P >
+QwtSeriesData< QwtOHLCSample >* QwtOHLCArrayData< T, P >::snapshot() const
+{
+    QwtOHLCArrayData< T, P >* data = new QwtOHLCArrayData< T, P >(
+        m_time, m_open, m_high, m_low, m_close );
+    data->cachedBoundingRect = cachedBoundingRect;
+
+    return data;
+}
+
+//! \return Array of the time values
+template< typename T, typename P >
+const QVector< P >& QwtOHLCArrayData< T, P >::timeData() const
+{
+    return m_time;
+}
+
+//! \return Array of the opening prices
+template< typename T, typename P >
+const QVector< T >& QwtOHLCArrayData< T, P >::openData() const
+{
+    return m_open;
+}
+
+//! \return Array of the highest prices
+template< typename T, typename P >
+const QVector< T >& QwtOHLCArrayData< T, P >::highData() const
+{
+    return m_high;
+}
+
+//! \return Array of the lowest prices
+template< typename T, typename P >
+const QVector< T >& QwtOHLCArrayData< T, P >::lowData() const
+{
+    return m_low;
+}
+
+//! \return Array of the closing prices
+template< typename T, typename P >
+const QVector< T >& QwtOHLCArrayData< T, P >::closeData() const
+{
+    return m_close;
+}
+
+#endif
@@ -12,6 +12,10 @@
 
 static inline QRectF qwtBoundingRect( const QPointF& sample )
 {
+    // samples with NaN coordinates are gaps in a curve
+    if ( qIsNaN( sample.x() ) || qIsNaN( sample.y() ) )
+        return QRectF( 0.0, 0.0, -1.0, -1.0 );
+
     return QRectF( sample.x(), sample.y(), 0.0, 0.0 );
 }
 
@@ -106,6 +106,20 @@ class QwtSeriesData
      */
     virtual void setRectOfInterest( const QRectF& rect );
 
+    /*!
+       \brief Create an immutable copy of the series
+
+       A snapshot can be read from another thread, while the series
+       is modified in the GUI thread. The default implementation
+       copies all samples into a QwtArraySeriesData object.
+       Implementations, that store their samples in implicitly shared
+       containers, should return a shallow copy instead.
+
+       \return Snapshot, that has to be deleted by the caller
+       \sa QwtPlotItem::snapshot()
+     */
+    virtual QwtSeriesData< T >* snapshot() const;
+
   protected:
     //! Can be used to cache a calculated bounding rectangle
     mutable QRectF cachedBoundingRect;
@@ -169,6 +183,12 @@ class QwtArraySeriesData : public QwtSeriesData< T >
      */
     virtual T sample( size_t index ) const QWT_OVERRIDE;
 
+    /*!
+       \return Shallow copy of the samples
+       \sa QwtSeriesData::snapshot()
+     */
+    virtual QwtSeriesData< T >* snapshot() const QWT_OVERRIDE;
+
   protected:
     //! Vector of samples
     QVector< T > m_samples;
@@ -210,6 +230,34 @@ T QwtArraySeriesData< T >::sample( size_t i ) const
     return m_samples[ static_cast< int >( i ) ];
 }
 
+template< typename T >
+QwtSeriesData< T >* QwtArraySeriesData< T >::snapshot() const
+{
+    QwtArraySeriesData< T >* data = new QwtArraySeriesData< T >( m_samples );
+    data->cachedBoundingRect = QwtSeriesData< T >::cachedBoundingRect;
+
+    return data;
+}
+
+template< typename T >
+QwtSeriesData< T >* QwtSeriesData< T >::snapshot() const
+{
+    const size_t numSamples = size();
+
+    QVector< T > samples;
+    samples.reserve( static_cast< int >( numSamples ) );
+
+    for ( size_t i = 0; i < numSamples; i++ )
+        samples += sample( i );
+
+    QwtSeriesData< T >* data = new QwtArraySeriesData< T >( samples );
+
+    // the bounding rectangle might differ from what qwtBoundingRect returns
+    data->cachedBoundingRect = boundingRect();
+
+    return data;
+}
+
 //! Interface for iterating over an array of points
 typedef QwtArraySeriesData< QPointF > QwtPointSeriesData;
 
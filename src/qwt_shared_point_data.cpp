@@ -0,0 +1,243 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_shared_point_data.h"
+#include "qwt_shared_ring_buffer.h"
+
+#include <qnumeric.h>
+
+static inline quint64 qwtGuardSize(
+    const QwtSharedRingBuffer* buffer, quint64 guardSize )
+{
+    const quint64 capacity = buffer->capacity();
+
+    if ( guardSize == 0 )
+        guardSize = capacity / 8;
+
+    return qMin( guardSize, capacity );
+}
+
+static inline bool qwtIsValidColumn( int column, int recordSize )
+{
+    return ( column >= 0 ) && ( column < recordSize );
+}
+
+/*!
+   \brief Constructor
+
+   \param buffer Ring buffer, that needs to remain valid during the
+                 lifetime of the data object
+   \param yColumn Column of the y coordinates in the records
+   \param xColumn Column of the x coordinates in the records.
+                  When xColumn < 0 the index of the record is
+                  used as x coordinate.
+
+   \note The columns are validated against the record size of the buffer
+         here and in update(), as the record size is not known before the
+         buffer has been attached. For invalid columns the snapshot is empty.
+ */
+QwtSharedPointData::QwtSharedPointData( const QwtSharedRingBuffer* buffer,
+        int yColumn, int xColumn )
+    : m_buffer( buffer )
+    , m_xColumn( xColumn )
+    , m_yColumn( yColumn )
+    , m_validColumns( false )
+    , m_guardSize( 0 )
+    , m_maxSize( 0 )
+    , m_head( 0 )
+    , m_first( 0 )
+    , m_size( 0 )
+{
+    m_validColumns = hasValidColumns();
+}
+
+//! Destructor
+QwtSharedPointData::~QwtSharedPointData()
+{
+}
+
+//! \return Ring buffer
+const QwtSharedRingBuffer* QwtSharedPointData::buffer() const
+{
+    return m_buffer;
+}
+
+//! \return Column of the x coordinates, or -1 for using the record index
+int QwtSharedPointData::xColumn() const
+{
+    return m_xColumn;
+}
+
+//! \return Column of the y coordinates
+int QwtSharedPointData::yColumn() const
+{
+    return m_yColumn;
+}
+
+/*!
+   \brief Set the number of records, that are excluded from a snapshot
+
+   The snapshot excludes the oldest records of the buffer, so that the
+   producer can append up to guardSize records, before it overwrites
+   records of the snapshot. The guard needs to be larger than the number
+   of records appended during a replot.
+
+   The default setting is 0, what means 1/8 of the capacity of the buffer.
+
+   \param guardSize Number of records
+   \sa guardSize(), isOverwritten(), update()
+ */
+void QwtSharedPointData::setGuardSize( quint64 guardSize )
+{
+    m_guardSize = guardSize;
+}
+
+/*!
+   \return Number of records, that are excluded from a snapshot
+   \sa setGuardSize()
+ */
+quint64 QwtSharedPointData::guardSize() const
+{
+    return m_guardSize;
+}
+
+/*!
+   \brief Limit the number of records of a snapshot
+
+   The default setting is 0, what means no limit beside
+   the capacity of the buffer and the guard size.
+
+   \param maxSize Maximum number of records
+   \sa maxSize(), setGuardSize()
+ */
+void QwtSharedPointData::setMaxSize( quint64 maxSize )
+{
+    m_maxSize = maxSize;
+}
+
+/*!
+   \return Maximum number of records of a snapshot
+   \sa setMaxSize()
+ */
+quint64 QwtSharedPointData::maxSize() const
+{
+    return m_maxSize;
+}
+
+/*!
+   \brief Take a snapshot of the most recent records of the buffer
+
+   update() is a cheap operation: it only reads the head
+   of the buffer, but doesn't copy any records.
+
+   \return true, when records have been appended since the last update
+   \sa size(), isOverwritten()
+ */
+bool QwtSharedPointData::update()
+{
+    m_validColumns = hasValidColumns();
+
+    if ( !m_validColumns || !m_buffer->isAttached() )
+    {
+        const bool changed = ( m_size > 0 );
+
+        m_head = m_first = 0;
+        m_size = 0;
+
+        return changed;
+    }
+
+    const quint64 head = m_buffer->head();
+    if ( head == m_head && m_size > 0 )
+        return false;
+
+    quint64 count = m_buffer->capacity() - qwtGuardSize( m_buffer, m_guardSize );
+    if ( m_maxSize > 0 )
+        count = qMin( count, m_maxSize );
+
+    count = qMin( count, head );
+
+    m_head = head;
+    m_first = head - count;
+    m_size = static_cast< size_t >( count );
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+
+    return true;
+}
+
+/*!
+   \brief Check if records of the snapshot might have been overwritten
+
+   This is the case, when the producer has appended more
+   records, than fit into the guard since the last update().
+
+   \return true, when the snapshot is not reliable anymore
+   \sa update(), setGuardSize()
+ */
+bool QwtSharedPointData::isOverwritten() const
+{
+    if ( m_size == 0 )
+        return false;
+
+    const quint64 appended = m_buffer->head() - m_head;
+    return appended > m_buffer->capacity() - m_size;
+}
+
+/*!
+   \return true, when the columns are inside the records of the buffer
+   \sa xColumn(), yColumn(), QwtSharedRingBuffer::recordSize()
+ */
+bool QwtSharedPointData::hasValidColumns() const
+{
+    if ( m_buffer == NULL )
+        return false;
+
+    const int recordSize = m_buffer->recordSize();
+
+    if ( !qwtIsValidColumn( m_yColumn, recordSize ) )
+        return false;
+
+    return ( m_xColumn < 0 ) || qwtIsValidColumn( m_xColumn, recordSize );
+}
+
+//! \return Index of the record, that corresponds to the first sample
+quint64 QwtSharedPointData::firstIndex() const
+{
+    return m_first;
+}
+
+//! \return Number of samples of the snapshot
+size_t QwtSharedPointData::size() const
+{
+    return m_size;
+}
+
+/*!
+   Return the sample at position i
+
+   \param index Index
+   \return Sample at position i
+ */
+QPointF QwtSharedPointData::sample( size_t index ) const
+{
+    if ( !m_validColumns )
+        return QPointF( qQNaN(), qQNaN() );
+
+    const quint64 recordIndex = m_first + index;
+
+    const double* values = m_buffer->record( recordIndex );
+    if ( values == NULL )
+        return QPointF( qQNaN(), qQNaN() );
+
+    const double x = ( m_xColumn >= 0 )
+        ? values[m_xColumn] : static_cast< double >( recordIndex );
+
+    return QPointF( x, values[m_yColumn] );
+}
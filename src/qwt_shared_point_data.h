@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SHARED_POINT_DATA_H
+#define QWT_SHARED_POINT_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+class QwtSharedRingBuffer;
+
+/*!
+   \brief Point data, that is read from a QwtSharedRingBuffer
+
+   QwtSharedPointData maps the records of a ring buffer, that is filled
+   by another process, to points without copying them.
+   The x and y coordinates are taken from columns of the records, so that
+   several curves can display different channels of the same buffer.
+   When no x column is specified the index of the record is used as x value.
+
+   The data is a snapshot of the buffer, that is taken by update().
+   An application has to call update() before replotting - usually
+   from a timer.
+
+   \code
+ QwtSharedRingBuffer* buffer = new QwtSharedRingBuffer();
+ buffer->attach( "acquisition" );
+
+ for ( int i = 0; i < numChannels; i++ )
+ {
+     QwtSharedPointData* data = new QwtSharedPointData( buffer, i + 1, 0 );
+     curves[i]->setData( data );
+ }
+   \endcode
+
+   \sa QwtSharedRingBuffer, QwtSharedRasterData
+ */
+class QWT_EXPORT QwtSharedPointData : public QwtSeriesData< QPointF >
+{
+  public:
+    explicit QwtSharedPointData( const QwtSharedRingBuffer*,
+        int yColumn = 1, int xColumn = 0 );
+
+    virtual ~QwtSharedPointData();
+
+    const QwtSharedRingBuffer* buffer() const;
+
+    int xColumn() const;
+    int yColumn() const;
+
+    bool hasValidColumns() const;
+
+    void setGuardSize( quint64 );
+    quint64 guardSize() const;
+
+    void setMaxSize( quint64 );
+    quint64 maxSize() const;
+
+    bool update();
+    bool isOverwritten() const;
+
+    quint64 firstIndex() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+  private:
+    const QwtSharedRingBuffer* m_buffer;
+
+    int m_xColumn;
+    int m_yColumn;
+    bool m_validColumns;
+
+    quint64 m_guardSize;
+    quint64 m_maxSize;
+
+    quint64 m_head;
+    quint64 m_first;
+    size_t m_size;
+};
+
+#endif
@@ -0,0 +1,286 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_shared_raster_data.h"
+#include "qwt_shared_ring_buffer.h"
+#include "qwt_interval.h"
+
+#include <qnumeric.h>
+#include <qrect.h>
+
+class QwtSharedRasterData::PrivateData
+{
+  public:
+    PrivateData( const QwtSharedRingBuffer* ringBuffer )
+        : buffer( ringBuffer )
+        , rowStep( 1.0 )
+        , guardSize( 0 )
+        , maxRows( 0 )
+        , head( 0 )
+        , first( 0 )
+        , numRows( 0 )
+    {
+    }
+
+    const QwtSharedRingBuffer* buffer;
+
+    QwtInterval intervals[3];
+    double rowStep;
+
+    quint64 guardSize;
+    quint64 maxRows;
+
+    quint64 head;
+    quint64 first;
+    quint64 numRows;
+};
+
+/*!
+   \brief Constructor
+
+   \param buffer Ring buffer, that needs to remain valid during the
+                 lifetime of the data object
+ */
+QwtSharedRasterData::QwtSharedRasterData( const QwtSharedRingBuffer* buffer )
+{
+    m_data = new PrivateData( buffer );
+}
+
+//! Destructor
+QwtSharedRasterData::~QwtSharedRasterData()
+{
+    delete m_data;
+}
+
+//! \return Ring buffer
+const QwtSharedRingBuffer* QwtSharedRasterData::buffer() const
+{
+    return m_data->buffer;
+}
+
+/*!
+   \brief Assign the bounding interval for an axis
+
+   The interval of the x axis is spanned by the columns, the interval
+   of the z axis defines the range of the values. The interval of
+   the y axis is calculated from the snapshot and can't be assigned.
+
+   \param axis X or Z axis
+   \param interval Interval
+
+   \sa interval(), setRowStep()
+ */
+void QwtSharedRasterData::setInterval(
+    Qt::Axis axis, const QwtInterval& interval )
+{
+    if ( axis == Qt::XAxis || axis == Qt::ZAxis )
+        m_data->intervals[axis] = interval;
+}
+
+/*!
+   \return Bounding interval for an axis
+   \sa setInterval()
+ */
+QwtInterval QwtSharedRasterData::interval( Qt::Axis axis ) const
+{
+    if ( axis == Qt::YAxis )
+    {
+        if ( m_data->numRows == 0 )
+            return QwtInterval();
+
+        const double y1 = m_data->first * m_data->rowStep;
+        const double y2 = ( m_data->first + m_data->numRows ) * m_data->rowStep;
+
+        return QwtInterval( y1, y2, QwtInterval::ExcludeMaximum ).normalized();
+    }
+
+    if ( axis >= 0 && axis <= 2 )
+        return m_data->intervals[ axis ];
+
+    return QwtInterval();
+}
+
+/*!
+   \brief Set the distance between 2 rows in y direction
+
+   The default setting is 1.0.
+
+   \param step Distance between 2 rows
+   \sa rowStep(), interval()
+ */
+void QwtSharedRasterData::setRowStep( double step )
+{
+    if ( step != 0.0 )
+        m_data->rowStep = step;
+}
+
+/*!
+   \return Distance between 2 rows in y direction
+   \sa setRowStep()
+ */
+double QwtSharedRasterData::rowStep() const
+{
+    return m_data->rowStep;
+}
+
+/*!
+   \brief Set the number of rows, that are excluded from a snapshot
+
+   The default setting is 0, what means 1/8 of the capacity of the buffer.
+
+   \param guardSize Number of rows
+   \sa QwtSharedPointData::setGuardSize()
+ */
+void QwtSharedRasterData::setGuardSize( quint64 guardSize )
+{
+    m_data->guardSize = guardSize;
+}
+
+/*!
+   \return Number of rows, that are excluded from a snapshot
+   \sa setGuardSize()
+ */
+quint64 QwtSharedRasterData::guardSize() const
+{
+    return m_data->guardSize;
+}
+
+/*!
+   \brief Limit the number of rows of a snapshot
+
+   The default setting is 0, what means no limit beside
+   the capacity of the buffer and the guard size.
+
+   \param maxRows Maximum number of rows
+   \sa maxRows()
+ */
+void QwtSharedRasterData::setMaxRows( quint64 maxRows )
+{
+    m_data->maxRows = maxRows;
+}
+
+/*!
+   \return Maximum number of rows of a snapshot
+   \sa setMaxRows()
+ */
+quint64 QwtSharedRasterData::maxRows() const
+{
+    return m_data->maxRows;
+}
+
+/*!
+   \brief Take a snapshot of the most recent rows of the buffer
+
+   \return true, when rows have been appended since the last update
+   \sa QwtSharedPointData::update()
+ */
+bool QwtSharedRasterData::update()
+{
+    const QwtSharedRingBuffer* buffer = m_data->buffer;
+
+    if ( buffer == NULL || !buffer->isAttached() )
+    {
+        const bool changed = ( m_data->numRows > 0 );
+
+        m_data->head = m_data->first = m_data->numRows = 0;
+        return changed;
+    }
+
+    const quint64 head = buffer->head();
+    if ( head == m_data->head && m_data->numRows > 0 )
+        return false;
+
+    const quint64 capacity = buffer->capacity();
+
+    quint64 guardSize = m_data->guardSize;
+    if ( guardSize == 0 )
+        guardSize = capacity / 8;
+
+    quint64 count = capacity - qMin( guardSize, capacity );
+    if ( m_data->maxRows > 0 )
+        count = qMin( count, m_data->maxRows );
+
+    count = qMin( count, head );
+
+    m_data->head = head;
+    m_data->first = head - count;
+    m_data->numRows = count;
+
+    return true;
+}
+
+/*!
+   \return true, when rows of the snapshot might have been overwritten
+   \sa QwtSharedPointData::isOverwritten()
+ */
+bool QwtSharedRasterData::isOverwritten() const
+{
+    if ( m_data->numRows == 0 )
+        return false;
+
+    const QwtSharedRingBuffer* buffer = m_data->buffer;
+
+    const quint64 appended = buffer->head() - m_data->head;
+    return appended > buffer->capacity() - m_data->numRows;
+}
+
+/*!
+   \brief Calculate the pixel hint
+
+   \param area Requested area, ignored
+   \return Geometry of the top left cell of the snapshot
+ */
+QRectF QwtSharedRasterData::pixelHint( const QRectF& area ) const
+{
+    Q_UNUSED( area )
+
+    const QwtInterval intervalX = interval( Qt::XAxis );
+    const QwtInterval intervalY = interval( Qt::YAxis );
+
+    const int numColumns = m_data->buffer ? m_data->buffer->recordSize() : 0;
+
+    if ( numColumns <= 0 || !intervalX.isValid() || !intervalY.isValid() )
+        return QRectF();
+
+    return QRectF( intervalX.minValue(), intervalY.minValue(),
+        intervalX.width() / numColumns, qAbs( m_data->rowStep ) );
+}
+
+/*!
+   \return the value at a raster position
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+ */
+double QwtSharedRasterData::value( double x, double y ) const
+{
+    const QwtInterval xInterval = m_data->intervals[Qt::XAxis];
+
+    if ( m_data->numRows == 0 || xInterval.width() <= 0.0
+        || !xInterval.contains( x ) )
+    {
+        return qQNaN();
+    }
+
+    const double row = y / m_data->rowStep;
+    if ( row < m_data->first || row >= m_data->first + m_data->numRows )
+        return qQNaN();
+
+    const int numColumns = m_data->buffer->recordSize();
+
+    const double colF = ( x - xInterval.minValue() )
+        / xInterval.width() * numColumns;
+
+    const int col = qBound( 0, int( colF ), numColumns - 1 );
+
+    const double* values = m_data->buffer->record( quint64( row ) );
+    if ( values == NULL )
+        return qQNaN();
+
+    return values[col];
+}
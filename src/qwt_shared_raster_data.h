@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SHARED_RASTER_DATA_H
+#define QWT_SHARED_RASTER_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_raster_data.h"
+
+class QwtSharedRingBuffer;
+
+/*!
+   \brief Raster data, that is read from a QwtSharedRingBuffer
+
+   Each record of the ring buffer is interpreted as a row of a matrix,
+   like the spectra of a waterfall diagram, that are appended by an
+   acquisition process. The values are read directly from the shared memory
+   using a nearest neighbour lookup.
+
+   The columns are spread equidistantly over the interval of the x axis,
+   while the y coordinate of a row is its record index multiplied
+   by rowStep(). The interval of the y axis covers the rows
+   of the snapshot, that has been taken by update().
+
+   \sa QwtSharedRingBuffer, QwtSharedPointData, QwtMatrixRasterData
+ */
+class QWT_EXPORT QwtSharedRasterData : public QwtRasterData
+{
+  public:
+    explicit QwtSharedRasterData( const QwtSharedRingBuffer* );
+    virtual ~QwtSharedRasterData();
+
+    const QwtSharedRingBuffer* buffer() const;
+
+    void setInterval( Qt::Axis, const QwtInterval& );
+    virtual QwtInterval interval( Qt::Axis ) const QWT_OVERRIDE;
+
+    void setRowStep( double );
+    double rowStep() const;
+
+    void setGuardSize( quint64 );
+    quint64 guardSize() const;
+
+    void setMaxRows( quint64 );
+    quint64 maxRows() const;
+
+    bool update();
+    bool isOverwritten() const;
+
+    virtual QRectF pixelHint( const QRectF& ) const QWT_OVERRIDE;
+    virtual double value( double x, double y ) const QWT_OVERRIDE;
+
+  private:
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,455 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_shared_ring_buffer.h"
+
+#include <qatomic.h>
+#include <qfile.h>
+#include <qsharedmemory.h>
+#include <qstring.h>
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    struct RingBufferHeader
+    {
+        quint32 magic;
+        quint32 version;
+        QBasicAtomicInteger< quint32 > sequence;
+        quint32 recordSize;
+        quint64 capacity;
+        quint64 head;
+
+        quint64 reserved[4];
+    };
+
+    Q_STATIC_ASSERT( sizeof( RingBufferHeader ) == 64 );
+}
+
+static const quint32 qwtRingBufferMagic = 0x51777252;
+static const quint32 qwtRingBufferVersion = 1;
+
+/*
+    Size of the memory in bytes, or -1, when it doesn't fit into qint64,
+    what might happen for a corrupt header
+ */
+static inline qint64 qwtRingBufferSize( quint64 recordSize, quint64 capacity )
+{
+    const quint64 maxSize = quint64( std::numeric_limits< qint64 >::max() );
+    const quint64 headerSize = sizeof( RingBufferHeader );
+
+    if ( recordSize == 0 || recordSize > maxSize / sizeof( double ) )
+        return -1;
+
+    const quint64 recordBytes = recordSize * sizeof( double );
+    if ( capacity > ( maxSize - headerSize ) / recordBytes )
+        return -1;
+
+    return qint64( headerSize + capacity * recordBytes );
+}
+
+class QwtSharedRingBuffer::PrivateData
+{
+  public:
+    PrivateData()
+        : header( NULL )
+        , records( NULL )
+        , isReadOnly( true )
+        , lastHead( 0 )
+    {
+    }
+
+    QSharedMemory sharedMemory;
+    QFile file;
+
+    RingBufferHeader* header;
+    double* records;
+
+    bool isReadOnly;
+    QString errorString;
+
+    mutable quint64 lastHead;
+};
+
+//! Constructor
+QwtSharedRingBuffer::QwtSharedRingBuffer()
+    : m_records( NULL )
+    , m_capacity( 0 )
+    , m_recordSize( 0 )
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtSharedRingBuffer::~QwtSharedRingBuffer()
+{
+    detach();
+    delete m_data;
+}
+
+/*!
+   \brief Create a buffer in a QSharedMemory segment
+
+   \param key Key of the QSharedMemory segment
+   \param recordSize Number of doubles of a record
+   \param capacity Number of records
+
+   \return true, when the buffer could be created
+   \sa attach(), createFile(), errorString()
+ */
+bool QwtSharedRingBuffer::create(
+    const QString& key, int recordSize, quint64 capacity )
+{
+    detach();
+
+    if ( recordSize <= 0 || capacity == 0 )
+    {
+        m_data->errorString = QStringLiteral( "Invalid buffer size" );
+        return false;
+    }
+
+    const qint64 size = qwtRingBufferSize( quint64( recordSize ), capacity );
+    if ( size < 0 || size > std::numeric_limits< int >::max() )
+    {
+        m_data->errorString = QStringLiteral( "Buffer too large for QSharedMemory" );
+        return false;
+    }
+
+    QSharedMemory& sharedMemory = m_data->sharedMemory;
+    sharedMemory.setKey( key );
+
+    bool ok = sharedMemory.create( int( size ) );
+    if ( !ok && sharedMemory.error() == QSharedMemory::AlreadyExists )
+    {
+        // a segment, that has been left over from a crashed process,
+        // gets released, when detaching from it
+
+        if ( sharedMemory.attach() )
+            sharedMemory.detach();
+
+        ok = sharedMemory.create( int( size ) );
+    }
+
+    if ( !ok )
+    {
+        m_data->errorString = sharedMemory.errorString();
+        return false;
+    }
+
+    return initialize( static_cast< uchar* >( sharedMemory.data() ),
+        sharedMemory.size(), true, recordSize, capacity, false );
+}
+
+/*!
+   \brief Attach to a buffer in an existing QSharedMemory segment
+
+   \param key Key of the QSharedMemory segment
+   \param mode Access mode
+
+   \return true, when the buffer could be attached
+   \sa create(), attachFile(), errorString()
+ */
+bool QwtSharedRingBuffer::attach( const QString& key, AccessMode mode )
+{
+    detach();
+
+    QSharedMemory& sharedMemory = m_data->sharedMemory;
+    sharedMemory.setKey( key );
+
+    const QSharedMemory::AccessMode accessMode = ( mode == ReadOnly )
+        ? QSharedMemory::ReadOnly : QSharedMemory::ReadWrite;
+
+    if ( !sharedMemory.attach( accessMode ) )
+    {
+        m_data->errorString = sharedMemory.errorString();
+        return false;
+    }
+
+    return initialize( static_cast< uchar* >( sharedMemory.data() ),
+        sharedMemory.size(), false, 0, 0, mode == ReadOnly );
+}
+
+/*!
+   \brief Create a buffer in a file, that is mapped into memory
+
+   An existing file will be truncated.
+
+   \param fileName File name
+   \param recordSize Number of doubles of a record
+   \param capacity Number of records
+
+   \return true, when the buffer could be created
+   \sa attachFile(), create(), errorString()
+ */
+bool QwtSharedRingBuffer::createFile(
+    const QString& fileName, int recordSize, quint64 capacity )
+{
+    detach();
+
+    if ( recordSize <= 0 || capacity == 0 )
+    {
+        m_data->errorString = QStringLiteral( "Invalid buffer size" );
+        return false;
+    }
+
+    const qint64 size = qwtRingBufferSize( quint64( recordSize ), capacity );
+    if ( size < 0 )
+    {
+        m_data->errorString = QStringLiteral( "Invalid buffer size" );
+        return false;
+    }
+
+    QFile& file = m_data->file;
+    file.setFileName( fileName );
+
+    if ( !file.open( QIODevice::ReadWrite | QIODevice::Truncate )
+        || !file.resize( size ) )
+    {
+        m_data->errorString = file.errorString();
+        file.close();
+
+        return false;
+    }
+
+    uchar* memory = file.map( 0, size );
+    if ( memory == NULL )
+    {
+        m_data->errorString = file.errorString();
+        file.close();
+
+        return false;
+    }
+
+    return initialize( memory, size, true, recordSize, capacity, false );
+}
+
+/*!
+   \brief Attach to a buffer in an existing file, that is mapped into memory
+
+   \param fileName File name
+   \param mode Access mode
+
+   \return true, when the buffer could be attached
+   \sa createFile(), attach(), errorString()
+ */
+bool QwtSharedRingBuffer::attachFile( const QString& fileName, AccessMode mode )
+{
+    detach();
+
+    QFile& file = m_data->file;
+    file.setFileName( fileName );
+
+    const QIODevice::OpenMode openMode = ( mode == ReadOnly )
+        ? QIODevice::ReadOnly : QIODevice::ReadWrite;
+
+    if ( !file.open( openMode ) )
+    {
+        m_data->errorString = file.errorString();
+        return false;
+    }
+
+    const qint64 size = file.size();
+
+    uchar* memory = NULL;
+    if ( size >= qint64( sizeof( RingBufferHeader ) ) )
+        memory = file.map( 0, size );
+
+    if ( memory == NULL )
+    {
+        m_data->errorString = file.errorString();
+        file.close();
+
+        return false;
+    }
+
+    return initialize( memory, size, false, 0, 0, mode == ReadOnly );
+}
+
+bool QwtSharedRingBuffer::initialize( uchar* memory, qint64 memorySize,
+    bool isCreating, int recordSize, quint64 capacity, bool isReadOnly )
+{
+    RingBufferHeader* header = reinterpret_cast< RingBufferHeader* >( memory );
+
+    if ( isCreating )
+    {
+        std::memset( memory, 0, sizeof( RingBufferHeader ) );
+
+        header->magic = qwtRingBufferMagic;
+        header->version = qwtRingBufferVersion;
+        header->recordSize = quint32( recordSize );
+        header->capacity = capacity;
+        header->head = 0;
+        header->sequence.storeRelease( 0 );
+    }
+    else
+    {
+        bool ok = ( memorySize >= qint64( sizeof( RingBufferHeader ) ) )
+            && ( header->magic == qwtRingBufferMagic )
+            && ( header->version == qwtRingBufferVersion )
+            && ( header->recordSize > 0 ) && ( header->capacity > 0 )
+            && ( header->recordSize <= quint32( std::numeric_limits< int >::max() ) );
+
+        if ( ok )
+        {
+            const qint64 size = qwtRingBufferSize(
+                header->recordSize, header->capacity );
+
+            ok = ( size >= 0 ) && ( memorySize >= size );
+        }
+
+        if ( !ok )
+        {
+            m_data->errorString = QStringLiteral( "Invalid ring buffer header" );
+            detach();
+
+            return false;
+        }
+    }
+
+    m_data->header = header;
+    m_data->records = reinterpret_cast< double* >( memory + sizeof( RingBufferHeader ) );
+    m_data->isReadOnly = isReadOnly;
+    m_data->lastHead = 0;
+    m_data->errorString.clear();
+
+    m_records = m_data->records;
+    m_capacity = header->capacity;
+    m_recordSize = int( header->recordSize );
+
+    return true;
+}
+
+/*!
+   \brief Detach from the shared memory
+
+   The memory gets released, when the last process has detached from it.
+   Files will be closed, but not removed.
+ */
+void QwtSharedRingBuffer::detach()
+{
+    if ( m_data->sharedMemory.isAttached() )
+        m_data->sharedMemory.detach();
+
+    if ( m_data->file.isOpen() )
+        m_data->file.close();
+
+    m_data->header = NULL;
+    m_data->records = NULL;
+
+    m_records = NULL;
+    m_capacity = 0;
+    m_recordSize = 0;
+}
+
+//! \return True, when the buffer is attached to shared memory
+bool QwtSharedRingBuffer::isAttached() const
+{
+    return m_data->header != NULL;
+}
+
+//! \return Description of the last error
+QString QwtSharedRingBuffer::errorString() const
+{
+    return m_data->errorString;
+}
+
+/*!
+   \brief Number of records, that have been appended to the buffer
+
+   The value is read by the reader side of a sequence lock.
+   In the unlikely case, that the producer has been terminated
+   while updating the header, the last consistent value is returned.
+
+   \return Index of the record, that will be appended next
+   \sa append(), record()
+ */
+quint64 QwtSharedRingBuffer::head() const
+{
+    const RingBufferHeader* header = m_data->header;
+    if ( header == NULL )
+        return 0;
+
+    for ( int i = 0; i < 1000; i++ )
+    {
+        const quint32 sequence1 = header->sequence.loadAcquire();
+        if ( sequence1 & 1 )
+            continue;
+
+        const quint64 head = header->head;
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+
+        const quint32 sequence2 = header->sequence.loadAcquire();
+        if ( sequence1 == sequence2 )
+        {
+            m_data->lastHead = head;
+            break;
+        }
+    }
+
+    return m_data->lastHead;
+}
+
+/*!
+   \brief Append records
+
+   When numRecords exceeds the capacity only the most recent
+   records are written.
+
+   \param values numRecords * recordSize() values
+   \param numRecords Number of records
+
+   \note append() has no effect for buffers attached in ReadOnly mode
+   \sa head(), record()
+ */
+void QwtSharedRingBuffer::append( const double* values, int numRecords )
+{
+    RingBufferHeader* header = m_data->header;
+    if ( header == NULL || m_data->isReadOnly
+        || numRecords <= 0 || m_capacity == 0 )
+    {
+        return;
+    }
+
+    // only the producer modifies head, so we can read it without lock
+    quint64 head = header->head;
+
+    quint64 count = quint64( numRecords );
+    if ( count > m_capacity )
+    {
+        values += ( count - m_capacity ) * m_recordSize;
+        head += count - m_capacity;
+
+        count = m_capacity;
+    }
+
+    const quint64 slot = head % m_capacity;
+    const quint64 count1 = qMin( count, m_capacity - slot );
+
+    std::memcpy( m_data->records + slot * m_recordSize, values,
+        count1 * m_recordSize * sizeof( double ) );
+
+    if ( count1 < count )
+    {
+        std::memcpy( m_data->records, values + count1 * m_recordSize,
+            ( count - count1 ) * m_recordSize * sizeof( double ) );
+    }
+
+    const quint32 sequence = header->sequence.loadAcquire();
+
+    header->sequence.storeRelease( sequence + 1 );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    header->head = head + count;
+
+    header->sequence.storeRelease( sequence + 2 );
+}
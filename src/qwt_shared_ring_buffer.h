@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SHARED_RING_BUFFER_H
+#define QWT_SHARED_RING_BUFFER_H
+
+#include "qwt_global.h"
+
+class QString;
+
+/*!
+   \brief A ring buffer of samples in memory, that is shared between processes
+
+   QwtSharedRingBuffer organizes a block of shared memory as a ring buffer
+   of records, where each record consists of recordSize() doubles.
+   It is intended for passing samples from an acquisition process to
+   the GUI process without copying them: QwtSharedPointData and
+   QwtSharedRasterData read the samples directly from the mapped memory.
+
+   The memory is either a QSharedMemory segment identified by a key
+   or a file, that is mapped into memory. On Linux a POSIX shared memory
+   object created with shm_open( "/name", ... ) can be opened as
+   file "/dev/shm/name", so that a producer doesn't need to use Qt.
+
+   The memory starts with a header of 64 bytes ( in native byte order )
+   followed by capacity() records:
+
+   - offset 0: quint32 magic number ( 0x51777252 )
+   - offset 4: quint32 version ( 1 )
+   - offset 8: quint32 sequence number
+   - offset 12: quint32 number of doubles of a record
+   - offset 16: quint64 capacity ( number of records )
+   - offset 24: quint64 head ( number of records ever appended )
+
+   The record with index i is stored in slot ( i % capacity ).
+   A producer appends records by:
+
+   - writing the values of the new records to their slots
+   - incrementing the sequence number to an odd value
+   - updating head
+   - incrementing the sequence number to an even value
+
+   A reader takes a consistent snapshot of head by retrying as long as
+   the sequence number is odd or has changed while reading - see head().
+
+   As the producer never waits for the readers, the oldest records of
+   a snapshot might be overwritten while they are read. This is avoided
+   by reading a window of the capacity() - guard most recent records only,
+   where the guard needs to be larger than the number of records, that are
+   appended while the snapshot is in use ( f.e. during a replot ).
+
+   \note Only one producer is supported.
+   \sa QwtSharedPointData, QwtSharedRasterData
+ */
+class QWT_EXPORT QwtSharedRingBuffer
+{
+  public:
+    //! Access mode, when attaching to an existing buffer
+    enum AccessMode
+    {
+        //! The buffer is used for reading only
+        ReadOnly,
+
+        //! The buffer is used for reading and appending records
+        ReadWrite
+    };
+
+    QwtSharedRingBuffer();
+    ~QwtSharedRingBuffer();
+
+    bool create( const QString& key, int recordSize, quint64 capacity );
+    bool attach( const QString& key, AccessMode = ReadOnly );
+
+    bool createFile( const QString& fileName, int recordSize, quint64 capacity );
+    bool attachFile( const QString& fileName, AccessMode = ReadOnly );
+
+    void detach();
+    bool isAttached() const;
+
+    QString errorString() const;
+
+    int recordSize() const;
+    quint64 capacity() const;
+
+    quint64 head() const;
+
+    void append( const double* values, int numRecords = 1 );
+
+    const double* record( quint64 index ) const;
+
+  private:
+    Q_DISABLE_COPY( QwtSharedRingBuffer )
+
+    bool initialize( uchar* memory, qint64 memorySize, bool isCreating,
+        int recordSize, quint64 capacity, bool isReadOnly );
+
+    const double* m_records;
+    quint64 m_capacity;
+    int m_recordSize;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+//! \return Number of doubles of a record
+inline int QwtSharedRingBuffer::recordSize() const
+{
+    return m_recordSize;
+}
+
+//! \return Number of records, that can be stored in the buffer
+inline quint64 QwtSharedRingBuffer::capacity() const
+{
+    return m_capacity;
+}
+
+/*!
+   \brief Values of a record
+
+   The values are read directly from the shared memory. The index
+   counts all records, that have ever been appended.
+
+   \param index Index of the record
+   \return Pointer to the recordSize() values of the record,
+           or NULL, when the buffer is not attached
+   \sa head()
+ */
+inline const double* QwtSharedRingBuffer::record( quint64 index ) const
+{
+    if ( m_capacity == 0 )
+        return NULL;
+
+    return m_records + ( index % m_capacity ) * m_recordSize;
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include <qstyle.h>
 #include <qstyleoption.h>
 #include <qmargins.h>
+#include <qpixmap.h>
 
 static QSize qwtHandleSize( const QSize& size,
     Qt::Orientation orientation, bool hasTrough )
@@ -105,6 +106,9 @@ class QwtSlider::PrivateData
     int mouseOffset;
 
     mutable QSize sizeHintCache;
+
+    // background and scale
+    QPixmap pixmapCache;
 };
 /*!
    Construct vertical slider in QwtSlider::Trough style
@@ -677,16 +681,24 @@ void QwtSlider::paintEvent( QPaintEvent* event )
     QPainter painter( this );
     painter.setClipRegion( event->region() );
 
-    QStyleOption opt;
-    opt.initFrom(this);
-    style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
-
-    if ( m_data->scalePosition != QwtSlider::NoScale )
+    if ( m_data->pixmapCache.isNull() )
     {
-        if ( !m_data->sliderRect.contains( event->rect() ) )
-            scaleDraw()->draw( &painter, palette() );
+        m_data->pixmapCache = QwtPainter::backingStore( this, size() );
+        m_data->pixmapCache.fill( Qt::transparent );
+
+        QPainter p( &m_data->pixmapCache );
+        p.setFont( font() );
+
+        QStyleOption opt;
+        opt.initFrom(this);
+        style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
+
+        if ( m_data->scalePosition != QwtSlider::NoScale )
+            scaleDraw()->draw( &p, palette() );
     }
 
+    painter.drawPixmap( 0, 0, m_data->pixmapCache );
+
     drawSlider( &painter, m_data->sliderRect );
 
     if ( hasFocus() )
@@ -718,21 +730,61 @@ bool QwtSlider::event( QEvent* event )
 }
 
 /*!
-   Handles QEvent::StyleChange and QEvent::FontChange events
+   Handles QEvent::StyleChange, QEvent::FontChange and the events,
+   that invalidate the cache of the background and the scale
+
    \param event Change event
  */
 void QwtSlider::changeEvent( QEvent* event )
 {
-    if ( event->type() == QEvent::StyleChange ||
-        event->type() == QEvent::FontChange )
+    switch( event->type() )
     {
-        if ( testAttribute( Qt::WA_WState_Polished ) )
-            layoutSlider( true );
+        case QEvent::StyleChange:
+        case QEvent::FontChange:
+        {
+            invalidateCache();
+
+            if ( testAttribute( Qt::WA_WState_Polished ) )
+                layoutSlider( true );
+
+            break;
+        }
+        case QEvent::PaletteChange:
+        case QEvent::EnabledChange:
+        case QEvent::LocaleChange:
+        {
+            invalidateCache();
+            update();
+            break;
+        }
+        default:
+            break;
     }
 
     QwtAbstractSlider::changeEvent( event );
 }
 
+/*!
+   Repaint the slider rectangle only, as the background
+   and the scale don't depend on the value.
+ */
+void QwtSlider::sliderChange()
+{
+    update( m_data->sliderRect );
+}
+
+/*!
+   Invalidate the cache for the parts of the slider, that don't
+   depend on the value: background and scale.
+
+   \note The trough and the handle are painted by drawSlider()
+         for each update.
+ */
+void QwtSlider::invalidateCache()
+{
+    m_data->pixmapCache = QPixmap();
+}
+
 /*!
    Recalculate the slider's geometry and layout based on
    the current geometry and fonts.
@@ -742,6 +794,8 @@ void QwtSlider::changeEvent( QEvent* event )
  */
 void QwtSlider::layoutSlider( bool update_geometry )
 {
+    invalidateCache();
+
     int bw = 0;
     if ( m_data->hasTrough )
         bw = m_data->borderWidth;
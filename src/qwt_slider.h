@@ -115,6 +115,9 @@ class QWT_EXPORT QwtSlider : public QwtAbstractSlider
     virtual bool event( QEvent* ) QWT_OVERRIDE;
 
     virtual void scaleChange() QWT_OVERRIDE;
+    virtual void sliderChange() QWT_OVERRIDE;
+
+    void invalidateCache();
 
     QRect sliderRect() const;
     QRect handleRect() const;
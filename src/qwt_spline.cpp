@@ -436,6 +436,7 @@ class QwtSpline::PrivateData
   public:
     PrivateData()
         : boundaryType( QwtSpline::ConditionalBoundaries )
+        , threadCount( 0 )
     {
         parametrization = new QwtSplineParametrization(
             QwtSplineParametrization::ParameterChordal );
@@ -463,6 +464,8 @@ class QwtSpline::PrivateData
         double value;
 
     } boundaryConditions[2];
+
+    uint threadCount;
 };
 
 /*!
@@ -707,6 +710,34 @@ void QwtSpline::setBoundaryConditions(
     setBoundaryValue( QwtSpline::AtEnd, valueEnd );
 }
 
+/*!
+   \brief Set the number of threads, that are used for large polygons
+
+   Splines, that support concurrent calculations - like QwtSplineLocal
+   and QwtSplineCubic - split polygons with many points into chunks,
+   that are calculated in parallel. Small polygons are always calculated
+   in the calling thread.
+
+   The default setting is 0, what means the ideal thread count
+   of the system.
+
+   \param numThreads Number of threads, or 0 for QThread::idealThreadCount()
+   \sa threadCount()
+ */
+void QwtSpline::setThreadCount( uint numThreads )
+{
+    m_data->threadCount = numThreads;
+}
+
+/*!
+   \return Number of threads, that are used for large polygons
+   \sa setThreadCount()
+ */
+uint QwtSpline::threadCount() const
+{
+    return m_data->threadCount;
+}
+
 //! \brief Constructor
 QwtSplineInterpolating::QwtSplineInterpolating()
 {
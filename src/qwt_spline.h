@@ -172,6 +172,9 @@ class QWT_EXPORT QwtSpline
     void setBoundaryConditions( int condition,
         double valueBegin = 0.0, double valueEnd = 0.0 );
 
+    void setThreadCount( uint numThreads );
+    uint threadCount() const;
+
     virtual QPolygonF polygon( const QPolygonF&, double tolerance ) const;
     virtual QPainterPath painterPath( const QPolygonF& ) const = 0;
 
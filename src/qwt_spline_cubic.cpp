@@ -12,6 +12,16 @@
 
 #include <qpolygon.h>
 #include <qpainterpath.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+// minimum number of points, that is worth to be calculated in a thread
+static const int qwtMinPointsPerThread = 100000;
 
 #define SLOPES_INCREMENTAL 0
 #define KAHAN 0
@@ -387,12 +397,133 @@ static QDebug operator<<( QDebug debug, const QwtSplineCubicP::Equation3& eq )
 }
 #endif
 
+namespace QwtSplineCubicP
+{
+    /*
+       The equation system of a cubic spline is tridiagonal and diagonally
+       dominant. Substituting/resolving the equations reduces the influence
+       of an equation on its neighbours by a factor of at least 2 with each step.
+       So a partition can be calculated independently from the others,
+       when starting with an estimated equation, that is far enough away
+       to have no significant impact on the results of the partition.
+     */
+    static const int qwtSplineOverlap = 128;
+
+    template< class T >
+    class SolverCommand
+    {
+      public:
+        const QPointF* points;
+        int size;
+        Equation2* eq;
+        T* store;
+
+        double b1;  // b[1]
+        double* bn; // b[n - 3]
+    };
+
+    template< class T >
+    static void substituteRange( const SolverCommand< T >& command, int from, int to )
+    {
+        // eq[i] for i in [from, to]
+
+        const QPointF* p = command.points;
+        const int n = command.size;
+
+        const int start = qMin( to + qwtSplineOverlap, n - 4 );
+
+        Equation2 eq2;
+        double slope2;
+
+        if ( start == n - 4 )
+        {
+            eq2 = command.eq[n - 3];
+            slope2 = ( p[n - 3].y() - p[n - 4].y() ) / eq2.p;
+        }
+        else
+        {
+            // estimating eq[start + 1] from the unsubstituted spline equation
+
+            const double h1 = p[start + 1].x() - p[start].x();
+            const double h2 = p[start + 2].x() - p[start + 1].x();
+
+            slope2 = ( p[start + 1].y() - p[start].y() ) / h1;
+            const double slope3 = ( p[start + 2].y() - p[start + 1].y() ) / h2;
+
+            eq2.setup( h1, 2.0 * ( h1 + h2 ), 3.0 * ( slope3 - slope2 ) );
+        }
+
+        for ( int i = start; i >= from; i-- )
+        {
+            Equation2 eq1;
+
+            eq1.p = p[i].x() - p[i - 1].x();
+            const double slope1 = ( p[i].y() - p[i - 1].y() ) / eq1.p;
+
+            const double v = eq2.p / eq2.q;
+
+            eq1.q = 2.0 * ( eq1.p + eq2.p ) - v * eq2.p;
+            eq1.r = 3.0 * ( slope2 - slope1 ) - v * eq2.r;
+
+            if ( i <= to )
+                command.eq[i] = eq1;
+
+            eq2 = eq1;
+            slope2 = slope1;
+        }
+    }
+
+    template< class T >
+    static void resolveRange( const SolverCommand< T >& command, int from, int to )
+    {
+        // b[i] for i in [from, to]
+
+        const QPointF* p = command.points;
+        const Equation2* eq = command.eq;
+
+        const int start = qMax( from - qwtSplineOverlap, 2 );
+
+        double b1;
+        if ( start == 2 )
+        {
+            b1 = command.b1;
+        }
+        else
+        {
+            // estimating b[start - 1], ignoring b[start - 2]
+            b1 = eq[start - 1].r / eq[start - 1].q;
+        }
+
+        for ( int i = start; i <= to; i++ )
+        {
+            const double b2 = eq[i].resolved2( b1 );
+            if ( i >= from )
+                command.store->storeNext( i, eq[i].p, p[i - 1], p[i], b1, b2 );
+
+            b1 = b2;
+        }
+
+        if ( to == command.size - 3 )
+            *command.bn = b1;
+    }
+}
+
 namespace QwtSplineCubicP
 {
     template< class T >
     class EquationSystem
     {
       public:
+        EquationSystem():
+            m_numThreads( 1 )
+        {
+        }
+
+        void setThreadCount( uint numThreads )
+        {
+            m_numThreads = qMax( numThreads, 1u );
+        }
+
         void setStartCondition( double p, double q, double u, double r )
         {
             m_conditionsEQ[0].setup( p, q, u, r );
@@ -527,6 +658,14 @@ namespace QwtSplineCubicP
 
             // eq[i].resolved2( b[i-1] ) => b[i]
 
+            if ( m_numThreads > 1 )
+            {
+                const SolverCommand< T > command = solverCommand( points, 0.0, NULL );
+                concurrently( &substituteRange< T >, command, 2, n - 4 );
+
+                return m_eq[2];
+            }
+
             double slope2 = ( points[n - 3].y() - points[n - 4].y() ) / eq.p;
 
             for ( int i = n - 4; i > 1; i-- )
@@ -553,6 +692,16 @@ namespace QwtSplineCubicP
             const int n = points.size();
             const QPointF* p = points.constData();
 
+            if ( m_numThreads > 1 )
+            {
+                double bn = 0.0;
+
+                const SolverCommand< T > command = solverCommand( points, b1, &bn );
+                concurrently( &resolveRange< T >, command, 2, n - 3 );
+
+                return bn;
+            }
+
             for ( int i = 2; i < n - 2; i++ )
             {
                 // eq[i].resolved2( b[i-1] ) => b[i]
@@ -565,10 +714,52 @@ namespace QwtSplineCubicP
             return b1;
         }
 
+        SolverCommand< T > solverCommand(
+            const QPolygonF& points, double b1, double* bn )
+        {
+            SolverCommand< T > command;
+            command.points = points.constData();
+            command.size = points.size();
+            command.eq = m_eq.data();
+            command.store = &m_store;
+            command.b1 = b1;
+            command.bn = bn;
+
+            return command;
+        }
+
+        template< typename Function >
+        void concurrently( Function function,
+            const SolverCommand< T >& command, int from, int to )
+        {
+            const int numThreads = int( m_numThreads );
+            const int chunkSize = ( to - from + 1 ) / numThreads;
+
+#if QWT_USE_THREADS
+            QList< QFuture< void > > futures;
+            for ( int i = 0; i < numThreads - 1; i++ )
+            {
+                const int first = from + i * chunkSize;
+
+                futures += QtConcurrent::run( function,
+                    command, first, first + chunkSize - 1 );
+            }
+
+            function( command, from + ( numThreads - 1 ) * chunkSize, to );
+
+            for ( int i = 0; i < futures.size(); i++ )
+                futures[i].waitForFinished();
+#else
+            Q_UNUSED( chunkSize )
+            function( command, from, to );
+#endif
+        }
+
       private:
         Equation3 m_conditionsEQ[2];
         QVector< Equation2 > m_eq;
         T m_store;
+        uint m_numThreads;
     };
 
     template< class T >
@@ -955,6 +1146,23 @@ static void qwtSetupEndEquations(
     }
 }
 
+static uint qwtSplineThreadCount( const QwtSpline* spline, int numPoints )
+{
+#if QWT_USE_THREADS
+    int numThreads = int( spline->threadCount() );
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    numThreads = qMin( numThreads, numPoints / qwtMinPointsPerThread );
+    return uint( qMax( numThreads, 1 ) );
+#else
+    Q_UNUSED( spline )
+    Q_UNUSED( numPoints )
+
+    return 1;
+#endif
+}
+
 class QwtSplineCubic::PrivateData
 {
 };
@@ -1059,6 +1267,7 @@ QVector< double > QwtSplineCubic::slopes( const QPolygonF& points ) const
         points, eq );
 
     EquationSystem< SlopeStore > eqs;
+    eqs.setThreadCount( qwtSplineThreadCount( this, points.size() ) );
     eqs.setStartCondition( eq[0].p, eq[0].q, eq[0].u, eq[0].r );
     eqs.setEndCondition( eq[1].p, eq[1].q, eq[1].u, eq[1].r );
     eqs.resolve( points );
@@ -1109,6 +1318,7 @@ QVector< double > QwtSplineCubic::curvatures( const QPolygonF& points ) const
         points, eq );
 
     EquationSystem< CurvatureStore > eqs;
+    eqs.setThreadCount( qwtSplineThreadCount( this, points.size() ) );
     eqs.setStartCondition( eq[0].p, eq[0].q, eq[0].u, eq[0].r );
     eqs.setEndCondition( eq[1].p, eq[1].q, eq[1].u, eq[1].r );
     eqs.resolve( points );
@@ -12,6 +12,16 @@
 #include "qwt_spline_polynomial.h"
 
 #include <qpainterpath.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+// minimum number of points, that is worth to be calculated in a thread
+static const int qwtMinPointsPerThread = 50000;
 
 static inline bool qwtIsStrictlyMonotonic( double dy1, double dy2 )
 {
@@ -441,6 +451,193 @@ static inline SplineStore qwtSplineLocal(
     return store;
 }
 
+namespace QwtSplineLocalP
+{
+    /*
+        Without the serial dependencies of the loops above the slope
+        at a point can be calculated from its neighbours only.
+        This allows calculating the slopes in independent chunks and
+        gives the compiler a better chance for vectorizing the loops.
+     */
+
+    template< class Slope >
+    struct slopeAtL1
+    {
+        static inline double value( const QPointF* p, int, int k )
+        {
+            return qwtSlopeP3< Slope >( p[k - 1], p[k], p[k + 1] );
+        }
+    };
+
+    struct slopeAtAkima
+    {
+        static inline double value( const QPointF* p, int n, int k )
+        {
+            const double s2 = qwtSlopeLine( p[k - 1], p[k] );
+            const double s3 = qwtSlopeLine( p[k], p[k + 1] );
+
+            const double s1 = ( k >= 2 ) ? qwtSlopeLine( p[k - 2], p[k - 1] ) : 0.5 * s2;
+            const double s4 = ( k + 2 < n ) ? qwtSlopeLine( p[k + 1], p[k + 2] ) : 0.5 * s3;
+
+            return qwtSlopeAkima( s1, s2, s3, s4 );
+        }
+    };
+
+    // Helper class to work around the 5 parameters
+    // limitation of QtConcurrent::run()
+    class RangeCommand
+    {
+      public:
+        const QPointF* points;
+        int size;
+
+        double slopeBegin;
+        double slopeEnd;
+
+        QLineF* lines;
+        double* slopes;
+    };
+}
+
+template< class SlopeAt >
+static void qwtSplineLocalRange(
+    const QwtSplineLocalP::RangeCommand& command, int from, int to )
+{
+    // calculating the segments [from, to[
+
+    const QPointF* p = command.points;
+    const int n = command.size;
+
+    double m1 = ( from == 0 ) ? command.slopeBegin : SlopeAt::value( p, n, from );
+
+    for ( int i = from; i < to; i++ )
+    {
+        const int k = i + 1;
+        const double m2 = ( k == n - 1 ) ? command.slopeEnd : SlopeAt::value( p, n, k );
+
+        if ( command.slopes )
+            command.slopes[i] = m1;
+
+        if ( command.lines )
+        {
+            const double dx3 = ( p[k].x() - p[i].x() ) / 3.0;
+
+            command.lines[i].setLine( p[i].x() + dx3, p[i].y() + m1 * dx3,
+                p[k].x() - dx3, p[k].y() - m2 * dx3 );
+        }
+
+        m1 = m2;
+    }
+
+    if ( command.slopes && to == n - 1 )
+        command.slopes[n - 1] = command.slopeEnd;
+}
+
+template< class SlopeAt >
+static void qwtSplineLocalConcurrent(
+    const QwtSplineLocalP::RangeCommand& command, uint numThreads )
+{
+    const int numSegments = command.size - 1;
+
+#if QWT_USE_THREADS
+    const int chunkSize = numSegments / int( numThreads );
+
+    QList< QFuture< void > > futures;
+    for ( uint i = 0; i < numThreads; i++ )
+    {
+        const int from = i * chunkSize;
+
+        if ( i == numThreads - 1 )
+        {
+            qwtSplineLocalRange< SlopeAt >( command, from, numSegments );
+        }
+        else
+        {
+            futures += QtConcurrent::run( &qwtSplineLocalRange< SlopeAt >,
+                command, from, from + chunkSize );
+        }
+    }
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    Q_UNUSED( numThreads )
+    qwtSplineLocalRange< SlopeAt >( command, 0, numSegments );
+#endif
+}
+
+static uint qwtSplineThreadCount( const QwtSpline* spline, int numPoints )
+{
+#if QWT_USE_THREADS
+    int numThreads = int( spline->threadCount() );
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    numThreads = qMin( numThreads, numPoints / qwtMinPointsPerThread );
+    return uint( qMax( numThreads, 1 ) );
+#else
+    Q_UNUSED( spline )
+    Q_UNUSED( numPoints )
+
+    return 1;
+#endif
+}
+
+/*
+    Calculating the Bezier control lines and/or the slopes
+    of a polygon with more than 2 points in concurrent threads
+ */
+static void qwtSplineLocalConcurrent( const QwtSplineLocal* spline,
+    const QPolygonF& points, QLineF* lines, double* slopes, uint numThreads )
+{
+    using namespace QwtSplineLocalP;
+
+    RangeCommand command;
+    command.points = points.constData();
+    command.size = points.size();
+    command.lines = lines;
+    command.slopes = slopes;
+
+    switch( spline->type() )
+    {
+        case QwtSplineLocal::Cardinal:
+        {
+            qwtSplineBoundariesL1< slopeCardinal >(
+                spline, points, command.slopeBegin, command.slopeEnd );
+
+            qwtSplineLocalConcurrent< slopeAtL1< slopeCardinal > >( command, numThreads );
+            break;
+        }
+        case QwtSplineLocal::ParabolicBlending:
+        {
+            qwtSplineBoundariesL1< slopeParabolicBlending >(
+                spline, points, command.slopeBegin, command.slopeEnd );
+
+            qwtSplineLocalConcurrent< slopeAtL1< slopeParabolicBlending > >(
+                command, numThreads );
+            break;
+        }
+        case QwtSplineLocal::PChip:
+        {
+            qwtSplineBoundariesL1< slopePChip >(
+                spline, points, command.slopeBegin, command.slopeEnd );
+
+            qwtSplineLocalConcurrent< slopeAtL1< slopePChip > >( command, numThreads );
+            break;
+        }
+        case QwtSplineLocal::Akima:
+        {
+            qwtSplineAkimaBoundaries(
+                spline, points, command.slopeBegin, command.slopeEnd );
+
+            qwtSplineLocalConcurrent< slopeAtAkima >( command, numThreads );
+            break;
+        }
+        default:
+            break;
+    }
+}
+
 /*!
    \brief Constructor
 
@@ -483,6 +680,12 @@ QPainterPath QwtSplineLocal::painterPath( const QPolygonF& points ) const
 {
     if ( parametrization()->type() == QwtSplineParametrization::ParameterX )
     {
+        if ( qwtSplineThreadCount( this, points.size() ) > 1 )
+        {
+            // calculating the control lines concurrently
+            return QwtSplineInterpolating::painterPath( points );
+        }
+
         using namespace QwtSplineLocalP;
         return qwtSplineLocal< PathStore >( this, points).path;
     }
@@ -503,6 +706,15 @@ QVector< QLineF > QwtSplineLocal::bezierControlLines( const QPolygonF& points )
 {
     if ( parametrization()->type() == QwtSplineParametrization::ParameterX )
     {
+        const uint numThreads = qwtSplineThreadCount( this, points.size() );
+        if ( numThreads > 1 )
+        {
+            QVector< QLineF > lines( points.size() - 1 );
+            qwtSplineLocalConcurrent( this, points, lines.data(), NULL, numThreads );
+
+            return lines;
+        }
+
         using namespace QwtSplineLocalP;
         return qwtSplineLocal< ControlPointsStore >( this, points ).controlPoints;
     }
@@ -520,6 +732,15 @@ QVector< QLineF > QwtSplineLocal::bezierControlLines( const QPolygonF& points )
  */
 QVector< double > QwtSplineLocal::slopes( const QPolygonF& points ) const
 {
+    const uint numThreads = qwtSplineThreadCount( this, points.size() );
+    if ( numThreads > 1 )
+    {
+        QVector< double > m( points.size() );
+        qwtSplineLocalConcurrent( this, points, NULL, m.data(), numThreads );
+
+        return m;
+    }
+
     using namespace QwtSplineLocalP;
     return qwtSplineLocal< SlopeStore >( this, points ).slopes;
 }
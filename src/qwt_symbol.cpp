@@ -160,6 +160,22 @@ static inline void qwtDrawGraphicSymbols( QPainter* painter,
     if ( symbol.isPinPointEnabled() )
         pinPoint = symbol.pinPoint();
 
+    /*
+        Each point has its own translation, so the raster cache of
+        the graphic would miss for most of them. The symbol has its
+        own cache for a symbol, that is painted many times.
+     */
+    const QwtGraphic* g = &graphic;
+
+    QwtGraphic uncached;
+    if ( graphic.cachePolicy() != QwtGraphic::NoCache )
+    {
+        uncached = graphic;
+        uncached.setCachePolicy( QwtGraphic::NoCache );
+
+        g = &uncached;
+    }
+
     const QTransform transform = painter->transform();
 
     for ( int i = 0; i < numPoints; i++ )
@@ -171,7 +187,7 @@ static inline void qwtDrawGraphicSymbols( QPainter* painter,
 
         painter->setTransform( tr );
 
-        graphic.render( painter );
+        g->render( painter );
     }
 
     painter->setTransform( transform );
@@ -822,6 +838,7 @@ class QwtSymbol::PrivateData
     struct SVG
     {
         QSvgRenderer* renderer;
+        QByteArray document;
     } svg;
 #endif
 
@@ -888,6 +905,56 @@ QwtSymbol::~QwtSymbol()
     delete m_data;
 }
 
+/*!
+   \brief Create a copy of the symbol, that can be used in another thread
+
+   The cache policy of the copy is NoCache, as pixmaps
+   can't be used safely outside of the GUI thread on all platforms.
+   For the same reason symbols with a pixmap - style Pixmap or a
+   graphic with raster data - can't be copied.
+
+   \return Copy of the symbol, that has to be deleted by the caller,
+           or NULL, when the symbol can't be used in another thread
+   \note Subclasses, that reimplement renderSymbols() or boundingRect(),
+         need to reimplement snapshot() as well.
+   \sa QwtPlotItem::snapshot()
+ */
+QwtSymbol* QwtSymbol::snapshot() const
+{
+    if ( m_data->style == QwtSymbol::Pixmap )
+        return NULL;
+
+    if ( m_data->style == QwtSymbol::Graphic
+        && ( m_data->graphic.graphic.commandTypes() & QwtGraphic::RasterData ) )
+    {
+        return NULL;
+    }
+
+    QwtSymbol* symbol = new QwtSymbol( m_data->style,
+        m_data->brush, m_data->pen, m_data->size );
+
+    PrivateData* d = symbol->m_data;
+
+    d->isPinPointEnabled = m_data->isPinPointEnabled;
+    d->pinPoint = m_data->pinPoint;
+
+    d->path.path = m_data->path.path;
+    d->path.graphic = m_data->path.graphic;
+    d->graphic.graphic = m_data->graphic.graphic;
+
+#ifndef QWT_NO_SVG
+    if ( m_data->svg.renderer )
+    {
+        symbol->setSvgDocument( m_data->svg.document );
+        d->style = m_data->style;
+    }
+#endif
+
+    d->cache.policy = QwtSymbol::NoCache;
+
+    return symbol;
+}
+
 /*!
    Change the cache policy
 
@@ -1048,6 +1115,7 @@ void QwtSymbol::setSvgDocument( const QByteArray& svgDocument )
         m_data->svg.renderer = new QSvgRenderer();
 
     m_data->svg.renderer->load( svgDocument );
+    m_data->svg.document = svgDocument;
 }
 
 #endif
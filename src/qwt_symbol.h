@@ -218,6 +218,8 @@ class QWT_EXPORT QwtSymbol
     virtual QRect boundingRect() const;
     void invalidateCache();
 
+    virtual QwtSymbol* snapshot() const;
+
   protected:
     virtual void renderSymbols( QPainter*,
         const QPointF*, int numPoints ) const;
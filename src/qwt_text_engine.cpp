@@ -11,9 +11,9 @@
 #include "qwt_painter.h"
 
 #include <qpainter.h>
-#include <qpixmap.h>
 #include <qimage.h>
 #include <qmap.h>
+#include <qmutex.h>
 #include <qwidget.h>
 #include <qtextobject.h>
 #include <qtextdocument.h>
@@ -87,6 +87,9 @@ class QwtPlainTextEngine::PrivateData
     {
         const QString fontKey = font.key();
 
+        // text might be rendered from worker threads, see QwtPlotSnapshot
+        const QMutexLocker locker( &m_mutex );
+
         QMap< QString, int >::const_iterator it =
             m_ascentCache.constFind( fontKey );
 
@@ -107,23 +110,23 @@ class QwtPlainTextEngine::PrivateData
 
         const QFontMetrics fm( font );
 
-        QPixmap pm( QwtPainter::horizontalAdvance( fm, dummy ), fm.height() );
-        pm.fill( white );
+        // QImage instead of QPixmap, as pixmaps are limited to the GUI thread
+        QImage img( QwtPainter::horizontalAdvance( fm, dummy ),
+            fm.height(), QImage::Format_RGB32 );
+        img.fill( white );
 
-        QPainter p( &pm );
+        QPainter p( &img );
         p.setFont( font );
-        p.drawText( 0, 0,  pm.width(), pm.height(), 0, dummy );
+        p.drawText( 0, 0,  img.width(), img.height(), 0, dummy );
         p.end();
 
-        const QImage img = pm.toImage();
-
         int row = 0;
         for ( row = 0; row < img.height(); row++ )
         {
             const QRgb* line = reinterpret_cast< const QRgb* >(
                 img.scanLine( row ) );
 
-            const int w = pm.width();
+            const int w = img.width();
             for ( int col = 0; col < w; col++ )
             {
                 if ( line[col] != white.rgb() )
@@ -135,6 +138,7 @@ class QwtPlainTextEngine::PrivateData
     }
 
     mutable QMap< QString, int > m_ascentCache;
+    mutable QMutex m_mutex;
 };
 
 //! Constructor
@@ -12,8 +12,10 @@
 #include "qwt_scale_map.h"
 #include "qwt_color_map.h"
 #include "qwt_math.h"
+#include "qwt_painter.h"
 
 #include <qpainter.h>
+#include <qpixmap.h>
 #include <qevent.h>
 #include <qdrawutil.h>
 #include <qstyle.h>
@@ -112,6 +114,9 @@ class QwtThermo::PrivateData
     QwtColorMap* colorMap;
 
     double value;
+
+    // everything beside the liquid
+    QPixmap pixmapCache;
 };
 
 /*!
@@ -159,6 +164,8 @@ void QwtThermo::setRangeFlags( QwtInterval::BorderFlags flags )
     if ( m_data->rangeFlags != flags )
     {
         m_data->rangeFlags = flags;
+
+        invalidateCache();
         update();
     }
 }
@@ -183,7 +190,9 @@ void QwtThermo::setValue( double value )
     if ( m_data->value != value )
     {
         m_data->value = value;
-        update();
+
+        // the scale and the borders are restored from the cache
+        update( pipeRect() );
     }
 }
 
@@ -237,29 +246,46 @@ void QwtThermo::paintEvent( QPaintEvent* event )
     QPainter painter( this );
     painter.setClipRegion( event->region() );
 
-    QStyleOption opt;
-    opt.initFrom(this);
-    style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
-
     const QRect tRect = pipeRect();
 
-    if ( !tRect.contains( event->rect() ) )
+    if ( m_data->pixmapCache.isNull() )
     {
+        m_data->pixmapCache = QwtPainter::backingStore( this, size() );
+        m_data->pixmapCache.fill( Qt::transparent );
+
+        QPainter p( &m_data->pixmapCache );
+        p.setFont( font() );
+
+        QStyleOption opt;
+        opt.initFrom(this);
+        style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
+
         if ( m_data->scalePosition != QwtThermo::NoScale )
-            scaleDraw()->draw( &painter, palette() );
-    }
+            scaleDraw()->draw( &p, palette() );
 
-    const int bw = m_data->borderWidth;
+        const int bw = m_data->borderWidth;
+
+        const QBrush brush = palette().brush( QPalette::Base );
+        qDrawShadePanel( &p,
+            tRect.adjusted( -bw, -bw, bw, bw ),
+            palette(), true, bw,
+            m_data->autoFillPipe ? &brush : NULL );
+    }
 
-    const QBrush brush = palette().brush( QPalette::Base );
-    qDrawShadePanel( &painter,
-        tRect.adjusted( -bw, -bw, bw, bw ),
-        palette(), true, bw,
-        m_data->autoFillPipe ? &brush : NULL );
+    painter.drawPixmap( 0, 0, m_data->pixmapCache );
 
     drawLiquid( &painter, tRect );
 }
 
+/*!
+   Invalidate the cache for the parts of the thermometer,
+   that don't depend on the value: background, scale and borders.
+ */
+void QwtThermo::invalidateCache()
+{
+    m_data->pixmapCache = QPixmap();
+}
+
 /*!
    Resize event handler
    \param event Resize event
@@ -284,9 +310,19 @@ void QwtThermo::changeEvent( QEvent* event )
             layoutThermo( true );
             break;
         }
+        case QEvent::PaletteChange:
+        case QEvent::EnabledChange:
+        case QEvent::LocaleChange:
+        {
+            invalidateCache();
+            update();
+            break;
+        }
         default:
             break;
     }
+
+    QwtAbstractScale::changeEvent( event );
 }
 
 /*!
@@ -298,6 +334,8 @@ void QwtThermo::changeEvent( QEvent* event )
  */
 void QwtThermo::layoutThermo( bool update_geometry )
 {
+    invalidateCache();
+
     const QRect tRect = pipeRect();
     const int bw = m_data->borderWidth + m_data->spacing;
     const bool inverted = ( upperBound() < lowerBound() );
@@ -162,6 +162,8 @@ class QWT_EXPORT QwtThermo : public QwtAbstractScale
     virtual void resizeEvent( QResizeEvent* ) QWT_OVERRIDE;
     virtual void changeEvent( QEvent* ) QWT_OVERRIDE;
 
+    void invalidateCache();
+
     QwtScaleDraw* scaleDraw();
 
     QRect pipeRect() const;
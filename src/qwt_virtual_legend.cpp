@@ -0,0 +1,1279 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_virtual_legend.h"
+#include "qwt_plot_item.h"
+#include "qwt_graphic.h"
+#include "qwt_painter.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+#include "qwt.h"
+
+#include <qapplication.h>
+#include <qabstractscrollarea.h>
+#include <qscrollbar.h>
+#include <qlayout.h>
+#include <qpainter.h>
+#include <qpixmap.h>
+#include <qstyle.h>
+#include <qstyleoption.h>
+#include <qdrawutil.h>
+#include <qevent.h>
+#include <qmargins.h>
+#include <qhash.h>
+
+#include <algorithm>
+
+static const int ButtonFrame = 2;
+static const int Margin = 2;
+static const int Spacing = 2;
+
+namespace
+{
+    class LegendEntry
+    {
+      public:
+        LegendEntry()
+            : mode( QwtLegendData::ReadOnly )
+            , isDown( false )
+        {
+        }
+
+        QwtLegendData data;
+        QwtLegendData::Mode mode;
+        QSize size;
+        bool isDown;
+
+        // rendered, when the entry becomes visible
+        QPixmap icon;
+    };
+
+    class LegendItem
+    {
+      public:
+        LegendItem()
+            : plotItem( NULL )
+        {
+        }
+
+        QVariant itemInfo;
+        QVector< LegendEntry > entries;
+
+        // the plot item, when itemInfo has been created by QwtPlot::itemToInfo()
+        const QwtPlotItem* plotItem;
+    };
+}
+
+static inline const QwtPlotItem* qwtPlotItem( const QVariant& itemInfo )
+{
+    if ( itemInfo.userType() == qMetaTypeId< QwtPlotItem* >() )
+        return qvariant_cast< QwtPlotItem* >( itemInfo );
+
+    return NULL;
+}
+
+static QSize qwtButtonShift( const QWidget* w )
+{
+    QStyleOption option;
+    option.initFrom( w );
+
+    const int ph = w->style()->pixelMetric(
+        QStyle::PM_ButtonShiftHorizontal, &option, w );
+    const int pv = w->style()->pixelMetric(
+        QStyle::PM_ButtonShiftVertical, &option, w );
+    return QSize( ph, pv );
+}
+
+static inline int qwtEntryMargin( const LegendEntry& entry )
+{
+    int margin = Margin;
+    if ( entry.mode != QwtLegendData::ReadOnly )
+        margin += ButtonFrame;
+
+    return margin;
+}
+
+static inline QwtText qwtEntryTitle( const LegendEntry& entry )
+{
+    QwtText title = entry.data.title();
+    title.setRenderFlags( Qt::AlignLeft | Qt::AlignVCenter | Qt::TextExpandTabs );
+
+    return title;
+}
+
+static QSize qwtEntrySize( const QWidget* widget, const LegendEntry& entry )
+{
+    const QSizeF textSize = qwtEntryTitle( entry ).textSize( widget->font() );
+    const QSizeF iconSize = entry.data.icon().defaultSize();
+
+    const int margin = qwtEntryMargin( entry );
+
+    int w = 2 * margin + qwtCeil( textSize.width() );
+    if ( !iconSize.isEmpty() )
+        w += qwtCeil( iconSize.width() ) + Margin;
+
+    int h = qMax( qwtCeil( textSize.height() ), qwtCeil( iconSize.height() ) + 4 );
+    h += 2 * margin;
+
+    QSize sz( w, h );
+    if ( entry.mode != QwtLegendData::ReadOnly )
+    {
+        sz += qwtButtonShift( widget );
+        sz = qwtExpandedToGlobalStrut( sz );
+    }
+
+    return sz;
+}
+
+static void qwtDrawEntry( QPainter* painter, const QWidget* widget,
+    const LegendEntry& entry, const QRect& rect, bool isDown,
+    bool hasFocus, const QPixmap* icon )
+{
+    painter->save();
+    painter->setClipRect( rect, Qt::IntersectClip );
+
+    if ( hasFocus )
+    {
+        QStyleOptionFocusRect option;
+        option.initFrom( widget );
+        option.rect = rect;
+
+        widget->style()->drawPrimitive(
+            QStyle::PE_FrameFocusRect, &option, painter, widget );
+    }
+
+    if ( isDown )
+    {
+        qDrawWinButton( painter, rect.x(), rect.y(),
+            rect.width(), rect.height(), widget->palette(), true );
+
+        const QSize shift = qwtButtonShift( widget );
+        painter->translate( shift.width(), shift.height() );
+    }
+
+    const int margin = qwtEntryMargin( entry );
+    const QRect cr = rect.adjusted( margin, margin, -margin, -margin );
+
+    int x = cr.left();
+
+    const QwtGraphic& graphic = entry.data.icon();
+    if ( !graphic.isNull() )
+    {
+        const QSizeF sz = graphic.defaultSize();
+
+        const QRectF iconRect( x, cr.center().y() - 0.5 * sz.height(),
+            sz.width(), sz.height() );
+
+        if ( icon && !icon->isNull() )
+            painter->drawPixmap( iconRect.topLeft(), *icon );
+        else
+            graphic.render( painter, iconRect, Qt::KeepAspectRatio );
+
+        x = qwtCeil( iconRect.right() ) + Margin;
+    }
+
+    const QRect titleRect( x, cr.top(), cr.right() - x + 1, cr.height() );
+
+    painter->setPen( widget->palette().color( QPalette::Text ) );
+    qwtEntryTitle( entry ).draw( painter, titleRect );
+
+    painter->restore();
+}
+
+class QwtVirtualLegend::PrivateData
+{
+  public:
+    PrivateData()
+        : itemMode( QwtLegendData::ReadOnly )
+        , maxColumns( 0 )
+        , view( NULL )
+        , pressedEntry( -1 )
+        , currentEntry( -1 )
+        , lastItem( -1 )
+        , numRemoved( 0 )
+        , isDirty( false )
+        , numEntries( 0 )
+        , hintNumEntries( 0 )
+    {
+    }
+
+    int findItem( const QVariant& itemInfo ) const
+    {
+        if ( !itemInfo.isValid() )
+            return -1;
+
+        const QwtPlotItem* plotItem = qwtPlotItem( itemInfo );
+        if ( plotItem )
+            return itemIndexes.value( plotItem, -1 );
+
+        /*
+           QwtPlot updates its items in the order of the item list.
+           Starting the search behind the previous match finds
+           the item with the first comparison in most cases.
+         */
+
+        const int count = items.size();
+        for ( int i = 0; i < count; i++ )
+        {
+            const int index = ( lastItem + 1 + i ) % count;
+            if ( items[index].itemInfo == itemInfo )
+            {
+                lastItem = index;
+                return index;
+            }
+        }
+
+        return -1;
+    }
+
+    int appendItem( const QVariant& itemInfo )
+    {
+        LegendItem item;
+        item.itemInfo = itemInfo;
+        item.plotItem = qwtPlotItem( itemInfo );
+
+        items += item;
+
+        const int index = items.size() - 1;
+
+        if ( item.plotItem )
+            itemIndexes.insert( item.plotItem, index );
+
+        if ( !isDirty )
+            offsets += numEntries;
+
+        lastItem = index;
+        return index;
+    }
+
+    /*
+       A removed item is replaced by an empty one, so that the indexes
+       of the following items remain valid. The empty items are
+       dropped in compactItems(), that runs once for many removals.
+     */
+    void removeItem( int index )
+    {
+        LegendItem& item = items[index];
+
+        if ( item.plotItem )
+            itemIndexes.remove( item.plotItem );
+
+        item = LegendItem();
+        numRemoved++;
+
+        isDirty = true;
+    }
+
+    void compactItems()
+    {
+        if ( numRemoved == 0 )
+            return;
+
+        int count = 0;
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            if ( items[i].entries.isEmpty() )
+                continue;
+
+            if ( count != i )
+                items[count] = items[i];
+
+            if ( items[count].plotItem )
+                itemIndexes[ items[count].plotItem ] = count;
+
+            count++;
+        }
+
+        items.resize( count );
+
+        numRemoved = 0;
+        lastItem = -1;
+        isDirty = true;
+    }
+
+    bool hasItems() const
+    {
+        return items.size() > numRemoved;
+    }
+
+    // the indexes of the entries are about to change
+    void resetPressedEntry()
+    {
+        if ( pressedEntry < 0 )
+            return;
+
+        LegendEntry* pressed = entry( pressedEntry );
+        if ( pressed && pressed->mode == QwtLegendData::Clickable )
+            pressed->isDown = false;
+
+        updateEntry( pressedEntry );
+        pressedEntry = -1;
+    }
+
+    /*
+       Adjust the layout to the modified entries of an item. Appending
+       entries to the last item or growing entries are handled
+       incrementally, anything else recalculates the layout, when
+       it is needed the next time.
+     */
+    void updateOffsets( int itemIndex, int oldCount, bool isShrunk )
+    {
+        if ( isDirty )
+            return;
+
+        const QVector< LegendEntry >& entries = items[itemIndex].entries;
+
+        if ( isShrunk || entries.size() < oldCount
+            || ( entries.size() != oldCount && itemIndex != items.size() - 1 ) )
+        {
+            isDirty = true;
+            return;
+        }
+
+        numEntries += entries.size() - oldCount;
+
+        for ( int i = 0; i < entries.size(); i++ )
+            cellSize = cellSize.expandedTo( entries[i].size );
+    }
+
+    void updateLayout() const
+    {
+        if ( !isDirty )
+            return;
+
+        offsets.resize( items.size() );
+
+        numEntries = 0;
+        cellSize = QSize( 0, 0 );
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            offsets[i] = numEntries;
+
+            const QVector< LegendEntry >& entries = items[i].entries;
+            for ( int j = 0; j < entries.size(); j++ )
+                cellSize = cellSize.expandedTo( entries[j].size );
+
+            numEntries += entries.size();
+        }
+
+        isDirty = false;
+    }
+
+    bool locate( int index, int& itemIndex, int& entryIndex ) const
+    {
+        updateLayout();
+
+        if ( index < 0 || index >= numEntries )
+            return false;
+
+        const QVector< int >::const_iterator it = std::upper_bound(
+            offsets.constBegin(), offsets.constEnd(), index );
+
+        itemIndex = int( it - offsets.constBegin() ) - 1;
+        entryIndex = index - offsets[itemIndex];
+
+        return true;
+    }
+
+    LegendEntry* entry( int index )
+    {
+        int itemIndex, entryIndex;
+        if ( !locate( index, itemIndex, entryIndex ) )
+            return NULL;
+
+        return &items[itemIndex].entries[entryIndex];
+    }
+
+    int numColumns( int width ) const
+    {
+        updateLayout();
+
+        if ( numEntries == 0 )
+            return 0;
+
+        int numCols = ( width + Spacing ) / ( cellSize.width() + Spacing );
+        if ( maxColumns > 0 )
+            numCols = qMin( numCols, int( maxColumns ) );
+
+        return qBound( 1, numCols, numEntries );
+    }
+
+    QSize contentsSize( int numCols ) const
+    {
+        updateLayout();
+
+        if ( numCols <= 0 || numEntries == 0 )
+            return QSize( 0, 0 );
+
+        const int numRows = ( numEntries + numCols - 1 ) / numCols;
+
+        return QSize( numCols * ( cellSize.width() + Spacing ) - Spacing,
+            numRows * ( cellSize.height() + Spacing ) - Spacing );
+    }
+
+    QRect cellRect( int index, int numCols, const QPoint& origin ) const
+    {
+        const int row = index / numCols;
+        const int col = index % numCols;
+
+        return QRect( origin.x() + col * ( cellSize.width() + Spacing ),
+            origin.y() + row * ( cellSize.height() + Spacing ),
+            cellSize.width(), cellSize.height() );
+    }
+
+    QPoint contentsOrigin( int width, int numCols ) const
+    {
+        const QSize sz = contentsSize( numCols );
+
+        // centered horizontally like QwtLegend
+
+        int x = -view->horizontalScrollBar()->value();
+        if ( sz.width() < width )
+            x = ( width - sz.width() ) / 2;
+
+        return QPoint( x, -view->verticalScrollBar()->value() );
+    }
+
+    int entryAt( const QPoint& pos ) const
+    {
+        const int width = view->viewport()->width();
+
+        const int numCols = numColumns( width );
+        if ( numCols <= 0 )
+            return -1;
+
+        const QPoint origin = contentsOrigin( width, numCols );
+
+        const int x = pos.x() - origin.x();
+        const int y = pos.y() - origin.y();
+        if ( x < 0 || y < 0 )
+            return -1;
+
+        const int col = x / ( cellSize.width() + Spacing );
+        const int row = y / ( cellSize.height() + Spacing );
+        if ( col >= numCols )
+            return -1;
+
+        const int index = row * numCols + col;
+        if ( index >= numEntries || !cellRect( index, numCols, origin ).contains( pos ) )
+            return -1;
+
+        return index;
+    }
+
+    void updateEntry( int index ) const
+    {
+        QWidget* viewport = view->viewport();
+
+        const int numCols = numColumns( viewport->width() );
+        if ( index >= 0 && index < numEntries && numCols > 0 )
+        {
+            const QPoint origin = contentsOrigin( viewport->width(), numCols );
+            viewport->update( cellRect( index, numCols, origin ) );
+        }
+    }
+
+    void updateScrollBars() const
+    {
+        const QSize viewportSize = view->viewport()->size();
+        const QSize sz = contentsSize( numColumns( viewportSize.width() ) );
+
+        QScrollBar* vScrollBar = view->verticalScrollBar();
+        vScrollBar->setRange( 0, qMax( sz.height() - viewportSize.height(), 0 ) );
+        vScrollBar->setPageStep( viewportSize.height() );
+        vScrollBar->setSingleStep( cellSize.height() + Spacing );
+
+        QScrollBar* hScrollBar = view->horizontalScrollBar();
+        hScrollBar->setRange( 0, qMax( sz.width() - viewportSize.width(), 0 ) );
+        hScrollBar->setPageStep( viewportSize.width() );
+        hScrollBar->setSingleStep( cellSize.width() + Spacing );
+    }
+
+    QwtLegendData::Mode itemMode;
+    uint maxColumns;
+
+    QVector< LegendItem > items;
+    QHash< const QwtPlotItem*, int > itemIndexes;
+
+    QAbstractScrollArea* view;
+
+    int pressedEntry;
+    int currentEntry;
+
+    mutable int lastItem;
+    int numRemoved;
+
+    mutable bool isDirty;
+    mutable QVector< int > offsets;
+    mutable int numEntries;
+    mutable QSize cellSize;
+
+    // the layout, that has been announced by updateGeometry()
+    int hintNumEntries;
+    QSize hintCellSize;
+};
+
+/*!
+   Constructor
+   \param parent Parent widget
+ */
+QwtVirtualLegend::QwtVirtualLegend( QWidget* parent )
+    : QwtAbstractLegend( parent )
+{
+    setFrameStyle( NoFrame );
+
+    m_data = new PrivateData;
+
+    QAbstractScrollArea* view = new QAbstractScrollArea( this );
+    view->setObjectName( "QwtVirtualLegendView" );
+    view->setFrameStyle( NoFrame );
+    view->setFocusPolicy( Qt::NoFocus );
+    view->installEventFilter( this );
+
+    QWidget* viewport = view->viewport();
+    viewport->setObjectName( "QwtLegendViewport" );
+    viewport->setAutoFillBackground( false );
+    viewport->installEventFilter( this );
+
+    m_data->view = view;
+
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    layout->addWidget( view );
+}
+
+//! Destructor
+QwtVirtualLegend::~QwtVirtualLegend()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the maximum number of entries in a row
+
+   F.e when the maximum is set to 1 all entries are aligned
+   vertically. 0 means unlimited
+
+   \param numColums Maximum number of entries in a row
+   \sa maxColumns(), QwtLegend::setMaxColumns()
+ */
+void QwtVirtualLegend::setMaxColumns( uint numColums )
+{
+    if ( numColums != m_data->maxColumns )
+    {
+        m_data->maxColumns = numColums;
+
+        m_data->updateScrollBars();
+        m_data->view->viewport()->update();
+    }
+
+    updateGeometry();
+}
+
+/*!
+   \return Maximum number of entries in a row
+   \sa setMaxColumns()
+ */
+uint QwtVirtualLegend::maxColumns() const
+{
+    return m_data->maxColumns;
+}
+
+/*!
+   \brief Set the default mode for legend entries
+
+   When the attributes of an entry don't contain a value for the
+   QwtLegendData::ModeRole the entry is initialized with the default mode.
+
+   \param mode Default item mode
+   \sa defaultItemMode(), QwtLegend::setDefaultItemMode()
+   \note Changing the mode doesn't have any effect on existing entries.
+ */
+void QwtVirtualLegend::setDefaultItemMode( QwtLegendData::Mode mode )
+{
+    m_data->itemMode = mode;
+}
+
+/*!
+   \return Default item mode
+   \sa setDefaultItemMode()
+ */
+QwtLegendData::Mode QwtVirtualLegend::defaultItemMode() const
+{
+    return m_data->itemMode;
+}
+
+/*!
+   \brief Check/Uncheck a legend entry
+
+   Like QwtLegendLabel::setChecked() no signal is emitted
+   and entries, that are not in QwtLegendData::Checkable mode are ignored.
+
+   \param itemInfo Info about an item
+   \param on check/uncheck
+   \param index Index of the entry in the list of entries of the item
+
+   \sa isChecked(), checked()
+ */
+void QwtVirtualLegend::setChecked(
+    const QVariant& itemInfo, bool on, int index )
+{
+    const int itemIndex = m_data->findItem( itemInfo );
+    if ( itemIndex < 0 )
+        return;
+
+    QVector< LegendEntry >& entries = m_data->items[itemIndex].entries;
+    if ( index < 0 || index >= entries.size() )
+        return;
+
+    LegendEntry& entry = entries[index];
+    if ( entry.mode == QwtLegendData::Checkable && entry.isDown != on )
+    {
+        entry.isDown = on;
+
+        m_data->updateLayout();
+        m_data->updateEntry( m_data->offsets[itemIndex] + index );
+    }
+}
+
+/*!
+   \return True, when the entry is in QwtLegendData::Checkable mode and checked
+
+   \param itemInfo Info about an item
+   \param index Index of the entry in the list of entries of the item
+
+   \sa setChecked()
+ */
+bool QwtVirtualLegend::isChecked( const QVariant& itemInfo, int index ) const
+{
+    const int itemIndex = m_data->findItem( itemInfo );
+    if ( itemIndex < 0 )
+        return false;
+
+    const QVector< LegendEntry >& entries = m_data->items[itemIndex].entries;
+    if ( index < 0 || index >= entries.size() )
+        return false;
+
+    return entries[index].mode == QwtLegendData::Checkable && entries[index].isDown;
+}
+
+/*!
+   \brief Find the entry at a position
+
+   \param pos Position in widget coordinates
+   \param index Returns the index of the entry in the list of entries
+               of the item, or -1, when there is no entry at pos
+
+   \return Info about the item of the entry
+ */
+QVariant QwtVirtualLegend::itemInfoAt( const QPoint& pos, int* index ) const
+{
+    if ( index )
+        *index = -1;
+
+    const QWidget* viewport = m_data->view->viewport();
+
+    int itemIndex, entryIndex;
+    if ( m_data->locate( m_data->entryAt( viewport->mapFrom( this, pos ) ),
+        itemIndex, entryIndex ) )
+    {
+        if ( index )
+            *index = entryIndex;
+
+        return m_data->items[itemIndex].itemInfo;
+    }
+
+    return QVariant();
+}
+
+//! \return Number of legend entries
+int QwtVirtualLegend::entryCount() const
+{
+    m_data->updateLayout();
+    return m_data->numEntries;
+}
+
+/*!
+   \return Horizontal scrollbar
+   \sa verticalScrollBar()
+ */
+QScrollBar* QwtVirtualLegend::horizontalScrollBar() const
+{
+    return m_data->view->horizontalScrollBar();
+}
+
+/*!
+   \return Vertical scrollbar
+   \sa horizontalScrollBar()
+ */
+QScrollBar* QwtVirtualLegend::verticalScrollBar() const
+{
+    return m_data->view->verticalScrollBar();
+}
+
+/*!
+   \brief Update the entries for an item
+
+   Only the attributes are stored. Icons are rendered, when the entries
+   become visible.
+
+   \param itemInfo Info for an item
+   \param legendData List of legend entry attributes for the item
+ */
+void QwtVirtualLegend::updateLegend( const QVariant& itemInfo,
+    const QList< QwtLegendData >& legendData )
+{
+    int itemIndex = m_data->findItem( itemInfo );
+
+    bool isModified = false;
+
+    if ( legendData.isEmpty() )
+    {
+        if ( itemIndex < 0 )
+            return;
+
+        m_data->resetPressedEntry();
+        m_data->removeItem( itemIndex );
+        isModified = true;
+    }
+    else
+    {
+        if ( itemIndex < 0 )
+            itemIndex = m_data->appendItem( itemInfo );
+
+        QVector< LegendEntry >& entries = m_data->items[itemIndex].entries;
+
+        const int oldCount = entries.size();
+        bool isShrunk = false;
+
+        if ( entries.size() != legendData.size() )
+        {
+            if ( itemIndex != m_data->items.size() - 1 )
+            {
+                // the indexes of the following entries change
+                m_data->resetPressedEntry();
+            }
+
+            entries.resize( legendData.size() );
+            isModified = true;
+        }
+
+        for ( int i = 0; i < legendData.size(); i++ )
+        {
+            LegendEntry& entry = entries[i];
+
+            entry.data = legendData[i];
+            entry.icon = QPixmap();
+
+            if ( entry.data.hasRole( QwtLegendData::ModeRole ) )
+                entry.mode = entry.data.mode();
+            else
+                entry.mode = m_data->itemMode;
+
+            if ( entry.mode != QwtLegendData::ReadOnly )
+                m_data->view->setFocusPolicy( Qt::TabFocus );
+
+            const QSize size = qwtEntrySize( this, entry );
+            if ( size != entry.size )
+            {
+                if ( i < oldCount && ( size.width() < entry.size.width()
+                    || size.height() < entry.size.height() ) )
+                {
+                    isShrunk = true;
+                }
+
+                entry.size = size;
+                isModified = true;
+            }
+        }
+
+        if ( isModified )
+            m_data->updateOffsets( itemIndex, oldCount, isShrunk );
+    }
+
+    if ( isModified )
+    {
+        if ( m_data->isDirty )
+        {
+            /*
+               Recalculating the layout is deferred, so that removing
+               many items results in one recalculation only. As
+               LayoutRequest events are compressed only one is delivered.
+             */
+            QApplication::postEvent( m_data->view,
+                new QEvent( QEvent::LayoutRequest ) );
+        }
+        else
+        {
+            updateContents();
+        }
+    }
+    else
+    {
+        m_data->view->viewport()->update();
+    }
+}
+
+void QwtVirtualLegend::updateContents()
+{
+    m_data->compactItems();
+    m_data->updateLayout();
+
+    if ( m_data->currentEntry >= m_data->numEntries )
+        m_data->currentEntry = m_data->numEntries - 1;
+
+    m_data->updateScrollBars();
+    m_data->view->viewport()->update();
+
+    if ( m_data->hintCellSize != m_data->cellSize
+        || m_data->hintNumEntries != m_data->numEntries )
+    {
+        m_data->hintCellSize = m_data->cellSize;
+        m_data->hintNumEntries = m_data->numEntries;
+
+        updateGeometry();
+
+        if ( parentWidget() && parentWidget()->layout() == NULL )
+        {
+            /*
+               As QwtLegend we post the LayoutRequest manually, so that
+               the parent widget ( usually QwtPlot ) can show/hide the
+               legend, even when it is hidden. As LayoutRequest events
+               are compressed, attaching many items results in
+               one recalculation of the plot layout only.
+             */
+            QApplication::postEvent( parentWidget(),
+                new QEvent( QEvent::LayoutRequest ) );
+        }
+    }
+}
+
+//! Return a size hint.
+QSize QwtVirtualLegend::sizeHint() const
+{
+    m_data->updateLayout();
+
+    int numCols = m_data->numEntries;
+    if ( m_data->maxColumns > 0 )
+        numCols = qMin( numCols, int( m_data->maxColumns ) );
+
+    QSize hint = m_data->contentsSize( numCols );
+    hint += QSize( 2 * frameWidth(), 2 * frameWidth() );
+
+    return hint;
+}
+
+/*!
+   \return The preferred height, for a width.
+   \param width Width
+ */
+int QwtVirtualLegend::heightForWidth( int width ) const
+{
+    width -= 2 * frameWidth();
+
+    const QSize sz = m_data->contentsSize( m_data->numColumns( width ) );
+    return sz.height() + 2 * frameWidth();
+}
+
+/*!
+   Handle the events of the viewport: painting, resizing and
+   the mouse/keyboard interaction with the legend entries.
+
+   \param object Object to be filtered
+   \param event Event
+
+   \return Forwarded to QwtAbstractLegend::eventFilter()
+ */
+bool QwtVirtualLegend::eventFilter( QObject* object, QEvent* event )
+{
+    if ( object == m_data->view->viewport() )
+    {
+        switch ( event->type() )
+        {
+            case QEvent::Paint:
+            {
+                paintViewport( static_cast< QPaintEvent* >( event ) );
+                return true;
+            }
+            case QEvent::Resize:
+            {
+                m_data->updateScrollBars();
+                break;
+            }
+            case QEvent::MouseButtonPress:
+            {
+                const QMouseEvent* me = static_cast< QMouseEvent* >( event );
+                if ( me->button() == Qt::LeftButton )
+                {
+                    const int index = m_data->entryAt( me->pos() );
+                    if ( index >= 0 )
+                    {
+                        setCurrentEntry( index );
+                        pressEntry( index );
+
+                        return true;
+                    }
+                }
+                break;
+            }
+            case QEvent::MouseButtonRelease:
+            {
+                const QMouseEvent* me = static_cast< QMouseEvent* >( event );
+                if ( me->button() == Qt::LeftButton && m_data->pressedEntry >= 0 )
+                {
+                    releaseEntry( m_data->pressedEntry );
+                    return true;
+                }
+                break;
+            }
+            case QEvent::Leave:
+            {
+                // the release might never arrive
+                m_data->resetPressedEntry();
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    else if ( object == m_data->view )
+    {
+        switch ( event->type() )
+        {
+            case QEvent::KeyPress:
+            {
+                const QKeyEvent* ke = static_cast< QKeyEvent* >( event );
+                if ( ke->key() == Qt::Key_Space )
+                {
+                    if ( !ke->isAutoRepeat() && m_data->currentEntry >= 0 )
+                        pressEntry( m_data->currentEntry );
+
+                    return true;
+                }
+
+                if ( moveCurrentEntry( ke->key() ) )
+                    return true;
+
+                break;
+            }
+            case QEvent::KeyRelease:
+            {
+                const QKeyEvent* ke = static_cast< QKeyEvent* >( event );
+                if ( ke->key() == Qt::Key_Space )
+                {
+                    if ( !ke->isAutoRepeat() && m_data->pressedEntry >= 0 )
+                        releaseEntry( m_data->pressedEntry );
+
+                    return true;
+                }
+                break;
+            }
+            case QEvent::LayoutRequest:
+            {
+                // posted from updateLegend()
+                if ( m_data->isDirty || m_data->numRemoved > 0 )
+                    updateContents();
+
+                break;
+            }
+            case QEvent::FocusIn:
+            case QEvent::FocusOut:
+            {
+                m_data->updateEntry( m_data->currentEntry );
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return QwtAbstractLegend::eventFilter( object, event );
+}
+
+/*!
+   Recalculate the size of the entries, when the font or style has changed
+
+   \param event Change event
+ */
+void QwtVirtualLegend::changeEvent( QEvent* event )
+{
+    if ( event->type() == QEvent::FontChange ||
+        event->type() == QEvent::StyleChange )
+    {
+        for ( int i = 0; i < m_data->items.size(); i++ )
+        {
+            QVector< LegendEntry >& entries = m_data->items[i].entries;
+            for ( int j = 0; j < entries.size(); j++ )
+                entries[j].size = qwtEntrySize( this, entries[j] );
+        }
+
+        m_data->isDirty = true;
+        updateContents();
+    }
+
+    QwtAbstractLegend::changeEvent( event );
+}
+
+void QwtVirtualLegend::paintViewport( QPaintEvent* event )
+{
+    QWidget* viewport = m_data->view->viewport();
+
+    const int numCols = m_data->numColumns( viewport->width() );
+    if ( numCols <= 0 )
+        return;
+
+    const QPoint origin = m_data->contentsOrigin( viewport->width(), numCols );
+    const QRect clipRect = event->rect();
+
+    const int rowHeight = m_data->cellSize.height() + Spacing;
+
+    const int firstRow = qMax( ( clipRect.top() - origin.y() ) / rowHeight, 0 );
+    const int lastRow = qMax( ( clipRect.bottom() - origin.y() ) / rowHeight, 0 );
+
+    const int from = firstRow * numCols;
+    const int to = qMin( ( lastRow + 1 ) * numCols, m_data->numEntries );
+
+    const bool hasFocus = m_data->view->hasFocus();
+
+    QPainter painter( viewport );
+    painter.setClipRegion( event->region() );
+    painter.setFont( font() );
+
+    for ( int index = from; index < to; index++ )
+    {
+        const QRect rect = m_data->cellRect( index, numCols, origin );
+        if ( !rect.intersects( clipRect ) )
+            continue;
+
+        LegendEntry* entry = m_data->entry( index );
+
+        if ( entry->icon.isNull() && !entry->data.icon().isNull() )
+            entry->icon = entry->data.icon().toPixmap();
+
+        qwtDrawEntry( &painter, this, *entry, rect, entry->isDown,
+            hasFocus && index == m_data->currentEntry, &entry->icon );
+    }
+}
+
+void QwtVirtualLegend::pressEntry( int index )
+{
+    LegendEntry* entry = m_data->entry( index );
+    if ( entry == NULL )
+        return;
+
+    switch ( entry->mode )
+    {
+        case QwtLegendData::Clickable:
+        {
+            entry->isDown = true;
+            m_data->pressedEntry = index;
+            m_data->updateEntry( index );
+
+            break;
+        }
+        case QwtLegendData::Checkable:
+        {
+            entry->isDown = !entry->isDown;
+            m_data->updateEntry( index );
+
+            int itemIndex, entryIndex;
+            m_data->locate( index, itemIndex, entryIndex );
+
+            const QVariant itemInfo = m_data->items[itemIndex].itemInfo;
+            Q_EMIT checked( itemInfo, entry->isDown, entryIndex );
+
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void QwtVirtualLegend::releaseEntry( int index )
+{
+    m_data->pressedEntry = -1;
+
+    LegendEntry* entry = m_data->entry( index );
+    if ( entry == NULL || entry->mode != QwtLegendData::Clickable || !entry->isDown )
+        return;
+
+    entry->isDown = false;
+    m_data->updateEntry( index );
+
+    int itemIndex, entryIndex;
+    m_data->locate( index, itemIndex, entryIndex );
+
+    const QVariant itemInfo = m_data->items[itemIndex].itemInfo;
+    Q_EMIT clicked( itemInfo, entryIndex );
+}
+
+void QwtVirtualLegend::setCurrentEntry( int index )
+{
+    if ( index == m_data->currentEntry )
+        return;
+
+    m_data->updateEntry( m_data->currentEntry );
+    m_data->currentEntry = index;
+
+    const QWidget* viewport = m_data->view->viewport();
+
+    const int numCols = m_data->numColumns( viewport->width() );
+    if ( numCols <= 0 || index < 0 )
+        return;
+
+    // scroll the entry into the visible area
+
+    const QRect rect = m_data->cellRect( index, numCols, QPoint( 0, 0 ) );
+
+    QScrollBar* scrollBar = m_data->view->verticalScrollBar();
+    if ( rect.top() < scrollBar->value() )
+        scrollBar->setValue( rect.top() );
+    else if ( rect.bottom() >= scrollBar->value() + viewport->height() )
+        scrollBar->setValue( rect.bottom() - viewport->height() + 1 );
+
+    m_data->updateEntry( index );
+}
+
+bool QwtVirtualLegend::moveCurrentEntry( int key )
+{
+    const int numCols = m_data->numColumns( m_data->view->viewport()->width() );
+    if ( numCols <= 0 )
+        return false;
+
+    int index = m_data->currentEntry;
+
+    switch ( key )
+    {
+        case Qt::Key_Left:
+            index--;
+            break;
+        case Qt::Key_Right:
+            index++;
+            break;
+        case Qt::Key_Up:
+            index -= numCols;
+            break;
+        case Qt::Key_Down:
+            index += numCols;
+            break;
+        case Qt::Key_Home:
+            index = 0;
+            break;
+        case Qt::Key_End:
+            index = m_data->numEntries - 1;
+            break;
+        default:
+            return false;
+    }
+
+    if ( m_data->currentEntry < 0 )
+        index = 0;
+
+    if ( index >= 0 && index < m_data->numEntries )
+        setCurrentEntry( index );
+
+    return true;
+}
+
+/*!
+   Render the legend into a given rectangle.
+
+   \param painter Painter
+   \param rect Bounding rectangle
+   \param fillBackground When true, fill rect with the widget background
+
+   \sa renderLegend() is used by QwtPlotRenderer - not by QwtVirtualLegend itself
+ */
+void QwtVirtualLegend::renderLegend( QPainter* painter,
+    const QRectF& rect, bool fillBackground ) const
+{
+    if ( !m_data->hasItems() )
+        return;
+
+    if ( fillBackground )
+    {
+        if ( autoFillBackground() ||
+            testAttribute( Qt::WA_StyledBackground ) )
+        {
+            QwtPainter::drawBackgound( painter, rect, this );
+        }
+    }
+
+    const QMargins m = contentsMargins();
+
+    QRect layoutRect;
+    layoutRect.setLeft( qwtCeil( rect.left() ) + m.left() );
+    layoutRect.setTop( qwtCeil( rect.top() ) + m.top() );
+    layoutRect.setRight( qwtFloor( rect.right() ) - m.right() );
+    layoutRect.setBottom( qwtFloor( rect.bottom() ) - m.bottom() );
+
+    const int numCols = m_data->numColumns( layoutRect.width() );
+    if ( numCols <= 0 )
+        return;
+
+    const QSize sz = m_data->contentsSize( numCols );
+
+    QPoint origin = layoutRect.topLeft();
+    if ( sz.width() < layoutRect.width() )
+        origin.rx() += ( layoutRect.width() - sz.width() ) / 2;
+
+    QFont labelFont = font();
+#if QT_VERSION >= 0x060000
+    labelFont.setResolveMask( QFont::AllPropertiesResolved );
+#else
+    labelFont.resolve( QFont::AllPropertiesResolved );
+#endif
+
+    painter->save();
+    painter->setFont( labelFont );
+
+    for ( int index = 0; index < m_data->numEntries; index++ )
+    {
+        const QRect entryRect = m_data->cellRect( index, numCols, origin );
+        if ( entryRect.top() > layoutRect.bottom() )
+            break;
+
+        int itemIndex, entryIndex;
+        m_data->locate( index, itemIndex, entryIndex );
+
+        const LegendEntry& entry = m_data->items[itemIndex].entries[entryIndex];
+        qwtDrawEntry( painter, this, entry, entryRect, false, false, NULL );
+    }
+
+    painter->restore();
+}
+
+//! \return True, when no item is inserted
+bool QwtVirtualLegend::isEmpty() const
+{
+    return !m_data->hasItems();
+}
+
+/*!
+    Return the extent, that is needed for the scrollbars
+
+    \param orientation Orientation
+    \return The width of the vertical scrollbar for Qt::Horizontal and v.v.
+ */
+int QwtVirtualLegend::scrollExtent( Qt::Orientation orientation ) const
+{
+    int extent = 0;
+
+    if ( orientation == Qt::Horizontal )
+        extent = verticalScrollBar()->sizeHint().width();
+    else
+        extent = horizontalScrollBar()->sizeHint().height();
+
+    return extent;
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_virtual_legend.cpp"
+#endif
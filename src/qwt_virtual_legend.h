@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_VIRTUAL_LEGEND_H
+#define QWT_VIRTUAL_LEGEND_H
+
+#include "qwt_global.h"
+#include "qwt_abstract_legend.h"
+#include "qwt_legend_data.h"
+
+#include <qvariant.h>
+
+class QScrollBar;
+
+/*!
+   \brief A legend widget for plots with many items
+
+   QwtLegend creates a QwtLegendLabel for each entry, what gets expensive
+   for plots with thousands of items. QwtVirtualLegend offers the same
+   tabular arrangement, but does not create any child widgets. The entries
+   are stored as QwtLegendData and only those in the visible part of the
+   viewport are painted. The icons are rendered lazily to pixmaps, when
+   an entry becomes visible for the first time, and are cached until
+   the entry gets updated.
+
+   All cells of the grid have the same size, so finding the visible
+   entries or the entry at a position is a simple calculation and
+   attaching or updating an item does not trigger a relayout of widgets.
+
+   Clickable and checkable entries behave like a QwtLegendLabel.
+   The entries can be operated by the mouse as well as by the keyboard
+   ( cursor keys and space ).
+
+   \sa QwtLegend, QwtLegendData, QwtPlot::insertLegend()
+ */
+class QWT_EXPORT QwtVirtualLegend : public QwtAbstractLegend
+{
+    Q_OBJECT
+
+  public:
+    explicit QwtVirtualLegend( QWidget* parent = NULL );
+    virtual ~QwtVirtualLegend();
+
+    void setMaxColumns( uint numColums );
+    uint maxColumns() const;
+
+    void setDefaultItemMode( QwtLegendData::Mode );
+    QwtLegendData::Mode defaultItemMode() const;
+
+    void setChecked( const QVariant& itemInfo, bool on, int index = 0 );
+    bool isChecked( const QVariant& itemInfo, int index = 0 ) const;
+
+    QVariant itemInfoAt( const QPoint&, int* index = NULL ) const;
+
+    int entryCount() const;
+
+    virtual bool eventFilter( QObject*, QEvent* ) QWT_OVERRIDE;
+
+    virtual QSize sizeHint() const QWT_OVERRIDE;
+    virtual int heightForWidth( int w ) const QWT_OVERRIDE;
+
+    QScrollBar* horizontalScrollBar() const;
+    QScrollBar* verticalScrollBar() const;
+
+    virtual void renderLegend( QPainter*,
+        const QRectF&, bool fillBackground ) const QWT_OVERRIDE;
+
+    virtual bool isEmpty() const QWT_OVERRIDE;
+    virtual int scrollExtent( Qt::Orientation ) const QWT_OVERRIDE;
+
+  Q_SIGNALS:
+    /*!
+       A signal which is emitted when the user has clicked on
+       a legend entry, which is in QwtLegendData::Clickable mode.
+
+       \param itemInfo Info for the item of the selected legend entry
+       \param index Index of the legend entry in the list of entries
+                   that are associated with the plot item
+
+       \sa setDefaultItemMode(), QwtLegend::clicked()
+     */
+    void clicked( const QVariant& itemInfo, int index );
+
+    /*!
+       A signal which is emitted when the user has clicked on
+       a legend entry, which is in QwtLegendData::Checkable mode
+
+       \param itemInfo Info for the item of the selected legend entry
+       \param on True when the legend entry is checked
+       \param index Index of the legend entry in the list of entries
+                   that are associated with the plot item
+
+       \sa setDefaultItemMode(), QwtLegend::checked()
+     */
+    void checked( const QVariant& itemInfo, bool on, int index );
+
+  public Q_SLOTS:
+    virtual void updateLegend( const QVariant&,
+        const QList< QwtLegendData >& ) QWT_OVERRIDE;
+
+  protected:
+    virtual void changeEvent( QEvent* ) QWT_OVERRIDE;
+
+  private:
+    void paintViewport( QPaintEvent* );
+
+    void pressEntry( int index );
+    void releaseEntry( int index );
+
+    void setCurrentEntry( int index );
+    bool moveCurrentEntry( int key );
+
+    void updateContents();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
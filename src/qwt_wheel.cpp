@@ -19,6 +19,7 @@
 #include <qstyleoption.h>
 #include <qelapsedtimer.h>
 #include <qmath.h>
+#include <qpixmap.h>
 
 class QwtWheel::PrivateData
 {
@@ -86,6 +87,9 @@ class QwtWheel::PrivateData
     bool pendingValueChanged; // when not tracking
     bool inverted;
     bool wrapping;
+
+    // background, border and wheel without the ticks
+    QPixmap pixmapCache;
 };
 
 //! Constructor
@@ -214,7 +218,7 @@ void QwtWheel::mouseMoveEvent( QMouseEvent* event )
     {
         m_data->value = value;
 
-        update();
+        update( wheelRect() );
 
         Q_EMIT wheelMoved( m_data->value );
 
@@ -306,7 +310,7 @@ void QwtWheel::timerEvent( QTimerEvent* event )
     if ( value != m_data->value )
     {
         m_data->value = value;
-        update();
+        update( wheelRect() );
 
         if ( m_data->tracking || m_data->timerId == 0 )
             Q_EMIT valueChanged( m_data->value );
@@ -372,7 +376,7 @@ void QwtWheel::wheelEvent( QWheelEvent* event )
     if ( value != m_data->value )
     {
         m_data->value = value;
-        update();
+        update( wheelRect() );
 
         Q_EMIT valueChanged( m_data->value );
         Q_EMIT wheelMoved( m_data->value );
@@ -499,7 +503,7 @@ void QwtWheel::keyPressEvent( QKeyEvent* event )
     if ( value != m_data->value )
     {
         m_data->value = value;
-        update();
+        update( wheelRect() );
 
         Q_EMIT valueChanged( m_data->value );
         Q_EMIT wheelMoved( m_data->value );
@@ -553,6 +557,7 @@ void QwtWheel::setWheelBorderWidth( int borderWidth )
     const int d = qMin( width(), height() ) / 3;
     borderWidth = qMin( borderWidth, d );
     m_data->wheelBorderWidth = qMax( borderWidth, 1 );
+    invalidateCache();
     update();
 }
 
@@ -576,6 +581,7 @@ int QwtWheel::wheelBorderWidth() const
 void QwtWheel::setBorderWidth( int width )
 {
     m_data->borderWidth = qMax( width, 0 );
+    invalidateCache();
     update();
 }
 
@@ -651,6 +657,7 @@ void QwtWheel::setOrientation( Qt::Orientation orientation )
     }
 
     m_data->orientation = orientation;
+    invalidateCache();
     update();
 }
 
@@ -738,25 +745,84 @@ void QwtWheel::paintEvent( QPaintEvent* event )
     QPainter painter( this );
     painter.setClipRegion( event->region() );
 
-    QStyleOption opt;
-    opt.initFrom(this);
-    style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
+    if ( m_data->pixmapCache.isNull() )
+    {
+        m_data->pixmapCache = QwtPainter::backingStore( this, size() );
+        m_data->pixmapCache.fill( Qt::transparent );
+
+        QPainter p( &m_data->pixmapCache );
+
+        QStyleOption opt;
+        opt.initFrom(this);
+        style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
 
-    qDrawShadePanel( &painter,
-        contentsRect(), palette(), true, m_data->borderWidth );
+        qDrawShadePanel( &p,
+            contentsRect(), palette(), true, m_data->borderWidth );
+
+        drawWheelBackground( &p, wheelRect() );
+    }
+
+    painter.drawPixmap( 0, 0, m_data->pixmapCache );
 
-    drawWheelBackground( &painter, wheelRect() );
     drawTicks( &painter, wheelRect() );
 
     if ( hasFocus() )
         QwtPainter::drawFocusRect( &painter, this );
 }
 
+/*!
+   Invalidate the cache on resize
+   \param event Resize event
+ */
+void QwtWheel::resizeEvent( QResizeEvent* event )
+{
+    invalidateCache();
+    QWidget::resizeEvent( event );
+}
+
+/*!
+   Invalidate the cache, when the style or the palette has changed
+   \param event Change event
+ */
+void QwtWheel::changeEvent( QEvent* event )
+{
+    switch( event->type() )
+    {
+        case QEvent::StyleChange:
+        case QEvent::PaletteChange:
+        case QEvent::EnabledChange:
+        {
+            invalidateCache();
+            update();
+            break;
+        }
+        default:
+            break;
+    }
+
+    QWidget::changeEvent( event );
+}
+
+/*!
+   Invalidate the cache for the parts of the wheel, that don't
+   depend on the value: background, border and wheel without ticks.
+
+   \sa drawWheelBackground()
+ */
+void QwtWheel::invalidateCache()
+{
+    m_data->pixmapCache = QPixmap();
+}
+
 /*!
    Draw the Wheel's background gradient
 
    \param painter Painter
    \param rect Geometry for the wheel
+
+   \note The background is painted to a cache, that is reused for
+         all values. invalidateCache() has to be called, when an
+         implementation of drawWheelBackground() changes its appearance.
  */
 void QwtWheel::drawWheelBackground(
     QPainter* painter, const QRectF& rect )
@@ -1070,7 +1136,7 @@ void QwtWheel::setRange( double min, double max )
     {
         m_data->value = qBound( min, m_data->value, max );
 
-        update();
+        update( wheelRect() );
         Q_EMIT valueChanged( m_data->value );
     }
 }
@@ -1135,7 +1201,7 @@ void QwtWheel::setValue( double value )
     {
         m_data->value = value;
 
-        update();
+        update( wheelRect() );
         Q_EMIT valueChanged( m_data->value );
     }
 }
@@ -1165,7 +1231,7 @@ void QwtWheel::setInverted( bool on )
     if ( m_data->inverted != on )
     {
         m_data->inverted = on;
-        update();
+        update( wheelRect() );
     }
 }
 
@@ -155,6 +155,10 @@ class QWT_EXPORT QwtWheel : public QWidget
     virtual void keyPressEvent( QKeyEvent* ) QWT_OVERRIDE;
     virtual void wheelEvent( QWheelEvent* ) QWT_OVERRIDE;
     virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
+    virtual void resizeEvent( QResizeEvent* ) QWT_OVERRIDE;
+    virtual void changeEvent( QEvent* ) QWT_OVERRIDE;
+
+    void invalidateCache();
 
     void stopFlying();
 
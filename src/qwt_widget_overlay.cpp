@@ -15,8 +15,15 @@
 #include <qpainterpath.h>
 #include <qimage.h>
 #include <qevent.h>
+#include <qvector.h>
 
-#include <cstdlib>
+#include <cstring>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) \
+    || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define QWT_USE_SSE2 1
+#include <emmintrin.h>
+#endif
 
 static QImage::Format qwtMaskImageFormat()
 {
@@ -26,67 +33,122 @@ static QImage::Format qwtMaskImageFormat()
     return QImage::Format_ARGB32_Premultiplied;
 }
 
-static QRegion qwtAlphaMask( const QImage& image, const QRegion& region )
+namespace
+{
+    // a pixel is part of the mask, when it is not fully transparent
+    inline bool qwtIsOpaque( uint pixel )
+    {
+        return ( pixel >> 24 ) != 0;
+    }
+}
+
+/*
+    Returns the first position in [from, to), where qwtIsOpaque()
+    is equal to opaque. Runs of 4 pixels are checked at once,
+    when SSE2 is available.
+ */
+static inline int qwtFindAlpha( const uint* line, int from, int to, bool opaque )
+{
+    int x = from;
+
+#if QWT_USE_SSE2
+    const __m128i alphaMask = _mm_set1_epi32( int( 0xff000000 ) );
+    const __m128i zero = _mm_setzero_si128();
+
+    // the movemask of 4 transparent pixels is 0xffff, of 4 opaque pixels 0
+    const int skipMask = opaque ? 0xffff : 0;
+
+    for ( ; x + 4 <= to; x += 4 )
+    {
+        const __m128i pixels = _mm_loadu_si128(
+            reinterpret_cast< const __m128i* >( line + x ) );
+
+        const __m128i isTransparent =
+            _mm_cmpeq_epi32( _mm_and_si128( pixels, alphaMask ), zero );
+
+        if ( _mm_movemask_epi8( isTransparent ) != skipMask )
+            break;
+    }
+#endif
+
+    for ( ; x < to; x++ )
+    {
+        if ( qwtIsOpaque( line[x] ) == opaque )
+            return x;
+    }
+
+    return to;
+}
+
+/*
+    Find the non transparent pixels of image, where the image
+    is located at pos. Rows with the same runs are merged, so that
+    the rectangles can be passed to QRegion in one call.
+ */
+static QRegion qwtAlphaMask( const QImage& image, const QPoint& pos )
 {
     const int w = image.width();
     const int h = image.height();
 
-    QRegion mask;
-    QRect rect;
+    QVector< QRect > rects;
 
-#if QT_VERSION >= 0x050800
-    for ( QRegion::const_iterator it = region.cbegin();
-        it != region.cend(); ++it )
-    {
-        const QRect& r = *it;
-#else
-    const QVector< QRect > rects = region.rects();
-    for ( int i = 0; i < rects.size(); i++ )
+    // the rectangles of the band above
+    int bandStart = 0;
+    int bandEnd = 0;
+
+    QVector< int > runs;
+
+    for ( int y = 0; y < h; y++ )
     {
-        const QRect& r = rects[i];
-#endif
-        int x1, x2, y1, y2;
-        r.getCoords( &x1, &y1, &x2, &y2 );
+        const uint* line = reinterpret_cast< const uint* >( image.constScanLine( y ) );
 
-        x1 = qMax( x1, 0 );
-        x2 = qMin( x2, w - 1 );
-        y1 = qMax( y1, 0 );
-        y2 = qMin( y2, h - 1 );
+        runs.resize( 0 );
 
-        for ( int y = y1; y <= y2; ++y )
+        int x = qwtFindAlpha( line, 0, w, true );
+        while ( x < w )
         {
-            bool inRect = false;
-            int rx0 = -1;
+            const int x2 = qwtFindAlpha( line, x, w, false );
 
-            const uint* line =
-                reinterpret_cast< const uint* > ( image.scanLine( y ) ) + x1;
-            for ( int x = x1; x <= x2; x++ )
-            {
-                const bool on = ( ( *line++ >> 24 ) != 0 );
-                if ( on != inRect )
-                {
-                    if ( inRect  )
-                    {
-                        rect.setCoords( rx0, y, x - 1, y );
-                        mask += rect;
-                    }
-                    else
-                    {
-                        rx0 = x;
-                    }
-
-                    inRect = on;
-                }
-            }
+            runs += x;
+            runs += x2;
 
-            if ( inRect )
+            x = qwtFindAlpha( line, x2, w, true );
+        }
+
+        bool sameRuns = ( bandEnd - bandStart ) == runs.size() / 2;
+        for ( int i = bandStart; sameRuns && i < bandEnd; i++ )
+        {
+            const QRect& r = rects[i];
+            const int j = 2 * ( i - bandStart );
+
+            sameRuns = ( r.bottom() == pos.y() + y - 1 )
+                && ( r.left() == pos.x() + runs[j] )
+                && ( r.right() == pos.x() + runs[j + 1] - 1 );
+        }
+
+        if ( sameRuns )
+        {
+            for ( int i = bandStart; i < bandEnd; i++ )
+                rects[i].setBottom( pos.y() + y );
+        }
+        else
+        {
+            bandStart = rects.size();
+
+            for ( int i = 0; i < runs.size(); i += 2 )
             {
-                rect.setCoords( rx0, y, x2, y );
-                mask = mask.united( rect );
+                rects += QRect( pos.x() + runs[i], pos.y() + y,
+                    runs[i + 1] - runs[i], 1 );
             }
+
+            bandEnd = rects.size();
         }
     }
 
+    QRegion mask;
+    if ( !rects.isEmpty() )
+        mask.setRects( rects.constData(), rects.size() );
+
     return mask;
 }
 
@@ -96,27 +158,32 @@ class QwtWidgetOverlay::PrivateData
     PrivateData()
         : maskMode( QwtWidgetOverlay::MaskHint )
         , renderMode( QwtWidgetOverlay::AutoRenderMode )
-        , rgbaBuffer( NULL )
     {
     }
 
-    ~PrivateData()
+    void resetBuffer()
     {
-        resetRgbaBuffer();
+        buffer = QImage();
+        bufferRect = QRect();
     }
 
-    void resetRgbaBuffer()
+    QImage bufferImage() const
     {
-        if ( rgbaBuffer )
-        {
-            std::free( rgbaBuffer );
-            rgbaBuffer = NULL;
-        }
+        // the part of the buffer, that has been painted by updateMask()
+        return QImage( buffer.constBits(), bufferRect.width(),
+            bufferRect.height(), buffer.bytesPerLine(), buffer.format() );
     }
 
     MaskMode maskMode;
     RenderMode renderMode;
-    uchar* rgbaBuffer;
+
+    /*
+        The buffer is reused as long as the size of the widget
+        doesn't change. Only bufferRect - the bounding rectangle
+        of the mask hint - is painted and checked.
+     */
+    QImage buffer;
+    QRect bufferRect;
 };
 
 /*!
@@ -156,7 +223,7 @@ void QwtWidgetOverlay::setMaskMode( MaskMode mode )
     if ( mode != m_data->maskMode )
     {
         m_data->maskMode = mode;
-        m_data->resetRgbaBuffer();
+        m_data->resetBuffer();
     }
 }
 
@@ -200,8 +267,6 @@ void QwtWidgetOverlay::updateOverlay()
 
 void QwtWidgetOverlay::updateMask()
 {
-    m_data->resetRgbaBuffer();
-
     QRegion mask;
 
     if ( m_data->maskMode == QwtWidgetOverlay::MaskHint )
@@ -210,35 +275,57 @@ void QwtWidgetOverlay::updateMask()
     }
     else if ( m_data->maskMode == QwtWidgetOverlay::AlphaMask )
     {
-        // TODO: the image doesn't need to be larger than
-        //       the bounding rectangle of the hint !!
+        const QRect widgetRect( 0, 0, width(), height() );
 
         QRegion hint = maskHint();
         if ( hint.isEmpty() )
-            hint += QRect( 0, 0, width(), height() );
+            hint += widgetRect;
 
-        // A fresh buffer from calloc() is usually faster
-        // than reinitializing an existing one with
-        // QImage::fill( 0 ) or memset()
+        // only the bounding rectangle of the hint is painted and checked
 
-        m_data->rgbaBuffer = ( uchar* )::calloc( width() * height(), 4 );
+        const QRect rect = hint.boundingRect() & widgetRect;
 
-        QImage image( m_data->rgbaBuffer,
-            width(), height(), qwtMaskImageFormat() );
+        if ( m_data->buffer.width() < rect.width()
+            || m_data->buffer.height() < rect.height() )
+        {
+            // growing up to the size of the widget
+            m_data->buffer = QImage( widgetRect.size(), qwtMaskImageFormat() );
+        }
 
-        QPainter painter( &image );
-        draw( &painter );
-        painter.end();
+        m_data->bufferRect = rect;
+
+        if ( !rect.isEmpty() )
+        {
+            QImage image( m_data->buffer.bits(), rect.width(), rect.height(),
+                m_data->buffer.bytesPerLine(), m_data->buffer.format() );
 
-        mask = qwtAlphaMask( image, hint );
+            // clearing the reused buffer is limited to the painted area
+            for ( int y = 0; y < image.height(); y++ )
+                std::memset( image.scanLine( y ), 0, 4 * image.width() );
+
+            QPainter painter( &image );
+            painter.translate( -rect.topLeft() );
+            draw( &painter );
+            painter.end();
+
+            mask = qwtAlphaMask( image, rect.topLeft() );
+            if ( hint.rectCount() > 1 )
+                mask &= hint;
+        }
 
         if ( m_data->renderMode == QwtWidgetOverlay::DrawOverlay )
         {
-            // we don't need the buffer later
-            m_data->resetRgbaBuffer();
+            // the buffer is kept for the next update, but not used for painting
+            m_data->bufferRect = QRect();
         }
     }
 
+    if ( !isHidden() && mask == this->mask() )
+    {
+        // toggling the visibility would initiate a full repaint
+        return;
+    }
+
     // A bug in Qt initiates a full repaint of the widget
     // when we change the mask, while we are visible !
 
@@ -275,10 +362,12 @@ void QwtWidgetOverlay::paintEvent( QPaintEvent* event )
             useRgbaBuffer = true;
     }
 
-    if ( m_data->rgbaBuffer && useRgbaBuffer )
+    if ( m_data->bufferRect.isValid() && useRgbaBuffer )
     {
-        const QImage image( m_data->rgbaBuffer,
-            width(), height(), qwtMaskImageFormat() );
+        // outside of bufferRect the overlay is transparent
+
+        const QImage image = m_data->bufferImage();
+        const QRect& bufferRect = m_data->bufferRect;
 
         const int rectCount = clipRegion.rectCount();
 
@@ -287,8 +376,9 @@ void QwtWidgetOverlay::paintEvent( QPaintEvent* event )
             // the region is to complex
             painter.setClipRegion( clipRegion );
 
-            const QRect r = clipRegion.boundingRect();
-            painter.drawImage( r.topLeft(), image, r );
+            const QRect r = clipRegion.boundingRect() & bufferRect;
+            painter.drawImage( r.topLeft(), image,
+                r.translated( -bufferRect.topLeft() ) );
         }
         else
         {
@@ -296,17 +386,19 @@ void QwtWidgetOverlay::paintEvent( QPaintEvent* event )
             for ( QRegion::const_iterator it = clipRegion.cbegin();
                 it != clipRegion.cend(); ++it )
             {
-                const QRect& r = *it;
-                painter.drawImage( r.topLeft(), image, r );
-            }
+                const QRect r = *it & bufferRect;
 #else
             const QVector< QRect > rects = clipRegion.rects();
             for ( int i = 0; i < rects.size(); i++ )
             {
-                const QRect& r = rects[i];
-                painter.drawImage( r.topLeft(), image, r );
-            }
+                const QRect r = rects[i] & bufferRect;
 #endif
+                if ( !r.isEmpty() )
+                {
+                    painter.drawImage( r.topLeft(), image,
+                        r.translated( -bufferRect.topLeft() ) );
+                }
+            }
         }
     }
     else
@@ -324,7 +416,7 @@ void QwtWidgetOverlay::resizeEvent( QResizeEvent* event )
 {
     Q_UNUSED( event );
 
-    m_data->resetRgbaBuffer();
+    m_data->resetBuffer();
 }
 
 void QwtWidgetOverlay::draw( QPainter* painter ) const
@@ -114,8 +114,10 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend.h \
         qwt_legend_data.h \
         qwt_legend_label.h \
+        qwt_virtual_legend.h \
         qwt_plot.h \
         qwt_plot_renderer.h \
+        qwt_plot_snapshot.h \
         qwt_plot_curve.h \
         qwt_plot_dict.h \
         qwt_plot_directpainter.h \
@@ -130,6 +132,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_tradingcurve.h \
         qwt_plot_layout.h \
         qwt_plot_marker.h \
+        qwt_plot_eventmarker.h \
         qwt_plot_zoneitem.h \
         qwt_plot_textlabel.h \
         qwt_plot_rasteritem.h \
@@ -147,6 +150,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_zoomer.h \
         qwt_plot_magnifier.h \
         qwt_plot_rescaler.h \
+        qwt_replot_scheduler.h \
         qwt_point_mapper.h \
         qwt_raster_data.h \
         qwt_matrix_raster_data.h \
@@ -156,6 +160,11 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_series_data.h \
         qwt_series_store.h \
         qwt_point_data.h \
+        qwt_sample_array_data.h \
+        qwt_mapped_file.h \
+        qwt_mapped_point_data.h \
+        qwt_mapped_raster_data.h \
+        qwt_histogram_data.h \
         qwt_scale_widget.h 
 
     SOURCES += \
@@ -166,8 +175,10 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend.cpp \
         qwt_legend_data.cpp \
         qwt_legend_label.cpp \
+        qwt_virtual_legend.cpp \
         qwt_plot.cpp \
         qwt_plot_renderer.cpp \
+        qwt_plot_snapshot.cpp \
         qwt_plot_axis.cpp \
         qwt_plot_curve.cpp \
         qwt_plot_dict.cpp \
@@ -190,6 +201,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_shapeitem.cpp \
         qwt_plot_vectorfield.cpp \
         qwt_plot_marker.cpp \
+        qwt_plot_eventmarker.cpp \
         qwt_plot_textlabel.cpp \
         qwt_plot_layout.cpp \
         qwt_plot_abstract_canvas.cpp \
@@ -200,6 +212,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_zoomer.cpp \
         qwt_plot_magnifier.cpp \
         qwt_plot_rescaler.cpp \
+        qwt_replot_scheduler.cpp \
         qwt_point_mapper.cpp \
         qwt_raster_data.cpp \
         qwt_matrix_raster_data.cpp \
@@ -207,8 +220,25 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_sampling_thread.cpp \
         qwt_series_data.cpp \
         qwt_point_data.cpp \
+        qwt_mapped_file.cpp \
+        qwt_mapped_point_data.cpp \
+        qwt_mapped_raster_data.cpp \
+        qwt_histogram_data.cpp \
         qwt_scale_widget.cpp
 
+    greaterThan(QT_MAJOR_VERSION, 4) {
+
+        HEADERS += \
+            qwt_shared_ring_buffer.h \
+            qwt_shared_point_data.h \
+            qwt_shared_raster_data.h
+
+        SOURCES += \
+            qwt_shared_ring_buffer.cpp \
+            qwt_shared_point_data.cpp \
+            qwt_shared_raster_data.cpp
+    }
+
     contains(QWT_CONFIG, QwtOpenGL) {
 
         lessThan(QT_MAJOR_VERSION, 6) {
@@ -0,0 +1,178 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+/*
+    QwtDate::floor( double, ... ) and QwtDate::addMonths() calculate
+    with the number of milliseconds, without creating QDateTime objects.
+    Their results have to be the same as flooring or adding months
+    with QDateTime - for Qt::UTC and Qt::OffsetFromUTC.
+ */
+
+#include <QwtDate>
+
+#include <QDateTime>
+#include <QDebug>
+
+static const QwtDate::IntervalType intervalTypes[] =
+{
+    QwtDate::Millisecond, QwtDate::Second, QwtDate::Minute, QwtDate::Hour,
+    QwtDate::Day, QwtDate::Week, QwtDate::Month, QwtDate::Year
+};
+
+static const char* intervalNames[] =
+{
+    "Millisecond", "Second", "Minute", "Hour",
+    "Day", "Week", "Month", "Year"
+};
+
+// offsets from UTC in seconds, 0 means Qt::UTC
+static const int utcOffsets[] =
+    { 0, 3600, -5 * 3600, 5 * 3600 + 1800, 14 * 3600, -12 * 3600, -9 * 3600 - 1800 };
+
+static const int monthSteps[] = { -25, -13, -12, -1, 1, 2, 11, 12, 13, 48 };
+
+#define COUNT( array ) int( sizeof( array ) / sizeof( array[0] ) )
+
+static QDateTime dateTime( const QDate& date, const QTime& time, int utcOffset )
+{
+    if ( utcOffset == 0 )
+        return QDateTime( date, time, Qt::UTC );
+
+    return QDateTime( date, time, Qt::OffsetFromUTC, utcOffset );
+}
+
+/*
+    Milliseconds since the epoch of a QDateTime, calculated from its wall
+    clock time, as QwtDate::toDouble() ignores offsets for negative Julian days
+ */
+static double toDouble( const QDateTime& dt, int utcOffset )
+{
+    const QDateTime wallClock( dt.date(), dt.time(), Qt::UTC );
+    return QwtDate::toDouble( wallClock ) - 1000.0 * utcOffset;
+}
+
+static QList< QDateTime > wallClockTimes()
+{
+    QList< QDate > dates;
+
+    // month ends and leap years
+
+    const int years[] = { 1583, 1600, 1700, 1899, 1900, 1969, 1970,
+        1999, 2000, 2004, 2023, 2024, 2100, 2400, 9999 };
+
+    for ( int i = 0; i < COUNT( years ); i++ )
+    {
+        for ( int month = 1; month <= 12; month++ )
+        {
+            const QDate first( years[i], month, 1 );
+
+            dates += first;
+            dates += first.addDays( 14 );
+            dates += QDate( years[i], month, first.daysInMonth() );
+        }
+    }
+
+    // dates before 1583 and negative Julian days
+
+    const qint64 julianDays[] = { 2299160, 1000000, 1, 0, -1,
+        -1000, -100000, -1000000 };
+
+    for ( int i = 0; i < COUNT( julianDays ); i++ )
+        dates += QDate::fromJulianDay( julianDays[i] );
+
+    const QTime times[] =
+    {
+        QTime( 0, 0, 0, 0 ),
+        QTime( 0, 0, 0, 1 ),
+        QTime( 0, 59, 59, 999 ),
+        QTime( 12, 34, 56, 789 ),
+        QTime( 23, 0, 0, 0 ),
+        QTime( 23, 59, 59, 999 )
+    };
+
+    QList< QDateTime > dateTimes;
+
+    for ( int i = 0; i < dates.size(); i++ )
+    {
+        for ( int j = 0; j < COUNT( times ); j++ )
+            dateTimes += QDateTime( dates[i], times[j], Qt::UTC );
+    }
+
+    return dateTimes;
+}
+
+static bool testFloor( const QDateTime& wallClock, int utcOffset )
+{
+    const QDateTime dt = dateTime( wallClock.date(), wallClock.time(), utcOffset );
+    const double value = toDouble( dt, utcOffset );
+
+    bool ok = true;
+
+    for ( int i = 0; i < COUNT( intervalTypes ); i++ )
+    {
+        const double expected = toDouble(
+            QwtDate::floor( dt, intervalTypes[i] ), utcOffset );
+
+        const double floored = QwtDate::floor( value, intervalTypes[i], utcOffset );
+
+        if ( floored != expected )
+        {
+            qWarning() << "floor" << intervalNames[i] << dt << "offset" << utcOffset
+                       << ":" << QwtDate::toDateTime( floored, Qt::UTC )
+                       << "instead of" << QwtDate::toDateTime( expected, Qt::UTC );
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+static bool testAddMonths( const QDateTime& wallClock, int utcOffset )
+{
+    const QDateTime dt = dateTime( wallClock.date(), wallClock.time(), utcOffset );
+    const double value = toDouble( dt, utcOffset );
+
+    bool ok = true;
+
+    for ( int i = 0; i < COUNT( monthSteps ); i++ )
+    {
+        const double expected = toDouble(
+            dt.addMonths( monthSteps[i] ), utcOffset );
+
+        const double value2 = QwtDate::addMonths( value, monthSteps[i], utcOffset );
+
+        if ( value2 != expected )
+        {
+            qWarning() << "addMonths" << monthSteps[i] << dt << "offset" << utcOffset
+                       << ":" << QwtDate::toDateTime( value2, Qt::UTC )
+                       << "instead of" << QwtDate::toDateTime( expected, Qt::UTC );
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+int main( int, char*[] )
+{
+    const QList< QDateTime > dateTimes = wallClockTimes();
+
+    bool ok = true;
+
+    for ( int i = 0; i < COUNT( utcOffsets ); i++ )
+    {
+        for ( int j = 0; j < dateTimes.size(); j++ )
+        {
+            ok = testFloor( dateTimes[j], utcOffsets[i] ) && ok;
+            ok = testAddMonths( dateTimes[j], utcOffsets[i] ) && ok;
+        }
+    }
+
+    if ( !ok )
+        return 1;
+
+    qDebug() << "OK";
+    return 0;
+}
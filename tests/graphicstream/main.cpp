@@ -0,0 +1,263 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+/*
+    Writes QwtGraphic objects to a QDataStream and reads them back:
+
+    - a round trip has to restore a graphic, that paints the same pixels
+    - truncated or manipulated streams have to be rejected
+      with QDataStream::ReadCorruptData or ReadPastEnd, without
+      allocating memory according to the corrupted counts
+ */
+
+#include <QwtGraphic>
+#include <QwtPainterCommand>
+
+#include <QGuiApplication>
+#include <QBuffer>
+#include <QDataStream>
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <QDebug>
+
+// see qwt_graphic.cpp
+static const quint32 graphicMagic = 0x51777447;
+static const quint16 graphicFormatVersion = 1;
+
+static QwtGraphic createGraphic()
+{
+    QwtGraphic graphic;
+    graphic.setDefaultSize( QSizeF( 40, 30 ) );
+
+    QPainter painter( &graphic );
+    painter.setRenderHint( QPainter::Antialiasing, true );
+
+    painter.setPen( QPen( Qt::darkBlue, 2 ) );
+    painter.setBrush( Qt::yellow );
+    painter.drawEllipse( QRectF( 2, 2, 20, 15 ) );
+
+    QPainterPath path;
+    path.moveTo( 5, 25 );
+    path.cubicTo( 10, 5, 20, 40, 35, 20 );
+    path.lineTo( 38, 28 );
+
+    painter.setPen( QPen( Qt::red, 0 ) );
+    painter.setBrush( Qt::NoBrush );
+    painter.drawPath( path );
+
+    painter.end();
+
+    return graphic;
+}
+
+static QImage renderGraphic( const QwtGraphic& graphic )
+{
+    QImage image( 80, 60, QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::white );
+
+    QPainter painter( &image );
+    graphic.render( &painter, QRectF( 0, 0, 80, 60 ) );
+    painter.end();
+
+    return image;
+}
+
+static bool readGraphic( const QByteArray& data, QwtGraphic& graphic )
+{
+    QDataStream stream( data );
+    stream >> graphic;
+
+    return stream.status() == QDataStream::Ok;
+}
+
+static bool testRoundTrip()
+{
+    const QwtGraphic graphic = createGraphic();
+
+    QByteArray data;
+    {
+        QDataStream stream( &data, QIODevice::WriteOnly );
+        stream << graphic;
+    }
+
+    QwtGraphic restored;
+    if ( !readGraphic( data, restored ) )
+    {
+        qWarning() << "Round trip: reading failed";
+        return false;
+    }
+
+    bool ok = true;
+
+    if ( restored.commands().size() != graphic.commands().size() )
+    {
+        qWarning() << "Round trip: different number of commands"
+                   << graphic.commands().size() << restored.commands().size();
+        ok = false;
+    }
+
+    if ( restored.defaultSize() != graphic.defaultSize()
+        || restored.boundingRect() != graphic.boundingRect()
+        || restored.controlPointRect() != graphic.controlPointRect() )
+    {
+        qWarning() << "Round trip: different geometries";
+        ok = false;
+    }
+
+    if ( renderGraphic( restored ) != renderGraphic( graphic ) )
+    {
+        qWarning() << "Round trip: different pixels";
+        ok = false;
+    }
+
+    return ok;
+}
+
+static bool testTruncated()
+{
+    QByteArray data;
+    {
+        QDataStream stream( &data, QIODevice::WriteOnly );
+        stream << createGraphic();
+    }
+
+    bool ok = true;
+
+    for ( int i = 0; i < data.size(); i++ )
+    {
+        QwtGraphic graphic;
+        if ( readGraphic( data.left( i ), graphic ) || !graphic.isNull() )
+        {
+            qWarning() << "Truncated: accepted a stream of" << i
+                       << "from" << data.size() << "bytes";
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+/*
+    A stream with a valid header, followed by the counts
+    for the path infos and the commands.
+ */
+static void writeHeader( QDataStream& stream, qint32 streamVersion )
+{
+    stream << graphicMagic << graphicFormatVersion << streamVersion;
+
+    stream << QSizeF( 10, 10 );
+    stream << quint32( 0 ) << quint32( 0 ); // render hints, command types
+    stream << QRectF( 0, 0, 10, 10 ) << QRectF( 0, 0, 10, 10 );
+}
+
+static bool testCorrupted( const char* name, const QByteArray& data )
+{
+    QwtGraphic graphic;
+    if ( readGraphic( data, graphic ) || !graphic.isNull() )
+    {
+        qWarning() << "Corrupted:" << name << "has been accepted";
+        return false;
+    }
+
+    return true;
+}
+
+static bool testCorrupted()
+{
+    const qint32 version = QDataStream().version();
+
+    bool ok = true;
+
+    {
+        QByteArray data;
+        QDataStream stream( &data, QIODevice::WriteOnly );
+        writeHeader( stream, 9999 );
+        stream << quint32( 0 ) << quint32( 0 );
+
+        ok = testCorrupted( "stream version", data ) && ok;
+    }
+
+    {
+        QByteArray data;
+        QDataStream stream( &data, QIODevice::WriteOnly );
+        writeHeader( stream, version );
+        stream << quint32( 0x1fffffff ) << quint32( 0 );
+
+        ok = testCorrupted( "number of path infos", data ) && ok;
+    }
+
+    {
+        QByteArray data;
+        QDataStream stream( &data, QIODevice::WriteOnly );
+        writeHeader( stream, version );
+        stream << quint32( 0 ) << quint32( 0x1fffffff );
+
+        ok = testCorrupted( "number of commands", data ) && ok;
+    }
+
+    {
+        QByteArray data;
+        QDataStream stream( &data, QIODevice::WriteOnly );
+        writeHeader( stream, version );
+        stream << quint32( 0 ) << quint32( 1 );
+
+        stream << qint8( QwtPainterCommand::Path );
+        stream << quint8( Qt::OddEvenFill ) << quint32( 0x07ffffff );
+
+        ok = testCorrupted( "number of path elements", data ) && ok;
+    }
+
+    {
+        // a path starting with a LineTo element
+
+        QByteArray data;
+        QDataStream stream( &data, QIODevice::WriteOnly );
+        writeHeader( stream, version );
+        stream << quint32( 0 ) << quint32( 1 );
+
+        stream << qint8( QwtPainterCommand::Path );
+        stream << quint8( Qt::OddEvenFill ) << quint32( 2 );
+        stream << quint8( QPainterPath::LineToElement )
+               << quint8( QPainterPath::LineToElement );
+        stream << 0.0 << 0.0 << 10.0 << 10.0;
+
+        ok = testCorrupted( "element sequence", data ) && ok;
+    }
+
+    {
+        // a CurveTo element without its control points
+
+        QByteArray data;
+        QDataStream stream( &data, QIODevice::WriteOnly );
+        writeHeader( stream, version );
+        stream << quint32( 0 ) << quint32( 1 );
+
+        stream << qint8( QwtPainterCommand::Path );
+        stream << quint8( Qt::OddEvenFill ) << quint32( 2 );
+        stream << quint8( QPainterPath::MoveToElement )
+               << quint8( QPainterPath::CurveToElement );
+        stream << 0.0 << 0.0 << 10.0 << 10.0;
+
+        ok = testCorrupted( "incomplete curve", data ) && ok;
+    }
+
+    return ok;
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    bool ok = testRoundTrip();
+    ok = testTruncated() && ok;
+    ok = testCorrupted() && ok;
+
+    if ( !ok )
+        return 1;
+
+    qDebug() << "OK";
+    return 0;
+}
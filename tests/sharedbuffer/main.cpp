@@ -0,0 +1,178 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+/*
+    A local producer for QwtSharedRingBuffer, that can be used for testing
+    applications displaying the samples of an acquisition process:
+
+    sharedbuffer [-file] [-check] <key or file name> [channels] [rate]
+
+    - without -check, the program creates the buffer and appends records
+      ( index, channel 1, channel 2 ... ) with a sine wave for each channel
+      "rate" times per second
+
+    - with -check, the program attaches to the buffer as reader and
+      verifies, that the snapshots taken by QwtSharedPointData are consistent
+ */
+
+#include <QwtSharedRingBuffer>
+#include <QwtSharedPointData>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QThread>
+#include <QDebug>
+
+#include <cmath>
+
+static double channelValue( quint64 index, int channel )
+{
+    return std::sin( 0.01 * index * ( channel + 1 ) );
+}
+
+static int produce( QwtSharedRingBuffer& buffer, int numChannels, int rate )
+{
+    const int recordsPerTick = qMax( rate / 100, 1 );
+
+    QVector< double > values( recordsPerTick * buffer.recordSize() );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    quint64 index = 0;
+
+    while ( true )
+    {
+        double* v = values.data();
+        for ( int i = 0; i < recordsPerTick; i++ )
+        {
+            *v++ = double( index );
+
+            for ( int c = 0; c < numChannels; c++ )
+                *v++ = channelValue( index, c );
+
+            index++;
+        }
+
+        buffer.append( values.constData(), recordsPerTick );
+
+        if ( index % ( 100 * recordsPerTick ) == 0 )
+        {
+            qDebug() << "Records:" << index
+                     << "Rate:" << 1000.0 * index / qMax( timer.elapsed(), qint64( 1 ) );
+        }
+
+        const qint64 expected = 1000 * qint64( index ) / rate;
+        const qint64 delay = expected - timer.elapsed();
+        if ( delay > 0 )
+            QThread::msleep( static_cast< unsigned long >( delay ) );
+    }
+
+    return 0;
+}
+
+static int check( const QwtSharedRingBuffer& buffer )
+{
+    const int numChannels = buffer.recordSize() - 1;
+
+    QwtSharedPointData data( &buffer, 1, 0 );
+
+    quint64 numSnapshots = 0;
+    quint64 numErrors = 0;
+    quint64 numOverwritten = 0;
+
+    while ( true )
+    {
+        if ( !data.update() )
+        {
+            QThread::msleep( 10 );
+            continue;
+        }
+
+        numSnapshots++;
+
+        quint64 errors = 0;
+        for ( size_t i = 0; i < data.size(); i++ )
+        {
+            const quint64 index = data.firstIndex() + i;
+            const double* values = buffer.record( index );
+
+            if ( values[0] != double( index ) )
+                errors++;
+
+            for ( int c = 0; c < numChannels; c++ )
+            {
+                if ( values[c + 1] != channelValue( index, c ) )
+                    errors++;
+            }
+        }
+
+        if ( data.isOverwritten() )
+        {
+            // the producer has been too fast for us, the errors
+            // are expected
+
+            numOverwritten++;
+        }
+        else
+        {
+            numErrors += errors;
+        }
+
+        if ( numSnapshots % 100 == 0 )
+        {
+            qDebug() << "Snapshots:" << numSnapshots
+                     << "Size:" << data.size()
+                     << "Overwritten:" << numOverwritten
+                     << "Errors:" << numErrors;
+        }
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    QCoreApplication app( argc, argv );
+
+    QStringList args = app.arguments();
+    args.removeFirst();
+
+    const bool isFile = args.removeAll( "-file" ) > 0;
+    const bool isChecking = args.removeAll( "-check" ) > 0;
+
+    if ( args.isEmpty() )
+    {
+        qWarning() << "Usage: sharedbuffer [-file] [-check] <key> [channels] [rate]";
+        return 1;
+    }
+
+    const QString name = args[0];
+    const int numChannels = ( args.size() > 1 ) ? qMax( args[1].toInt(), 1 ) : 4;
+    const int rate = ( args.size() > 2 ) ? qMax( args[2].toInt(), 1 ) : 10000;
+
+    QwtSharedRingBuffer buffer;
+
+    bool ok;
+    if ( isChecking )
+    {
+        ok = isFile ? buffer.attachFile( name ) : buffer.attach( name );
+    }
+    else
+    {
+        const int recordSize = numChannels + 1;
+        const quint64 capacity = 10 * quint64( rate );
+
+        ok = isFile ? buffer.createFile( name, recordSize, capacity )
+            : buffer.create( name, recordSize, capacity );
+    }
+
+    if ( !ok )
+    {
+        qWarning() << name << ":" << buffer.errorString();
+        return 1;
+    }
+
+    return isChecking ? check( buffer ) : produce( buffer, numChannels, rate );
+}
@@ -9,93 +9,203 @@
 #include <QwtSplineParametrization>
 
 #include <QElapsedTimer>
+#include <QThread>
 
 #include <QPolygon>
 #include <QLine>
-#include <QDebug>
+#include <QVector>
+#include <QStringList>
+#include <QCoreApplication>
 
-static void testSpline( const char* name, QwtSplineInterpolating* spline,
-    int type, const QPolygonF& points )
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+
+/*
+   Usage: splineprof [ -n <points> ] [ -t <threads> ] [ -r <repetitions> ]
+
+   All splines are calculated for the same reproducible set of points
+   and each calculation is repeated. The minimum and the median of the
+   elapsed times are reported as throughput in million points per second.
+ */
+
+namespace
+{
+    class Options
+    {
+      public:
+        Options()
+            : numPoints( 1000000 )
+            , numThreads( 1 )
+            , repetitions( 5 )
+        {
+        }
+
+        int numPoints;
+        int numThreads;
+        int repetitions;
+    };
+
+    class Random
+    {
+      public:
+        Random( quint32 seed )
+            : m_state( seed )
+        {
+        }
+
+        double value()
+        {
+            // a linear congruential generator to get the same
+            // values on all platforms
+
+            m_state = m_state * 1664525u + 1013904223u;
+            return double( m_state >> 8 ) / double( 1 << 24 );
+        }
+
+      private:
+        quint32 m_state;
+    };
+}
+
+static QPolygonF benchmarkPoints( int numPoints )
 {
-    spline->setParametrization( type );
+    Random random( 4711 );
 
-    QElapsedTimer timer;
-    timer.start();
+    QPolygonF points;
+    points.reserve( numPoints );
 
-    const QVector< QLineF > lines = spline->bezierControlLines( points );
+    double x = 0.0;
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        x += 0.5 + random.value();
+        points += QPointF( x, std::sin( 0.01 * x ) + 0.1 * random.value() );
+    }
 
-    qDebug() << name << ":" << timer.elapsed();
+    return points;
 }
 
-static void testSplines( int paramType, const QPolygonF& points )
+static void benchmarkSpline( const char* splineName, const char* paramName,
+    QwtSplineInterpolating* spline, int paramType,
+    const QPolygonF& points, const Options& options )
 {
-#if 0
-    QwtSplinePleasing splinePleasing;
-    testSpline( "Pleasing", &splinePleasing, paramType, points );
-#endif
+    spline->setParametrization( paramType );
+    spline->setThreadCount( options.numThreads );
+
+    QVector< double > elapsed;
+
+    for ( int i = 0; i < options.repetitions; i++ )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        const QVector< QLineF > lines = spline->bezierControlLines( points );
+
+        elapsed += timer.nsecsElapsed() * 1e-9;
+
+        if ( lines.isEmpty() )
+            break;
+    }
+
+    std::sort( elapsed.begin(), elapsed.end() );
+
+    const double best = elapsed.first();
+    const double median = elapsed[elapsed.size() / 2];
 
-#if 1
+    const double mpts = points.size() * 1e-6;
+
+    std::printf( "%-20s %-12s %10.2f %10.2f %12.1f %12.1f\n",
+        splineName, paramName, 1e3 * best, 1e3 * median,
+        best > 0.0 ? mpts / best : 0.0, median > 0.0 ? mpts / median : 0.0 );
+
+    std::fflush( stdout );
+}
+
+static void benchmarkSplines( const char* paramName, int paramType,
+    const QPolygonF& points, const Options& options )
+{
     QwtSplineLocal splineCardinal( QwtSplineLocal::Cardinal );
-    testSpline( "Cardinal", &splineCardinal, paramType, points );
-#endif
+    benchmarkSpline( "Cardinal", paramName,
+        &splineCardinal, paramType, points, options );
 
-#if 1
     QwtSplineLocal splinePC( QwtSplineLocal::PChip );
-    testSpline( "PChip", &splinePC, paramType, points );
-#endif
+    benchmarkSpline( "PChip", paramName,
+        &splinePC, paramType, points, options );
 
-#if 1
     QwtSplineLocal splineAkima( QwtSplineLocal::Akima );
-    testSpline( "Akima", &splineAkima, paramType, points );
-#endif
+    benchmarkSpline( "Akima", paramName,
+        &splineAkima, paramType, points, options );
 
-#if 1
     QwtSplineLocal splinePB( QwtSplineLocal::ParabolicBlending );
-    testSpline( "Parabolic Blending", &splinePB, paramType, points );
-#endif
+    benchmarkSpline( "Parabolic Blending", paramName,
+        &splinePB, paramType, points, options );
 
-#if 1
     QwtSplineCubic splineC2;
-    testSpline( "Cubic", &splineC2, paramType, points );
-#endif
+    benchmarkSpline( "Cubic", paramName,
+        &splineC2, paramType, points, options );
+
+    QwtSplinePleasing splinePleasing;
+    benchmarkSpline( "Pleasing", paramName,
+        &splinePleasing, paramType, points, options );
 }
 
-int main( int, char*[] )
+static Options parseOptions( const QStringList& args )
 {
-    QPolygonF points;
+    Options options;
+
+    for ( int i = 1; i < args.size() - 1; i++ )
+    {
+        const int value = args[i + 1].toInt();
+
+        if ( args[i] == "-n" )
+            options.numPoints = qMax( value, 3 );
+        else if ( args[i] == "-t" )
+            options.numThreads = qMax( value, 0 );
+        else if ( args[i] == "-r" )
+            options.repetitions = qMax( value, 1 );
+        else
+            continue;
+
+        i++;
+    }
 
-    for ( int i = 0; i < 10e6; i++ )
-        points += QPointF( i, std::sin( i ) );
-
-#if 1
-    qDebug() << "=== X";
-    testSplines( QwtSplineParametrization::ParameterX, points );
-#endif
-
-#if 1
-    qDebug() << "=== Y";
-    testSplines( QwtSplineParametrization::ParameterY, points );
-#endif
-
-#if 1
-    qDebug() << "=== Uniform";
-    testSplines( QwtSplineParametrization::ParameterUniform, points );
-#endif
-
-#if 1
-    qDebug() << "=== Manhattan";
-    testSplines( QwtSplineParametrization::ParameterManhattan, points );
-#endif
-
-#if 1
-    qDebug() << "=== Chordal";
-    testSplines( QwtSplineParametrization::ParameterChordal, points );
-#endif
-
-#if 1
-    qDebug() << "=== Centripetral";
-    testSplines( QwtSplineParametrization::ParameterCentripetal, points );
-#endif
+    return options;
+}
+
+int main( int argc, char* argv[] )
+{
+    QCoreApplication app( argc, argv );
+
+    const Options options = parseOptions( app.arguments() );
+    const QPolygonF points = benchmarkPoints( options.numPoints );
+
+    std::printf( "points: %d, threads: %d ( ideal: %d ), repetitions: %d\n\n",
+        options.numPoints, options.numThreads,
+        QThread::idealThreadCount(), options.repetitions );
+
+    std::printf( "%-20s %-12s %10s %10s %12s %12s\n",
+        "Spline", "Param", "Best[ms]", "Median[ms]",
+        "Best[Mpt/s]", "Median[Mpt/s]" );
+
+    const struct
+    {
+        const char* name;
+        int type;
+    } parametrizations[] =
+    {
+        { "X", QwtSplineParametrization::ParameterX },
+        { "Y", QwtSplineParametrization::ParameterY },
+        { "Uniform", QwtSplineParametrization::ParameterUniform },
+        { "Manhattan", QwtSplineParametrization::ParameterManhattan },
+        { "Chordal", QwtSplineParametrization::ParameterChordal },
+        { "Centripetal", QwtSplineParametrization::ParameterCentripetal }
+    };
+
+    for ( size_t i = 0; i < sizeof( parametrizations ) / sizeof( parametrizations[0] ); i++ )
+    {
+        benchmarkSplines( parametrizations[i].name,
+            parametrizations[i].type, points, options );
+    }
 
     return 0;
 }
@@ -13,6 +13,8 @@
 #include <QPainterPath>
 #include <QDebug>
 
+#include <cmath>
+
 #define DEBUG_ERRORS 1
 
 static inline bool fuzzyCompare( double a, double b )
@@ -582,10 +584,183 @@ static void testDuplicates()
     testPaths( "Last point twice", spline, points, points4 );
 }
 
+/*
+    Splines with many points are calculated in concurrent threads. The
+    cubic spline solves overlapping chunks of its equation system, so its
+    result is an approximation of the serial one.
+
+    The results have to match the serial calculation with a relative
+    tolerance of threadTolerance.
+ */
+static const double threadTolerance = 1e-9;
+static const int threadTestPoints = 400000;
+static const uint threadTestThreads = 4;
+
+static QPolygonF threadTestPolygon()
+{
+    QPolygonF points;
+    points.reserve( threadTestPoints );
+
+    for ( int i = 0; i < threadTestPoints; i++ )
+    {
+        const double x = 0.5 * i + 0.25 * std::sin( 0.7 * i );
+        const double y = 100.0 * std::sin( 0.01 * i ) + 10.0 * std::cos( 0.37 * i );
+
+        points += QPointF( x, y );
+    }
+
+    return points;
+}
+
+static bool compareValues( const QString& name, const char* what,
+    const QVector< double >& values1, const QVector< double >& values2 )
+{
+    if ( values1.size() != values2.size() )
+    {
+        qDebug() << qPrintable( name ) << what << ": different sizes"
+                 << values1.size() << values2.size();
+        return false;
+    }
+
+    for ( int i = 0; i < values1.size(); i++ )
+    {
+        const double v1 = values1[i];
+        const double v2 = values2[i];
+
+        const double scale = qMax( 1.0, qMax( qAbs( v1 ), qAbs( v2 ) ) );
+        if ( qAbs( v1 - v2 ) > threadTolerance * scale )
+        {
+            qDebug() << qPrintable( name ) << what << ": differs at" << i
+                     << v1 << v2;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool compareLines( const QString& name,
+    const QVector< QLineF >& lines1, const QVector< QLineF >& lines2 )
+{
+    QVector< double > values1, values2;
+
+    for ( int i = 0; i < lines1.size(); i++ )
+    {
+        const QLineF& l = lines1[i];
+        values1 << l.x1() << l.y1() << l.x2() << l.y2();
+    }
+
+    for ( int i = 0; i < lines2.size(); i++ )
+    {
+        const QLineF& l = lines2[i];
+        values2 << l.x1() << l.y1() << l.x2() << l.y2();
+    }
+
+    return compareValues( name, "control lines", values1, values2 );
+}
+
+static void setThreadTestConditions( QwtSpline* spline, int condition )
+{
+    if ( condition < 0 )
+    {
+        spline->setBoundaryType( QwtSpline::PeriodicPolygon );
+        return;
+    }
+
+    spline->setBoundaryType( QwtSpline::ConditionalBoundaries );
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        const QwtSpline::BoundaryPosition pos =
+            static_cast< QwtSpline::BoundaryPosition >( i );
+
+        spline->setBoundaryCondition( pos, condition );
+        spline->setBoundaryValue( pos, ( i == 0 ) ? 0.5 : -2.0 );
+    }
+}
+
+static bool testThreads()
+{
+    const QPolygonF points = threadTestPolygon();
+
+    // -1: periodic
+    const int conditions[] = { -1, QwtSpline::Clamped1, QwtSpline::Clamped2 };
+    const int numConditions = sizeof( conditions ) / sizeof( conditions[0] );
+
+    bool ok = true;
+
+    for ( int c = 0; c < numConditions; c++ )
+    {
+        QString suffix;
+        switch( conditions[c] )
+        {
+            case QwtSpline::Clamped1:
+                suffix = " Clamped1";
+                break;
+            case QwtSpline::Clamped2:
+                suffix = " Clamped2";
+                break;
+            default:
+                suffix = " Periodic";
+        }
+
+        {
+            QwtSplineCubic spline;
+            setThreadTestConditions( &spline, conditions[c] );
+
+            spline.setThreadCount( 1 );
+            const QVector< double > m1 = spline.slopes( points );
+            const QVector< double > cv1 = spline.curvatures( points );
+
+            spline.setThreadCount( threadTestThreads );
+            const QVector< double > m2 = spline.slopes( points );
+            const QVector< double > cv2 = spline.curvatures( points );
+
+            const QString name = QString( "Cubic" ) + suffix;
+            ok = compareValues( name, "slopes", m1, m2 ) && ok;
+            ok = compareValues( name, "curvatures", cv1, cv2 ) && ok;
+        }
+
+        const QwtSplineLocal::Type types[] =
+        {
+            QwtSplineLocal::Cardinal,
+            QwtSplineLocal::ParabolicBlending,
+            QwtSplineLocal::Akima,
+            QwtSplineLocal::PChip
+        };
+
+        const char* typeNames[] =
+            { "Cardinal", "Parabolic Blending", "Akima", "PChip" };
+
+        for ( int t = 0; t < 4; t++ )
+        {
+            QwtSplineLocal spline( types[t] );
+            setThreadTestConditions( &spline, conditions[c] );
+
+            spline.setThreadCount( 1 );
+            const QVector< double > m1 = spline.slopes( points );
+            const QVector< QLineF > lines1 = spline.bezierControlLines( points );
+
+            spline.setThreadCount( threadTestThreads );
+            const QVector< double > m2 = spline.slopes( points );
+            const QVector< QLineF > lines2 = spline.bezierControlLines( points );
+
+            const QString name = QString( typeNames[t] ) + suffix;
+            ok = compareValues( name, "slopes", m1, m2 ) && ok;
+            ok = compareLines( name, lines1, lines2 ) && ok;
+        }
+    }
+
+    return ok;
+}
+
 int main( int, char*[] )
 {
     testSplines();
     testDuplicates();
 
+    if ( !testThreads() )
+        return 1;
+
     return 0;
 }
@@ -13,4 +13,20 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     splinetest \
-    splineprof
+    splineprof \
+    graphicstream
+
+greaterThan(QT_MAJOR_VERSION, 4) {
+
+    # QDateTime with Qt::OffsetFromUTC and negative Julian days
+    SUBDIRS += datetest
+}
+
+contains(QWT_CONFIG, QwtPlot) {
+
+    greaterThan(QT_MAJOR_VERSION, 4) {
+
+        SUBDIRS += sharedbuffer
+        SUBDIRS += virtuallegend
+    }
+}
@@ -0,0 +1,256 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+/*
+    Tests for QwtVirtualLegend:
+
+    - the entries of the remaining items have to be found, after
+      removing many items - with and without recalculating the
+      layout in between
+    - a pressed entry has to be released, when the indexes of the
+      entries change or the mouse leaves the legend
+ */
+
+#include <QwtVirtualLegend>
+#include <QwtLegendData>
+#include <QwtPlotCurve>
+#include <QwtText>
+
+#include <QApplication>
+#include <QMouseEvent>
+#include <QImage>
+#include <QDebug>
+
+static QVariant itemInfo( QwtPlotItem* item )
+{
+    return QVariant::fromValue( item );
+}
+
+static QList< QwtLegendData > legendData(
+    const QString& title, QwtLegendData::Mode mode )
+{
+    QwtLegendData data;
+    data.setValue( QwtLegendData::TitleRole, QVariant::fromValue( QwtText( title ) ) );
+    data.setValue( QwtLegendData::ModeRole, mode );
+
+    return QList< QwtLegendData >() << data;
+}
+
+static bool testRemove()
+{
+    const int numItems = 2000;
+
+    QList< QwtPlotCurve* > curves;
+    for ( int i = 0; i < numItems; i++ )
+        curves += new QwtPlotCurve();
+
+    QwtVirtualLegend legend;
+
+    for ( int i = 0; i < numItems; i++ )
+    {
+        legend.updateLegend( itemInfo( curves[i] ),
+            legendData( QString::number( i ), QwtLegendData::Checkable ) );
+
+        legend.setChecked( itemInfo( curves[i] ), i % 3 == 0 );
+    }
+
+    // removing without recalculating the layout in between
+
+    for ( int i = 0; i < numItems; i += 4 )
+        legend.updateLegend( itemInfo( curves[i] ), QList< QwtLegendData >() );
+
+    QApplication::processEvents();
+
+    for ( int i = 2; i < numItems; i += 4 )
+        legend.updateLegend( itemInfo( curves[i] ), QList< QwtLegendData >() );
+
+    bool ok = true;
+
+    // updating the remaining items must not append entries
+
+    for ( int i = 1; i < numItems; i += 2 )
+    {
+        legend.updateLegend( itemInfo( curves[i] ),
+            legendData( QString( "Item %1" ).arg( i ), QwtLegendData::Checkable ) );
+    }
+
+    if ( legend.entryCount() != numItems / 2 )
+    {
+        qWarning() << "Remove: wrong number of entries" << legend.entryCount();
+        ok = false;
+    }
+
+    for ( int i = 1; i < numItems; i += 2 )
+    {
+        if ( legend.isChecked( itemInfo( curves[i] ) ) != ( i % 3 == 0 ) )
+        {
+            qWarning() << "Remove: wrong state of item" << i;
+            ok = false;
+            break;
+        }
+    }
+
+    for ( int i = 1; i < numItems; i += 2 )
+        legend.updateLegend( itemInfo( curves[i] ), QList< QwtLegendData >() );
+
+    QApplication::processEvents();
+
+    if ( !legend.isEmpty() || legend.entryCount() != 0 )
+    {
+        qWarning() << "Remove: legend is not empty";
+        ok = false;
+    }
+
+    qDeleteAll( curves );
+
+    return ok;
+}
+
+static QWidget* viewport( const QwtVirtualLegend& legend )
+{
+    return legend.findChild< QWidget* >( "QwtLegendViewport" );
+}
+
+// a position inside the entry of an item in viewport coordinates
+static QPoint entryPos( const QwtVirtualLegend& legend, QwtPlotItem* item )
+{
+    for ( int y = 0; y < legend.height(); y++ )
+    {
+        for ( int x = 0; x < legend.width(); x++ )
+        {
+            const QPoint pos( x, y );
+
+            const QVariant info = legend.itemInfoAt( pos );
+            if ( info.isValid() && qvariant_cast< QwtPlotItem* >( info ) == item )
+                return viewport( legend )->mapFrom( &legend, pos );
+        }
+    }
+
+    return QPoint( -1, -1 );
+}
+
+static void sendMouseEvent( QWidget* widget, QEvent::Type type, const QPoint& pos )
+{
+    const Qt::MouseButtons buttons = ( type == QEvent::MouseButtonPress )
+        ? Qt::LeftButton : Qt::NoButton;
+
+    QMouseEvent event( type, pos, Qt::LeftButton, buttons, Qt::NoModifier );
+    QApplication::sendEvent( widget, &event );
+}
+
+static void initLegend( QwtVirtualLegend& legend,
+    const QList< QwtPlotCurve* >& curves )
+{
+    for ( int i = 0; i < curves.size(); i++ )
+    {
+        legend.updateLegend( itemInfo( curves[i] ),
+            legendData( curves[i]->title().text(), QwtLegendData::Clickable ) );
+    }
+
+    // without focus, so that no focus rectangle is painted
+    legend.setAttribute( Qt::WA_ShowWithoutActivating );
+
+    legend.resize( 400, 300 );
+    legend.show();
+
+    QApplication::processEvents();
+}
+
+static QImage grabViewport( const QwtVirtualLegend& legend )
+{
+    QApplication::processEvents();
+    return viewport( legend )->grab().toImage();
+}
+
+static bool testPressed()
+{
+    QList< QwtPlotCurve* > curves;
+    for ( int i = 0; i < 3; i++ )
+        curves += new QwtPlotCurve( QString( "Item %1" ).arg( i ) );
+
+    // the expected result: items 1 and 2 without any pressed entry
+
+    QwtVirtualLegend reference;
+    initLegend( reference, curves.mid( 1 ) );
+
+    const QImage referenceImage = grabViewport( reference );
+
+    bool ok = true;
+    int numClicks = 0;
+
+    {
+        // removing an item, while an entry behind it is pressed
+
+        QwtVirtualLegend legend;
+        initLegend( legend, curves );
+
+        QObject::connect( &legend, &QwtVirtualLegend::clicked,
+            [&numClicks]() { numClicks++; } );
+
+        sendMouseEvent( viewport( legend ),
+            QEvent::MouseButtonPress, entryPos( legend, curves[1] ) );
+
+        legend.updateLegend( itemInfo( curves[0] ), QList< QwtLegendData >() );
+        QApplication::processEvents();
+
+        sendMouseEvent( viewport( legend ),
+            QEvent::MouseButtonRelease, entryPos( legend, curves[1] ) );
+
+        if ( grabViewport( legend ) != referenceImage )
+        {
+            qWarning() << "Pressed: entry is still down after removing an item";
+            ok = false;
+        }
+    }
+
+    {
+        // the mouse leaves the legend, while an entry is pressed
+
+        QwtVirtualLegend legend;
+        initLegend( legend, curves.mid( 1 ) );
+
+        QObject::connect( &legend, &QwtVirtualLegend::clicked,
+            [&numClicks]() { numClicks++; } );
+
+        const QPoint pos = entryPos( legend, curves[1] );
+
+        sendMouseEvent( viewport( legend ), QEvent::MouseButtonPress, pos );
+
+        QEvent leaveEvent( QEvent::Leave );
+        QApplication::sendEvent( viewport( legend ), &leaveEvent );
+
+        if ( grabViewport( legend ) != referenceImage )
+        {
+            qWarning() << "Pressed: entry is still down after leaving the legend";
+            ok = false;
+        }
+
+        sendMouseEvent( viewport( legend ), QEvent::MouseButtonRelease, pos );
+    }
+
+    if ( numClicks != 0 )
+    {
+        qWarning() << "Pressed: clicked has been emitted for a released entry";
+        ok = false;
+    }
+
+    qDeleteAll( curves );
+
+    return ok;
+}
+
+int main( int argc, char* argv[] )
+{
+    QApplication app( argc, argv );
+
+    bool ok = testRemove();
+    ok = testPressed() && ok;
+
+    if ( !ok )
+        return 1;
+
+    qDebug() << "OK";
+    return 0;
+}